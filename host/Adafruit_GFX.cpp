@@ -0,0 +1,70 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Adafruit_GFX.cpp
+//
+// Description:
+//
+// generic drawing of the host Adafruit_GFX, see Adafruit_GFX.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "Adafruit_GFX.h"
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    for (int16_t i = 0; i < h; i++)
+    {
+        drawPixel(x, y + i, color);
+    }
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    for (int16_t i = 0; i < w; i++)
+    {
+        drawPixel(x + i, y, color);
+    }
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for (int16_t i = x; i < x + w; i++)
+    {
+        drawFastVLine(i, y, h, color);
+    }
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+{
+    int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+    uint8_t b = 0;
+
+    for (int16_t j = 0; j < h; j++, y++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (i & 7)
+            {
+                b <<= 1;
+            }
+            else
+            {
+                b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+            }
+            if (b & 0x80)
+            {
+                drawPixel(x + i, y, color);
+            }
+        }
+    }
+}
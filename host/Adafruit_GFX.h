@@ -0,0 +1,48 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Adafruit_GFX.h
+//
+// Description:
+//
+// host stand-in for the parts of Adafruit_GFX the sketch uses. The
+// drawing functions follow the library code so a frame drawn on the
+// host sets exactly the pixels it sets on the device.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ADAFRUIT_GFX_H
+#define ADAFRUIT_GFX_H
+
+#include "Arduino.h"
+
+class Adafruit_GFX
+{
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+
+    // unset bits are transparent, rows are padded to whole bytes
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+protected:
+    const int16_t WIDTH;
+    const int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+};
+
+#endif // ADAFRUIT_GFX_H
@@ -0,0 +1,236 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Adafruit_SSD1306.cpp
+//
+// Description:
+//
+// SSD1306 buffer and I2C traffic of the host build, see Adafruit_SSD1306.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <new>
+
+#include "Adafruit_SSD1306.h"
+
+// the library caps a transmission at the Wire buffer, control byte included
+static const uint16_t ssd1306WireMax = I2C_BUFFER_LENGTH < 256 ? I2C_BUFFER_LENGTH : 256;
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rst_pin, uint32_t clkDuring,
+                                   uint32_t clkAfter)
+    : Adafruit_GFX(w, h), wire(twi ? twi : &Wire), wireClk(clkDuring), restoreClk(clkAfter)
+{
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306()
+{
+    delete[] buffer;
+}
+
+void Adafruit_SSD1306::command1(uint8_t c)
+{
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x00);
+    wire->write(c);
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::commandList(const uint8_t *c, uint8_t n)
+{
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x00);
+    uint16_t bytesOut = 1;
+    while (n--)
+    {
+        if (bytesOut >= ssd1306WireMax)
+        {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x00);
+            bytesOut = 1;
+        }
+        wire->write(*c++);
+        bytesOut++;
+    }
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c)
+{
+    wire->setClock(wireClk);
+    command1(c);
+    wire->setClock(restoreClk);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin)
+{
+    if (!buffer)
+    {
+        buffer = new (std::nothrow) uint8_t[WIDTH * ((HEIGHT + 7) / 8)];
+        if (!buffer)
+        {
+            return false;
+        }
+    }
+    clearDisplay();
+
+    vccstate = vcs;
+    i2caddr = addr ? addr : ((HEIGHT == 32) ? 0x3C : 0x3D);
+    if (periphBegin)
+    {
+        wire->begin();
+    }
+
+    wire->setClock(wireClk);
+    static const uint8_t init1[] = {SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX};
+    commandList(init1, sizeof(init1));
+    command1(HEIGHT - 1);
+
+    static const uint8_t init2[] = {SSD1306_SETDISPLAYOFFSET, 0x0, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP};
+    commandList(init2, sizeof(init2));
+    command1((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14);
+
+    static const uint8_t init3[] = {SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1, SSD1306_COMSCANDEC};
+    commandList(init3, sizeof(init3));
+
+    command1(SSD1306_SETCOMPINS);
+    command1(HEIGHT == 64 ? 0x12 : 0x02);
+    command1(SSD1306_SETCONTRAST);
+    command1((vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF);
+
+    command1(SSD1306_SETPRECHARGE);
+    command1((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1);
+    static const uint8_t init5[] = {SSD1306_SETVCOMDETECT, 0x40, SSD1306_DISPLAYALLON_RESUME,
+                                    SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON};
+    commandList(init5, sizeof(init5));
+    wire->setClock(restoreClk);
+    return true;
+}
+
+void Adafruit_SSD1306::display()
+{
+    wire->setClock(wireClk);
+    static const uint8_t dlist1[] = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0};
+    commandList(dlist1, sizeof(dlist1));
+    command1(WIDTH - 1);
+
+    uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+    const uint8_t *ptr = buffer;
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x40);
+    uint16_t bytesOut = 1;
+    while (count--)
+    {
+        if (bytesOut >= ssd1306WireMax)
+        {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x40);
+            bytesOut = 1;
+        }
+        wire->write(*ptr++);
+        bytesOut++;
+    }
+    wire->endTransmission();
+    wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::clearDisplay()
+{
+    if (buffer)
+    {
+        memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+    }
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i)
+{
+    ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool dim)
+{
+    ssd1306_command(SSD1306_SETCONTRAST);
+    ssd1306_command(dim ? 0 : (vccstate == SSD1306_EXTERNALVCC ? 0x9F : 0xCF));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (!buffer || x < 0 || x >= width() || y < 0 || y >= height())
+    {
+        return;
+    }
+    uint8_t &b = buffer[x + (y / 8) * WIDTH];
+    switch (color)
+    {
+    case SSD1306_WHITE:
+        b |= (1 << (y & 7));
+        break;
+    case SSD1306_BLACK:
+        b &= ~(1 << (y & 7));
+        break;
+    case SSD1306_INVERSE:
+        b ^= (1 << (y & 7));
+        break;
+    }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (y < 0 || y >= height())
+    {
+        return;
+    }
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (x + w > width())
+    {
+        w = width() - x;
+    }
+    for (int16_t i = 0; i < w; i++)
+    {
+        drawPixel(x + i, y, color);
+    }
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (x < 0 || x >= width())
+    {
+        return;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if (y + h > height())
+    {
+        h = height() - y;
+    }
+    for (int16_t i = 0; i < h; i++)
+    {
+        drawPixel(x, y + i, color);
+    }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y)
+{
+    if (!buffer || x < 0 || x >= width() || y < 0 || y >= height())
+    {
+        return false;
+    }
+    return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
+
+uint8_t *Adafruit_SSD1306::getBuffer()
+{
+    return buffer;
+}
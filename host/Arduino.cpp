@@ -0,0 +1,332 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Arduino.cpp
+//
+// Description:
+//
+// timing, pins and Serial of the host Arduino core, see Arduino.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <stdarg.h>
+
+#include <chrono>
+#include <string>
+
+#include "Arduino.h"
+#include "esp_timer.h"
+
+HardwareSerial Serial;
+
+static FILE *serialOut = stdout;
+static uint32_t serialBaud = 0;
+static double uartIdleAt = 0; // host clock at which the UART has sent what it was given
+static const uint8_t uartFifoBytes = 128;
+static std::string serialIn;
+static double delayedMicros = 0;
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+static bool clockSimulated = false;
+static double simulatedFrom = 0; // clock at which it stopped following the host, a whole microsecond
+
+static double hostElapsedMicros()
+{
+    auto elapsed = std::chrono::steady_clock::now() - bootTime;
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+double hostClockMicros()
+{
+    return (clockSimulated ? simulatedFrom : hostElapsedMicros()) + delayedMicros;
+}
+
+void hostClockSimulated(bool on)
+{
+    if (on == clockSimulated)
+    {
+        return;
+    }
+    double now = hostElapsedMicros();
+    if (on)
+    {
+        // from the next whole microsecond: waits of whole microseconds then add up exactly
+        simulatedFrom = ceil(now + delayedMicros);
+        delayedMicros = 0;
+    }
+    else
+    {
+        // picks up from where the simulated clock is, never backwards
+        delayedMicros += simulatedFrom - now;
+    }
+    clockSimulated = on;
+}
+
+unsigned long micros()
+{
+    return (unsigned long)hostClockMicros();
+}
+
+unsigned long millis()
+{
+    return micros() / 1000;
+}
+
+void delay(uint32_t ms)
+{
+    delayedMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    delayedMicros += us;
+}
+
+void hostClockAdvance(double us)
+{
+    delayedMicros += us;
+}
+
+static uint8_t pinLevels[40];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (pin < sizeof(pinLevels))
+    {
+        pinLevels[pin] = val;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+void hostSerialOutput(FILE *out)
+{
+    serialOut = out;
+}
+
+void hostSerialInput(const char *text)
+{
+    serialIn += text;
+}
+
+void hostSerialBaud(uint32_t baud)
+{
+    serialBaud = baud;
+    uartIdleAt = 0;
+}
+
+// the writer waits for what does not fit the FIFO
+static void uartCharge(size_t bytes)
+{
+    if (!serialBaud)
+    {
+        return;
+    }
+    double byteMicros = 10e6 / serialBaud; // start, 8 data and stop bit
+    double now = hostClockMicros();
+    uartIdleAt = (uartIdleAt > now ? uartIdleAt : now) + bytes * byteMicros;
+    double wait = uartIdleAt - now - uartFifoBytes * byteMicros;
+    if (wait > 0)
+    {
+        hostClockAdvance(wait);
+    }
+}
+
+int HardwareSerial::available()
+{
+    return serialIn.size();
+}
+
+int HardwareSerial::peek()
+{
+    return serialIn.empty() ? -1 : (uint8_t)serialIn[0];
+}
+
+int HardwareSerial::read()
+{
+    int c = peek();
+    if (c >= 0)
+    {
+        serialIn.erase(0, 1);
+    }
+    return c;
+}
+
+// loopTask of the ESP32 core, its stack starts about where main() runs
+static const UBaseType_t loopTaskStack = 8192;
+static const uint8_t *stackTop = (const uint8_t *)__builtin_frame_address(0);
+static size_t stackDeepest = 0;
+static int loopTask;
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return &loopTask;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    uint8_t here;
+    size_t depth = stackTop > &here ? stackTop - &here : 0;
+    stackDeepest = depth > stackDeepest ? depth : stackDeepest;
+    return stackDeepest < loopTaskStack ? loopTaskStack - stackDeepest : 0;
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+    return "loopTask";
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t stackBytes, void *parameters,
+                                   UBaseType_t priority, TaskHandle_t *created, BaseType_t core)
+{
+    return pdFAIL;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks);
+}
+
+// notifications given to loopTask, the only task
+static uint32_t notifications = 0;
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks)
+{
+    // the only other notifiers are the esp_timer callbacks, run on the host clock while waiting
+    while (notifications == 0 && ticks > 0 && hostTimerRun())
+    {
+    }
+    uint32_t count = notifications;
+    notifications = clearOnExit ? 0 : (count ? count - 1 : 0);
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    notifications++;
+    return pdPASS;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t nanos = (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+    return (uint32_t)(nanos * getCpuFreqMHz() / 1000);
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    uartCharge(1);
+    return serialOut ? fwrite(&c, 1, 1, serialOut) : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    uartCharge(size);
+    return serialOut ? fwrite(buffer, 1, size, serialOut) : size;
+}
+
+size_t HardwareSerial::printf(const char *format, ...)
+{
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (len < 0)
+    {
+        return 0;
+    }
+    return write((const uint8_t *)text, (size_t)len < sizeof(text) ? len : sizeof(text) - 1);
+}
+
+size_t HardwareSerial::print(const char *s)
+{
+    return write((const uint8_t *)s, strlen(s));
+}
+
+size_t HardwareSerial::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(int n, int base)
+{
+    return print((long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned int n, int base)
+{
+    return print((unsigned long)n, base);
+}
+
+size_t HardwareSerial::print(long n, int base)
+{
+    return base == HEX ? printf("%lX", n) : printf("%ld", n);
+}
+
+size_t HardwareSerial::print(unsigned long n, int base)
+{
+    return base == HEX ? printf("%lX", n) : printf("%lu", n);
+}
+
+size_t HardwareSerial::print(double n, int digits)
+{
+    return printf("%.*f", digits, n);
+}
+
+size_t HardwareSerial::println()
+{
+    return print("\r\n");
+}
+
+size_t HardwareSerial::println(const char *s)
+{
+    return print(s) + println();
+}
+
+size_t HardwareSerial::println(char c)
+{
+    return print(c) + println();
+}
+
+size_t HardwareSerial::println(int n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(unsigned int n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(long n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(unsigned long n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t HardwareSerial::println(double n, int digits)
+{
+    return print(n, digits) + println();
+}
@@ -0,0 +1,201 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Arduino.h
+//
+// Description:
+//
+// host stand-in for the ESP32 Arduino core, just what the animation
+// code uses: integer types, timing, pins, Serial and the ESP heap
+// queries. millis()/micros() follow the host clock, delay() only
+// moves a virtual offset forward so nothing sleeps on the host.
+//
+// Serial prints to stdout, hostSerialOutput() redirects or mutes it,
+// hostSerialInput() queues what the sketch reads from it. The cycle
+// counter runs at getCpuFreqMHz() on the host monotonic clock.
+// The heap figures come from the counting allocator of hostHeap.h.
+//
+// String keeps what the heap sees of the ESP32 core's: texts of up to
+// 10 characters stay inside the object (its 11 byte SSO buffer), longer
+// ones take a block of (length + 16) & ~15 bytes, allocated here with
+// new so the counting allocator sees it.
+//
+// hostSerialBaud() makes Serial cost the time of a UART at that rate:
+// writes are free while they fit the 128 byte FIFO, then the writer
+// waits on the host clock like Serial.write() blocks on the ESP32.
+//
+// The FreeRTOS task calls know one task, the host main thread playing
+// loopTask with its 8 KB stack. Its watermark is the deepest stack
+// seen at the calls to uxTaskGetStackHighWaterMark(), not a painted
+// stack like on the ESP32, so it only covers the sampled points.
+// xTaskCreatePinnedToCore() fails, vTaskDelay() is a delay() in ticks
+// of 1 ms. xTaskNotifyGive() counts the notifications of loopTask;
+// with none pending ulTaskNotifyTake() runs the timers of esp_timer.h
+// on the host clock until one notifies it, and returns 0 at once when
+// no timer runs (the wait time given is not kept).
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define LED_BUILTIN 2
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+
+static const uint8_t SS = 5;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+// host only: moves micros() forward, for the time spent waiting on a bus
+void hostClockAdvance(double us);
+// host only: micros() with the fraction kept, for the session trace
+double hostClockMicros();
+// host only: with on, the clock stops following the host and only moves by the simulated waits
+// (delays, bus and card time, timers), so tests asserting on durations do not depend on the load;
+// it starts on a whole microsecond, whole microsecond waits compare exactly
+void hostClockSimulated(bool on);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud);
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    size_t printf(const char *format, ...);
+
+    int available();
+    int peek();
+    int read();
+
+    size_t print(const char *s);
+    size_t print(char c);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    size_t println(const char *s);
+    size_t println(char c);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// nullptr drops everything printed to Serial
+void hostSerialOutput(FILE *out);
+// bytes the sketch receives on Serial, after what is still queued
+void hostSerialInput(const char *text);
+// UART rate Serial writes are timed at, 0 (the default) costs nothing
+void hostSerialBaud(uint32_t baud);
+
+class String
+{
+public:
+    static const size_t ssoBytes = 11; // terminating zero included
+
+    String(const char *text = "") { assign(text, strlen(text)); }
+    String(const String &other) { assign(other.c_str(), other.len); }
+    ~String() { delete[] heap; }
+    String &operator=(const String &other)
+    {
+        if (this != &other)
+        {
+            delete[] heap;
+            assign(other.c_str(), other.len);
+        }
+        return *this;
+    }
+
+    const char *c_str() const { return heap ? heap : sso; }
+    size_t length() const { return len; }
+
+private:
+    void assign(const char *text, size_t length)
+    {
+        len = length;
+        heap = length < ssoBytes ? nullptr : new char[(length + 16) & ~(size_t)15];
+        memcpy((char *)c_str(), text, length + 1);
+    }
+
+    char *heap = nullptr;
+    size_t len = 0;
+    char sso[ssoBytes];
+};
+
+class EspClass
+{
+public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint8_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+typedef void *TaskHandle_t;
+typedef unsigned int UBaseType_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdPASS 1
+#define pdFAIL 0
+#define pdTRUE 1
+#define pdFALSE 0
+#define tskIDLE_PRIORITY 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+// bytes of stack never used by the task (the ESP32 port counts in bytes)
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+const char *pcTaskGetName(TaskHandle_t task);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name, uint32_t stackBytes, void *parameters,
+                                   UBaseType_t priority, TaskHandle_t *created, BaseType_t core);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+#endif // ARDUINO_H
@@ -0,0 +1,348 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: FS.cpp
+//
+// Description:
+//
+// fs::FS and fs::File on top of stdio and std::filesystem, see FS.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include "FS.h"
+#include "traceRecorder.h"
+
+namespace fs
+{
+
+struct FileImpl
+{
+    FS *owner;
+    std::string path; // path on the card, with a leading slash
+    std::string hostPath;
+    FILE *fp;
+    bool directory;
+    std::vector<std::string> entries; // directories: names left to hand out
+    size_t nextEntry;
+
+    ~FileImpl()
+    {
+        if (fp)
+        {
+            fclose(fp);
+        }
+    }
+};
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    if (!impl || !impl->fp)
+    {
+        return 0;
+    }
+    size_t n = fwrite(buf, 1, size, impl->fp);
+    impl->owner->stats.writes++;
+    impl->owner->stats.bytesWritten += n;
+    return n;
+}
+
+int File::available()
+{
+    return impl && impl->fp ? (int)(size() - position()) : 0;
+}
+
+int File::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+    if (!impl || !impl->fp)
+    {
+        return 0;
+    }
+    size_t pos = ftell(impl->fp);
+    size_t n = fread(buf, 1, size, impl->fp);
+    impl->owner->chargeRead(impl->path, pos, n);
+    if (impl->owner->readErrors())
+    {
+        // the transfer happened, its CRC did not match
+        fseek(impl->fp, pos, SEEK_SET);
+        n = 0;
+    }
+    impl->owner->stats.reads++;
+    impl->owner->stats.bytesRead += n;
+    return n;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    if (!impl || !impl->fp)
+    {
+        return false;
+    }
+    impl->owner->stats.seeks++;
+    int whence = mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END);
+    return fseek(impl->fp, pos, whence) == 0;
+}
+
+size_t File::position() const
+{
+    return impl && impl->fp ? (size_t)ftell(impl->fp) : 0;
+}
+
+size_t File::size() const
+{
+    if (!impl || !impl->fp)
+    {
+        return 0;
+    }
+    fflush(impl->fp);
+    struct stat st;
+    return fstat(fileno(impl->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::flush()
+{
+    if (impl && impl->fp)
+    {
+        fflush(impl->fp);
+    }
+}
+
+void File::close()
+{
+    if (impl && impl->fp)
+    {
+        fclose(impl->fp);
+        impl->fp = nullptr;
+    }
+    impl.reset();
+}
+
+time_t File::getLastWrite()
+{
+    struct stat st;
+    return impl && stat(impl->hostPath.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+const char *File::path() const
+{
+    return impl ? impl->path.c_str() : nullptr;
+}
+
+const char *File::name() const
+{
+    if (!impl)
+    {
+        return nullptr;
+    }
+    size_t slash = impl->path.find_last_of('/');
+    return impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const
+{
+    return impl && impl->directory;
+}
+
+File File::openNextFile(const char *mode)
+{
+    if (!impl || !impl->directory || impl->nextEntry >= impl->entries.size())
+    {
+        return File();
+    }
+    std::string child = impl->path == "/" ? "/" : impl->path + "/";
+    child += impl->entries[impl->nextEntry++];
+    return impl->owner->open(child.c_str(), mode);
+}
+
+void File::rewindDirectory()
+{
+    if (impl)
+    {
+        impl->nextEntry = 0;
+    }
+}
+
+File::operator bool() const
+{
+    return impl && (impl->fp || impl->directory);
+}
+
+void FS::setRoot(const char *root)
+{
+    rootDir = root ? root : "";
+    while (rootDir.size() > 1 && rootDir.back() == '/')
+    {
+        rootDir.pop_back();
+    }
+}
+
+std::string FS::hostPath(const char *path) const
+{
+    std::string p = path ? path : "";
+    return rootDir + (p.empty() || p[0] != '/' ? "/" : "") + p;
+}
+
+File FS::open(const char *path, const char *mode, const bool create)
+{
+    if (rootDir.empty() || !path)
+    {
+        return File();
+    }
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->owner = this;
+    impl->path = path[0] == '/' ? path : std::string("/") + path;
+    impl->hostPath = hostPath(path);
+    impl->fp = nullptr;
+    impl->directory = false;
+    impl->nextEntry = 0;
+
+    std::error_code ec;
+    if (std::filesystem::is_directory(impl->hostPath, ec))
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(impl->hostPath, ec))
+        {
+            impl->entries.push_back(entry.path().filename().string());
+        }
+        std::sort(impl->entries.begin(), impl->entries.end());
+        impl->directory = true;
+        stats.opens++;
+        chargeOpen(impl->path);
+        return File(impl);
+    }
+
+    const char *hostMode = strcmp(mode, FILE_WRITE) == 0 ? "wb" : (strcmp(mode, FILE_APPEND) == 0 ? "ab" : "rb");
+    impl->fp = fopen(impl->hostPath.c_str(), hostMode);
+    if (!impl->fp)
+    {
+        return File();
+    }
+    stats.opens++;
+    chargeOpen(impl->path);
+    return File(impl);
+}
+
+void FS::dropCache()
+{
+    lookedUp.clear();
+    cached.clear();
+}
+
+void FS::charge(double micros, const char *what, const std::string &path, size_t len)
+{
+    stats.busMicros += micros;
+    if (traceActive())
+    {
+        std::string args = "{\"path\":\"" + path + "\",\"bytes\":" + std::to_string(len) + "}";
+        traceSpan(TRACE_SD, what, hostClockMicros(), micros, args.c_str());
+    }
+    hostClockAdvance(micros);
+}
+
+double FS::sectorMicros() const
+{
+    return sectorBytes * 8e6 / ((double)timing.clock * (timing.dataLines ? timing.dataLines : 1));
+}
+
+void FS::chargeOpen(const std::string &path)
+{
+    if (!timing.clock)
+    {
+        return;
+    }
+    double micros = timing.openMicros;
+    if (lookedUp.insert(path).second)
+    {
+        micros += timing.commandMicros + sectorMicros();
+    }
+    charge(micros, "open", path, 0);
+}
+
+void FS::chargeRead(const std::string &path, size_t pos, size_t len)
+{
+    if (!timing.clock || len == 0)
+    {
+        return;
+    }
+    uint64_t id = fileIds.emplace(path, (uint32_t)fileIds.size()).first->second;
+
+    double micros = timing.callMicros;
+    bool inRun = false;
+    for (size_t sector = pos / sectorBytes; sector <= (pos + len - 1) / sectorBytes; sector++)
+    {
+        uint64_t key = id << 32 | sector;
+        auto hit = std::find(cached.begin(), cached.end(), key);
+        if (hit != cached.end())
+        {
+            cached.erase(hit);
+            inRun = false;
+        }
+        else
+        {
+            // consecutive sectors missing from the cache come with one command
+            micros += (inRun ? 0 : timing.commandMicros) + sectorMicros();
+            inRun = true;
+        }
+        cached.push_back(key);
+        if (cached.size() > timing.cacheSectors)
+        {
+            cached.erase(cached.begin());
+        }
+    }
+    charge(micros, "read", path, len);
+}
+
+bool FS::exists(const char *path)
+{
+    std::error_code ec;
+    return !rootDir.empty() && std::filesystem::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char *path)
+{
+    std::error_code ec;
+    return !rootDir.empty() && std::filesystem::is_regular_file(hostPath(path), ec) &&
+           std::filesystem::remove(hostPath(path), ec);
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo)
+{
+    std::error_code ec;
+    std::filesystem::rename(hostPath(pathFrom), hostPath(pathTo), ec);
+    return !rootDir.empty() && !ec;
+}
+
+bool FS::mkdir(const char *path)
+{
+    std::error_code ec;
+    return !rootDir.empty() && std::filesystem::create_directory(hostPath(path), ec);
+}
+
+bool FS::rmdir(const char *path)
+{
+    std::error_code ec;
+    return !rootDir.empty() && std::filesystem::is_directory(hostPath(path), ec) &&
+           std::filesystem::remove(hostPath(path), ec);
+}
+
+} // namespace fs
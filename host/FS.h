@@ -0,0 +1,162 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: FS.h
+//
+// Description:
+//
+// host stand-in for the ESP32 fs::FS and fs::File classes, backed by a
+// directory of the host file system which plays the root of the card.
+// Files share their state between copies like the real File handle.
+// Directory listings come sorted by name so runs are repeatable.
+//
+// Every FS counts what goes through it (opens, reads, seeks, bytes)
+// so the benchmarks can report the storage traffic of the sketch.
+//
+// With timing.clock set, opens and reads also cost modelled card time
+// (added to micros() and stats.busMicros): a fixed cost per read call,
+// a read command with its access time for every run of 512 byte
+// sectors not cached, the sectors at timing.dataLines bits per clock,
+// and a directory sector for the first open of a path. Above
+// timing.maxClock every read fails, a card or wiring that is not
+// stable at that clock. The last timing.cacheSectors sectors stay cached
+// until dropCache(), which SD.begin() calls on a fresh mount, so cold
+// and warm reads differ like on the card. Charged opens and reads are
+// spans of the sd track of traceRecorder.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef FS_H
+#define FS_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+struct FSStats
+{
+    uint32_t opens;
+    uint32_t reads;
+    uint32_t seeks;
+    uint32_t writes;
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    double busMicros; // modelled card time, see FSTiming
+};
+
+struct FSTiming
+{
+    uint32_t clock;        // bits per second on the card bus, 0 turns the model off
+    double commandMicros;  // access time of one read command
+    double openMicros;     // path lookup of an open, directory sector not included
+    double callMicros;     // file system layers crossed by every read call
+    uint16_t cacheSectors; // sectors kept after a read
+    uint8_t dataLines;     // bits per clock: 1 on SPI and SDMMC 1-bit, 4 on SDMMC 4-bit
+    uint32_t maxClock;     // reads fail above this clock, 0 never
+};
+
+struct FileImpl;
+
+class File
+{
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> impl) : impl(impl) {}
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    int available();
+    int read();
+    size_t read(uint8_t *buf, size_t size);
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void flush();
+    void close();
+    time_t getLastWrite();
+    const char *path() const;
+    const char *name() const; // without the folder, like recent ESP32 cores
+    bool isDirectory() const;
+    File openNextFile(const char *mode = FILE_READ);
+    void rewindDirectory();
+
+    operator bool() const;
+
+private:
+    std::shared_ptr<FileImpl> impl;
+};
+
+class FS
+{
+public:
+    FS() {}
+    explicit FS(const char *root) { setRoot(root); }
+
+    // host directory serving as "/", empty when nothing is mounted
+    void setRoot(const char *root);
+    const char *root() const { return rootDir.c_str(); }
+
+    File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *pathFrom, const char *pathTo);
+    bool mkdir(const char *path);
+    bool rmdir(const char *path);
+
+    FSStats stats = {};
+    FSTiming timing = {};
+
+    // forgets the cached sectors and directory entries
+    void dropCache();
+
+    // host only: charge the modelled time of an open and of a read at pos
+    void chargeOpen(const std::string &path);
+    void chargeRead(const std::string &path, size_t pos, size_t len);
+    // host only: the bus runs above timing.maxClock, reads return nothing
+    bool readErrors() const { return timing.maxClock && timing.clock > timing.maxClock; }
+
+protected:
+    std::string hostPath(const char *path) const;
+    void charge(double micros, const char *what, const std::string &path, size_t len);
+    double sectorMicros() const;
+
+    std::string rootDir;
+
+    static const uint16_t sectorBytes = 512;
+    std::map<std::string, uint32_t> fileIds;
+    std::set<std::string> lookedUp;
+    std::vector<uint64_t> cached; // file id and sector, least recently used first
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekSet;
+
+#endif // FS_H
@@ -0,0 +1,123 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: SD.cpp
+//
+// Description:
+//
+// SD card and SPI bus objects of the host build, see SD.h and SD_MMC.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <filesystem>
+
+#include "SD.h"
+#include "SD_MMC.h"
+
+SPIClass SPI(VSPI);
+SDFS SD;
+SDMMCFS SD_MMC;
+
+static const uint64_t cardClusterBytes = 4096;
+static const uint64_t cardBytes = 4ull * 1024 * 1024 * 1024;
+
+bool SDFS::begin(uint8_t ssPin, SPIClass &spi, uint32_t frequency, const char *mountpoint, uint8_t max_files,
+                 bool format_if_empty)
+{
+    std::error_code ec;
+    begins++;
+    if (mounted)
+    {
+        return true; // like the ESP32 library, a second begin() keeps the mount
+    }
+    this->frequency = frequency;
+    this->spi = &spi;
+    timing.clock = frequency;
+    dropCache();
+    mounted = !rootDir.empty() && std::filesystem::is_directory(rootDir, ec) && spiWired;
+    return mounted;
+}
+
+void SDFS::end()
+{
+    mounted = false;
+}
+
+sdcard_type_t SDFS::cardType()
+{
+    return mounted ? CARD_SDHC : CARD_NONE;
+}
+
+uint64_t SDFS::cardSize()
+{
+    return mounted ? cardBytes : 0;
+}
+
+uint64_t SDFS::totalBytes()
+{
+    return cardSize();
+}
+
+// files rounded up to whole clusters, like FAT
+static uint64_t cardUsedBytes(const std::string &root)
+{
+    std::error_code ec;
+    uint64_t used = 0;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(root, ec))
+    {
+        if (entry.is_regular_file(ec))
+        {
+            used += (entry.file_size(ec) + cardClusterBytes - 1) / cardClusterBytes * cardClusterBytes;
+        }
+    }
+    return used;
+}
+
+uint64_t SDFS::usedBytes()
+{
+    return mounted ? cardUsedBytes(rootDir) : 0;
+}
+
+bool SDMMCFS::begin(const char *mountpoint, bool mode1bit, bool format_if_mount_failed, int sdmmc_frequency,
+                    uint8_t maxOpenFiles)
+{
+    std::error_code ec;
+    if (mounted)
+    {
+        return true;
+    }
+    timing.clock = sdmmc_frequency * 1000;
+    timing.dataLines = mode1bit ? 1 : 4;
+    dropCache();
+    mounted = !rootDir.empty() && std::filesystem::is_directory(rootDir, ec) && timing.dataLines <= wiredLines;
+    return mounted;
+}
+
+void SDMMCFS::end()
+{
+    mounted = false;
+}
+
+sdcard_type_t SDMMCFS::cardType()
+{
+    return mounted ? CARD_SDHC : CARD_NONE;
+}
+
+uint64_t SDMMCFS::cardSize()
+{
+    return mounted ? cardBytes : 0;
+}
+
+uint64_t SDMMCFS::totalBytes()
+{
+    return cardSize();
+}
+
+uint64_t SDMMCFS::usedBytes()
+{
+    return mounted ? cardUsedBytes(rootDir) : 0;
+}
@@ -0,0 +1,64 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: SD.h
+//
+// Description:
+//
+// host stand-in for the ESP32 SD library: an fs::FS over the card
+// directory given to setRoot(). begin() fails until a root is set,
+// usedBytes() rounds every file up to whole 4 KB clusters like FAT.
+//
+// Card time follows the FSTiming model of FS.h at the SPI clock given
+// to begin(), with the access times of a typical SDHC card. These are
+// estimates: use sdBench.h on the board for the real figures. SD_MMC.h
+// is the same card on the SDMMC host.
+//
+// spiWired is the host only wiring of the card: a card wired to the
+// SDMMC pins does not answer on the SPI bus, begin() fails.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SD_H
+#define SD_H
+
+#include "Arduino.h"
+#include "FS.h"
+#include "SPI.h"
+
+typedef enum
+{
+    CARD_NONE,
+    CARD_MMC,
+    CARD_SD,
+    CARD_SDHC,
+    CARD_UNKNOWN
+} sdcard_type_t;
+
+class SDFS : public fs::FS
+{
+public:
+    SDFS() { timing = {0, 300, 40, 15, 16, 1, 0}; }
+
+    bool begin(uint8_t ssPin = SS, SPIClass &spi = SPI, uint32_t frequency = 4000000, const char *mountpoint = "/sd",
+               uint8_t max_files = 5, bool format_if_empty = false);
+    void end();
+    sdcard_type_t cardType();
+    uint64_t cardSize();
+    uint64_t totalBytes();
+    uint64_t usedBytes();
+
+    uint32_t frequency = 0; // clock passed to the last begin()
+    SPIClass *spi = nullptr; // bus passed to the last begin()
+    uint32_t begins = 0;    // begin() calls, the sketch mounts again before each file
+    bool spiWired = true;   // host only: the card answers on the SPI pins
+    bool mounted = false;
+};
+
+extern SDFS SD;
+
+#endif // SD_H
@@ -0,0 +1,52 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: SD_MMC.h
+//
+// Description:
+//
+// host stand-in for the ESP32 SD_MMC library: the card of SD.h seen
+// through the SDMMC host, 1 or 4 data lines at the clock given to
+// begin() (in kHz, like the ESP32 library). hostCardImage() mounts
+// the same folder for both, the sketch uses one at a time.
+//
+// wiredLines is the host only wiring of the card: with only D0
+// connected a 4-bit begin() fails, as the card stops answering.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SD_MMC_H
+#define SD_MMC_H
+
+#include "Arduino.h"
+#include "FS.h"
+#include "SD.h"
+
+#define SDMMC_FREQ_DEFAULT 20000
+#define SDMMC_FREQ_HIGHSPEED 40000
+
+class SDMMCFS : public fs::FS
+{
+public:
+    SDMMCFS() { timing = {0, 300, 40, 15, 16, 4, 0}; }
+
+    bool setPins(int clk, int cmd, int d0, int d1 = -1, int d2 = -1, int d3 = -1) { return true; }
+    bool begin(const char *mountpoint = "/sdcard", bool mode1bit = false, bool format_if_mount_failed = false,
+               int sdmmc_frequency = SDMMC_FREQ_DEFAULT, uint8_t maxOpenFiles = 5);
+    void end();
+    sdcard_type_t cardType();
+    uint64_t cardSize();
+    uint64_t totalBytes();
+    uint64_t usedBytes();
+
+    uint8_t wiredLines = 4; // host only: data lines connected to the card
+    bool mounted = false;
+};
+
+extern SDMMCFS SD_MMC;
+
+#endif // SD_MMC_H
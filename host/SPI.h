@@ -0,0 +1,51 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: SPI.h
+//
+// Description:
+//
+// host stand-in for the ESP32 SPIClass, remembers its pins and clock
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SPI_H
+#define SPI_H
+
+#include "Arduino.h"
+
+#define FSPI 1
+#define HSPI 2
+#define VSPI 3
+
+class SPIClass
+{
+public:
+    explicit SPIClass(uint8_t spi_bus = HSPI) : bus(spi_bus) {}
+
+    bool begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1)
+    {
+        pins[0] = sck;
+        pins[1] = miso;
+        pins[2] = mosi;
+        pins[3] = ss;
+        started = true;
+        return true;
+    }
+    void end() { started = false; }
+    void setFrequency(uint32_t freq) { frequency = freq; }
+    uint32_t getFrequency() const { return frequency; }
+
+    uint8_t bus;
+    int8_t pins[4] = {-1, -1, -1, -1};
+    bool started = false;
+    uint32_t frequency = 1000000;
+};
+
+extern SPIClass SPI;
+
+#endif // SPI_H
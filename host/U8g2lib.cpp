@@ -0,0 +1,171 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: U8g2lib.cpp
+//
+// Description:
+//
+// u8g2 buffer, text and bus traffic of the host build, see U8g2lib.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "U8g2lib.h"
+
+const u8g2_cb_t u8g2_cb_r0 = {0};
+
+// u8x8 sets the SSD1306 bus clock before every transfer and leaves it there
+static const uint32_t u8g2BusClock = 400000;
+
+// profont10: 7 pixels above the baseline, 2 below, 5 pixel wide glyphs on a 6 pixel advance
+const uint8_t u8g2_font_profont10_tf[] = {7, 2, 6};
+
+// classic 5x7 column font, ' ' to '~', bit 0 is the top row, bit 7 the descender row
+static const uint8_t hostFont5x7[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00},
+    {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E},
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xFC, 0x18, 0x24, 0x24, 0x18},
+    {0x18, 0x24, 0x24, 0x18, 0xFC}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},
+};
+
+U8G2::U8G2(uint8_t widthPixels, uint8_t heightPixels) : width(widthPixels), height(heightPixels)
+{
+    memset(buffer, 0, sizeof(buffer));
+}
+
+bool U8G2::begin()
+{
+    Wire.begin();
+    clear();
+    setPowerSave(0);
+    return true;
+}
+
+void U8G2::clear()
+{
+    clearBuffer();
+    sendBuffer();
+}
+
+void U8G2::clearBuffer()
+{
+    memset(buffer, 0, sizeof(buffer));
+}
+
+void U8G2::sendBuffer()
+{
+    Wire.setClock(u8g2BusClock);
+    static const uint8_t window[] = {0x00, 0x20, 0x00, 0x21, 0x00, 0x7F, 0x22, 0x00, 0x07};
+    Wire.beginTransmission(address);
+    Wire.write(window, sizeof(window));
+    Wire.endTransmission();
+
+    uint32_t bytes = (uint32_t)width * (height / 8);
+    for (uint32_t sent = 0; sent < bytes; sent += I2C_BUFFER_LENGTH - 1)
+    {
+        uint32_t n = bytes - sent < I2C_BUFFER_LENGTH - 1 ? bytes - sent : I2C_BUFFER_LENGTH - 1;
+        Wire.beginTransmission(address);
+        Wire.write((uint8_t)0x40);
+        Wire.write(buffer + sent, n);
+        Wire.endTransmission();
+    }
+}
+
+void U8G2::setPowerSave(uint8_t is_enable)
+{
+    uint8_t cmd[] = {0x00, (uint8_t)(is_enable ? 0xAE : 0xAF)};
+    Wire.setClock(u8g2BusClock);
+    Wire.beginTransmission(address);
+    Wire.write(cmd, sizeof(cmd));
+    Wire.endTransmission();
+}
+
+void U8G2::setFont(const uint8_t *font)
+{
+    fontAscent = font[0];
+    fontDescent = font[1];
+    fontAdvance = font[2];
+}
+
+void U8G2::drawPixel(int16_t x, int16_t y)
+{
+    if (x < 0 || x >= width || y < 0 || y >= height)
+    {
+        return;
+    }
+    uint8_t &b = buffer[(y / 8) * width + x];
+    if (drawColor == 1)
+    {
+        b |= 1 << (y & 7);
+    }
+    else if (drawColor == 0)
+    {
+        b &= ~(1 << (y & 7));
+    }
+    else
+    {
+        b ^= 1 << (y & 7);
+    }
+}
+
+uint16_t U8G2::drawStr(int16_t x, int16_t y, const char *s)
+{
+    int16_t start = x;
+    for (; *s; s++, x += fontAdvance)
+    {
+        uint8_t c = (uint8_t)*s;
+        if (c < ' ' || c > '~')
+        {
+            c = '?';
+        }
+        const uint8_t *glyph = hostFont5x7[c - ' '];
+        for (uint8_t col = 0; col < 5; col++)
+        {
+            for (uint8_t row = 0; row < 8; row++)
+            {
+                if (glyph[col] & (1 << row))
+                {
+                    // rows 0..6 sit above the baseline, row 7 is the descender
+                    drawPixel(x + col, y - 7 + row);
+                }
+            }
+        }
+    }
+    return x - start;
+}
+
+uint16_t U8G2::getStrWidth(const char *s) const
+{
+    return strlen(s) * fontAdvance;
+}
@@ -0,0 +1,88 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: U8g2lib.h
+//
+// Description:
+//
+// host stand-in for the u8g2 full buffer SSD1306 driver: a 1 KB page
+// layout buffer and the calls the sketch makes. Text is drawn with a
+// built-in 5x7 font whatever font is selected, only the metrics of
+// the selected font (ascent, descent, advance) are honoured, so the
+// captions land on the same rows as on the device but not with the
+// same glyphs.
+//
+// sendBuffer() writes the whole buffer through a column/page window,
+// the real driver sends the same 1024 data bytes tile row by tile row.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef U8G2LIB_H
+#define U8G2LIB_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#define U8X8_HAVE_HW_I2C
+#define U8X8_PIN_NONE 255
+
+struct u8g2_cb_t
+{
+    uint8_t rotation;
+};
+
+extern const u8g2_cb_t u8g2_cb_r0;
+#define U8G2_R0 (&u8g2_cb_r0)
+
+// host fonts only carry their metrics: ascent, descent (below the baseline), advance
+extern const uint8_t u8g2_font_profont10_tf[];
+
+class U8G2
+{
+public:
+    U8G2(uint8_t widthPixels, uint8_t heightPixels);
+
+    bool begin();
+    void clear();
+    void clearBuffer();
+    void sendBuffer();
+    void setFont(const uint8_t *font);
+    int8_t getFontAscent() const { return fontAscent; }
+    int8_t getFontDescent() const { return -fontDescent; }
+    void setDrawColor(uint8_t color) { drawColor = color; }
+    void drawPixel(int16_t x, int16_t y);
+    // y is the baseline, returns the width of the string
+    uint16_t drawStr(int16_t x, int16_t y, const char *s);
+    uint16_t getStrWidth(const char *s) const;
+    uint8_t *getBufferPtr() { return buffer; }
+    uint16_t getDisplayWidth() const { return width; }
+    uint16_t getDisplayHeight() const { return height; }
+    void setPowerSave(uint8_t is_enable);
+    void setI2CAddress(uint8_t adr) { address = adr >> 1; }
+
+private:
+    uint8_t width;
+    uint8_t height;
+    uint8_t buffer[128 * 8];
+    uint8_t address = 0x3C;
+    uint8_t drawColor = 1;
+    int8_t fontAscent = 7;
+    int8_t fontDescent = 1;
+    uint8_t fontAdvance = 6;
+};
+
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2
+{
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t *rotation, uint8_t reset = U8X8_PIN_NONE,
+                                        uint8_t clock = U8X8_PIN_NONE, uint8_t data = U8X8_PIN_NONE)
+        : U8G2(128, 64)
+    {
+    }
+};
+
+#endif // U8G2LIB_H
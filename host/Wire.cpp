@@ -0,0 +1,134 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Wire.cpp
+//
+// Description:
+//
+// counting I2C bus of the host build, see Wire.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "Wire.h"
+
+#include "i2cTiming.h"
+#include "traceRecorder.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+static bool overlapping = false;
+
+void hostWireOverlap()
+{
+    overlapping = true;
+    Wire.overlapMicros = Wire1.overlapMicros = 0;
+}
+
+double hostWireJoin()
+{
+    overlapping = false;
+    double longest = Wire.overlapMicros > Wire1.overlapMicros ? Wire.overlapMicros : Wire1.overlapMicros;
+    Wire.overlapMicros = Wire1.overlapMicros = 0;
+    hostClockAdvance(longest);
+    return longest;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency)
+{
+    if (frequency)
+    {
+        clock = frequency;
+    }
+    return true;
+}
+
+bool TwoWire::end()
+{
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency)
+{
+    clock = frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address)
+{
+    this->address = address & 0x7F;
+    transmitting = true;
+    length = 0;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (!transmitting || length >= sizeof(buffer))
+    {
+        return 0;
+    }
+    buffer[length++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+    size_t n = 0;
+    while (n < quantity && write(data[n]))
+    {
+        n++;
+    }
+    return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    if (!transmitting)
+    {
+        return 4;
+    }
+    transmitting = false;
+
+    uint32_t busClock = fixedClock ? fixedClock : clock;
+    double micros = i2cTransactionMicros(length, busClock, overheadMicros);
+    stats.transmissions++;
+    stats.bytes += length;
+    stats.busMicros += micros;
+    if (traceActive())
+    {
+        // SSD1306 control byte: 0x40 data, 0x00 commands
+        char args[64];
+        snprintf(args, sizeof(args), "{\"bytes\":%u,\"clock\":%u}", (unsigned)length, busClock);
+        traceSpan(bus ? TRACE_I2C1 : TRACE_I2C, length && buffer[0] == 0x40 ? "data" : "command",
+                  hostClockMicros() + overlapMicros, micros, args);
+    }
+    if (overlapping)
+    {
+        overlapMicros += micros;
+    }
+    else
+    {
+        hostClockAdvance(micros);
+    }
+
+    if (maxClock && busClock > maxClock)
+    {
+        return 4; // bus error, the device lost track
+    }
+    if (!devices[address])
+    {
+        return 2; // address not acknowledged
+    }
+    devices[address](contexts[address], buffer, length);
+    return 0;
+}
+
+void TwoWire::attach(uint8_t address, WireDevice device, void *ctx)
+{
+    devices[address & 0x7F] = device;
+    contexts[address & 0x7F] = ctx;
+}
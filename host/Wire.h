@@ -0,0 +1,95 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: Wire.h
+//
+// Description:
+//
+// host stand-in for the ESP32 TwoWire class. Nothing is sent anywhere:
+// every transmission is counted, its time on the bus is estimated from
+// the clock in use, and it is handed to the device listening on its
+// address (see ssd1306Panel.h) so the panel content can be checked.
+//
+// Bus time of a transmission: start + address byte + data bytes (9
+// clocks each with the ACK) + stop, at the clock set by setClock(),
+// see i2cTiming.h, plus the per transmission driver cost of
+// overheadMicros. The time is added to the host clock (micros()) as
+// the ESP32 waits for the bus too. Above maxClock (0: no limit) the
+// device stops answering, transmissions fail and nothing reaches it.
+// fixedClock (0: off) runs the bus at that clock whatever setClock()
+// asked, to model a slower or faster bus under an unchanged sketch.
+// Every transmission is a span of the i2c (Wire) or i2c1 (Wire1) track
+// of traceRecorder.h.
+//
+// Between hostWireOverlap() and hostWireJoin() the two buses run side
+// by side, like the two ESP32 controllers each driven by its own task
+// (see displayManager.h): the time of each bus is kept apart instead
+// of being added to the host clock, hostWireJoin() adds the longest.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include "Arduino.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+// receives the bytes of every transmission sent to one address
+typedef void (*WireDevice)(void *ctx, const uint8_t *data, size_t len);
+
+struct WireStats
+{
+    uint32_t transmissions;
+    uint64_t bytes;   // data bytes, control bytes included, address bytes not
+    double busMicros; // time the bus was busy
+};
+
+class TwoWire
+{
+public:
+    explicit TwoWire(uint8_t bus_num) : bus(bus_num) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() const { return clock; }
+
+    void beginTransmission(uint16_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+
+    // host only: the device answering at address, nullptr to remove it
+    void attach(uint8_t address, WireDevice device, void *ctx);
+
+    WireStats stats = {};
+    double overlapMicros = 0; // bus time since hostWireOverlap()
+    double overheadMicros = 0;
+    uint32_t maxClock = 0;
+    uint32_t fixedClock = 0;
+
+private:
+    uint8_t bus;
+    uint32_t clock = 100000;
+    uint16_t address = 0;
+    bool transmitting = false;
+    uint8_t buffer[I2C_BUFFER_LENGTH];
+    size_t length = 0;
+
+    WireDevice devices[128] = {};
+    void *contexts[128] = {};
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+void hostWireOverlap();
+// returns the time added to the host clock, the busiest bus
+double hostWireJoin();
+
+#endif // WIRE_H
@@ -0,0 +1,128 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: esp_timer.cpp
+//
+// Description:
+//
+// periodic timers of the host build on the host clock, see esp_timer.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include "esp_timer.h"
+
+struct esp_timer
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    bool skip;
+    bool running;
+    uint64_t period;
+    double due; // host clock of the next expiry
+};
+
+static std::vector<esp_timer *> timers;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (!create_args || !create_args->callback || !out_handle)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_timer *timer = new esp_timer{create_args->callback, create_args->arg, create_args->skip_unhandled_events,
+                                     false, 0, 0};
+    timers.push_back(timer);
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    if (!timer || period == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->running = true;
+    timer->period = period;
+    timer->due = hostClockMicros() + period;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (!timer || !timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->running = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (!timer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timers.erase(std::remove(timers.begin(), timers.end(), timer), timers.end());
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time()
+{
+    return (int64_t)hostClockMicros();
+}
+
+bool hostTimerRun()
+{
+    esp_timer *next = nullptr;
+    for (esp_timer *timer : timers)
+    {
+        if (timer->running && (!next || timer->due < next->due))
+        {
+            next = timer;
+        }
+    }
+    if (!next)
+    {
+        return false;
+    }
+    double now = hostClockMicros();
+    if (next->due > now)
+    {
+        hostClockAdvance(next->due - now);
+        now = next->due;
+    }
+
+    // a callback may stop the timers, not delete them
+    std::vector<esp_timer *> due = timers;
+    for (esp_timer *timer : due)
+    {
+        while (timer->running && timer->due <= now)
+        {
+            timer->due += timer->period;
+            while (timer->skip && timer->due <= now)
+            {
+                timer->due += timer->period;
+            }
+            timer->callback(timer->arg);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: esp_timer.h
+//
+// Description:
+//
+// host stand-in for the ESP-IDF high resolution timer, the periodic
+// calls of esp_timer_create() and esp_timer_start_periodic() on the
+// host clock of Arduino.h. Nothing runs in the background: a task
+// waiting in ulTaskNotifyTake() lets the timers run instead, the clock
+// jumps to the next expiry and the callbacks due by then are called,
+// all the ticks a late waiter missed included (one for the timers
+// created with skip_unhandled_events). The wait ends once a callback
+// notified the task.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include "Arduino.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+
+typedef struct esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum
+{
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+int64_t esp_timer_get_time();
+
+// runs the timers due by now, or moves the clock to the next expiry first; false when no timer runs
+bool hostTimerRun();
+
+#endif // ESP_TIMER_H
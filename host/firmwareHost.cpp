@@ -0,0 +1,228 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: firmwareHost.cpp
+//
+// Description:
+//
+// runs the sketch of src/main.cpp on the host: setup() once, then the
+// given number of loop() passes (1 by default) against a scratch copy
+// of the animation files. Fails when the simulated panel does not end
+// up showing the sketch's display buffer. With --record every image
+// the panel receives is written to DIR/firmware.pbm and its hash to
+// DIR/firmware.hash (see frameRecorder.h). --serial writes what the
+// sketch prints to FILE instead of stdout. --no-card leaves the SD
+// slot empty, for firmware_host_embedded whose animations are linked in.
+// The scratch card is the directory given with --card, by default the
+// program name followed by .card, so runs side by side (ctest -j) each
+// have their own.
+//
+// --trace writes the session as Chrome trace JSON for Perfetto (see
+// traceRecorder.h) and prints the time of each track. The bus models
+// take --i2c-clock (the panel bus runs at HZ whatever the sketch sets),
+// --i2c-overhead (driver cost per transaction), --sd-clock (the card
+// reads fail above HZ, the probe of sdStorage.h settles below it) and
+// --sd-command (access time of a card read), to compare a 100 kHz
+// with a 1 MHz bus or a fast with a slow card.
+//
+// Panels also answer at 0x3D on Wire and at 0x3C on Wire1; built with
+// MULTI_DISPLAY (firmware_host_multi) the sketch drives all three
+// through displayManager.h and each must show its own buffer.
+//
+// Built with ANIM_PROFILE (firmware_host_profile) it asks for the stage
+// histograms before every loop() pass, like typing 'p' in the serial
+// monitor; tools/profdump decodes the records from the --serial file.
+//
+// Usage:   firmware_host [--record DIR] [--serial FILE] [--no-card] [--card DIR] [--trace FILE]
+//                        [--i2c-clock HZ] [--i2c-overhead US] [--sd-clock HZ] [--sd-command US]
+//                        [loops]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <SD.h>
+#include <SD_MMC.h>
+
+#include <filesystem>
+#include <string>
+
+#include "frameRecorder.h"
+#include "hostCard.h"
+#include "hostHeap.h"
+#include "ssd1306Panel.h"
+#include "traceRecorder.h"
+
+void setup(void);
+void loop(void);
+
+extern Adafruit_SSD1306 display;
+#ifdef MULTI_DISPLAY
+extern Adafruit_SSD1306 displaySystem;
+extern Adafruit_SSD1306 displayBattery;
+#endif
+
+int main(int argc, char **argv)
+{
+    int loops = 1;
+    const char *recordDir = nullptr;
+    FILE *serial = nullptr;
+    bool card = true;
+    std::string cardDir = std::filesystem::path(argv[0]).filename().string() + ".card";
+    const char *tracePath = nullptr;
+    uint32_t sdClock = 0; // stable at any clock
+    double sdCommand = -1;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--record") && i + 1 < argc)
+        {
+            recordDir = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--serial") && i + 1 < argc)
+        {
+            if (!(serial = fopen(argv[++i], "wb")))
+            {
+                fprintf(stderr, "cannot create %s\n", argv[i]);
+                return 1;
+            }
+            hostSerialOutput(serial);
+        }
+        else if (!strcmp(argv[i], "--no-card"))
+        {
+            card = false;
+        }
+        else if (!strcmp(argv[i], "--card") && i + 1 < argc)
+        {
+            cardDir = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--i2c-clock") && i + 1 < argc)
+        {
+            Wire.fixedClock = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--i2c-overhead") && i + 1 < argc)
+        {
+            Wire.overheadMicros = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--sd-clock") && i + 1 < argc)
+        {
+            sdClock = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--sd-command") && i + 1 < argc)
+        {
+            sdCommand = atof(argv[++i]);
+        }
+        else
+        {
+            loops = atoi(argv[i]);
+        }
+    }
+
+    if (card && !hostCardImage(ANIM_FILES_DIR, cardDir.c_str()))
+    {
+        return 1;
+    }
+    if (card)
+    {
+        // the sketch probes the bus modes in setup(), the card decides which ones work
+        SD.timing.maxClock = SD_MMC.timing.maxClock = sdClock;
+        if (sdCommand >= 0)
+        {
+            SD.timing.commandMicros = SD_MMC.timing.commandMicros = sdCommand;
+        }
+    }
+    if (tracePath && !traceOpen(tracePath))
+    {
+        return 1;
+    }
+
+    SSD1306Panel panel;
+    panel.attach(Wire, 0x3C);
+    SSD1306Panel panelSystem;
+    panelSystem.attach(Wire, 0x3D);
+    SSD1306Panel panelBattery;
+    panelBattery.attach(Wire1, 0x3C);
+
+    FrameRecorder recorder;
+    if (recordDir)
+    {
+        std::string dir = recordDir;
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        if (!recorder.open((dir + "/firmware.pbm").c_str(), (dir + "/firmware.hash").c_str()))
+        {
+            return 1;
+        }
+        recorder.attach(panel);
+    }
+
+    double start = hostClockMicros();
+    setup();
+    for (int i = 0; i < loops; i++)
+    {
+#ifdef ANIM_PROFILE
+        hostSerialInput("p");
+#endif
+        loop();
+    }
+    double session = hostClockMicros() - start;
+
+    if (serial)
+    {
+        hostSerialOutput(stdout);
+        fclose(serial);
+    }
+
+    if (memcmp(panel.ram(), display.getBuffer(), 1024) != 0)
+    {
+        fprintf(stderr, "panel content differs from the display buffer\n");
+        return 1;
+    }
+#ifdef MULTI_DISPLAY
+    if (memcmp(panelSystem.ram(), displaySystem.getBuffer(), 1024) != 0 ||
+        memcmp(panelBattery.ram(), displayBattery.getBuffer(), 1024) != 0)
+    {
+        fprintf(stderr, "panel content differs from the display buffer, second or third panel\n");
+        return 1;
+    }
+#endif
+    if (recordDir)
+    {
+        printf("recorded %u images to %s\n", (unsigned)recorder.hashes().size(), recordDir);
+    }
+    uint8_t tagCount;
+    const HostHeapTag *tags = hostHeapTags(tagCount);
+    for (uint8_t i = 0; i < tagCount; i++)
+    {
+        printf("heap %-8s %6zu bytes held, %6zu peak, %5u allocations\n", tags[i].name, tags[i].stats.used,
+               tags[i].stats.highWater, tags[i].stats.allocs);
+    }
+    printf("I2C: %u transmissions, %llu bytes, %.0f ms on the bus\n", Wire.stats.transmissions,
+           (unsigned long long)Wire.stats.bytes, Wire.stats.busMicros / 1000);
+    if (Wire1.stats.transmissions)
+    {
+        printf("I2C1: %u transmissions, %llu bytes, %.0f ms on the bus\n", Wire1.stats.transmissions,
+               (unsigned long long)Wire1.stats.bytes, Wire1.stats.busMicros / 1000);
+    }
+    if (tracePath)
+    {
+        size_t events = traceEventCount();
+        if (!traceClose())
+        {
+            return 1;
+        }
+        double sdMicros = SD.stats.busMicros + SD_MMC.stats.busMicros;
+        printf("trace: %zu spans to %s, session %.0f ms: I2C busy %.0f ms (%.0f%%), SD busy %.0f ms (%.0f%%)\n", events,
+               tracePath, session / 1000, Wire.stats.busMicros / 1000, 100 * Wire.stats.busMicros / session,
+               sdMicros / 1000, 100 * sdMicros / session);
+    }
+    return 0;
+}
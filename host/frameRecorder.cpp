@@ -0,0 +1,108 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: frameRecorder.cpp
+//
+// Description:
+//
+// panel image recorder of the host build, see frameRecorder.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <string.h>
+
+#include "frameRecorder.h"
+
+bool FrameRecorder::open(const char *pbmPath, const char *hashPath)
+{
+    close();
+    frameHashes.clear();
+    if (pbmPath && !(pbm = fopen(pbmPath, "wb")))
+    {
+        fprintf(stderr, "cannot create %s\n", pbmPath);
+        return false;
+    }
+    if (hashPath && !(hashOut = fopen(hashPath, "w")))
+    {
+        fprintf(stderr, "cannot create %s\n", hashPath);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void FrameRecorder::close()
+{
+    if (pbm)
+    {
+        fclose(pbm);
+        pbm = nullptr;
+    }
+    if (hashOut)
+    {
+        fclose(hashOut);
+        hashOut = nullptr;
+    }
+}
+
+void FrameRecorder::attach(SSD1306Panel &panel)
+{
+    panel.onFlush(flushed, this);
+}
+
+void FrameRecorder::detach(SSD1306Panel &panel)
+{
+    panel.onFlush(nullptr, nullptr);
+}
+
+void FrameRecorder::flushed(void *ctx, const SSD1306Panel &panel)
+{
+    ((FrameRecorder *)ctx)->capture(panel.ram());
+}
+
+void FrameRecorder::capture(const uint8_t *pages)
+{
+    uint64_t h = hash(pages);
+    if (hashOut)
+    {
+        fprintf(hashOut, "%u %016llx\n", (unsigned)frameHashes.size(), (unsigned long long)h);
+    }
+    if (pbm)
+    {
+        writePbm(pbm, pages);
+    }
+    frameHashes.push_back(h);
+}
+
+uint64_t FrameRecorder::hash(const uint8_t *pages)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (uint32_t i = 0; i < width * height / 8; i++)
+    {
+        h ^= pages[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+void FrameRecorder::writePbm(FILE *out, const uint8_t *pages)
+{
+    fprintf(out, "P4\n%u %u\n", width, height);
+    uint8_t row[width / 8];
+    for (uint16_t y = 0; y < height; y++)
+    {
+        memset(row, 0, sizeof(row));
+        for (uint16_t x = 0; x < width; x++)
+        {
+            if (pages[(y / 8) * width + x] & (1 << (y & 7)))
+            {
+                row[x / 8] |= 0x80 >> (x & 7);
+            }
+        }
+        fwrite(row, 1, sizeof(row), out);
+    }
+}
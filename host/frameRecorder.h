@@ -0,0 +1,65 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: frameRecorder.h
+//
+// Description:
+//
+// records what the simulated panel shows, one 128x64 image per flush
+// (attach) or per explicit capture(). Every image is hashed (64 bit
+// FNV-1a of the 1 KB page buffer) for regression checks, and can be
+// appended to a PBM stream for inspection: binary P4 images written
+// back to back, which netpbm reads as a sequence (pnmsplit, pamfile).
+// Lit pixels are black in the PBM.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef FRAMERECORDER_H
+#define FRAMERECORDER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "ssd1306Panel.h"
+
+class FrameRecorder
+{
+public:
+    static const uint16_t width = 128;
+    static const uint16_t height = 64;
+
+    ~FrameRecorder() { close(); }
+
+    // either path may be nullptr, hashes are always kept in memory
+    bool open(const char *pbmPath, const char *hashPath);
+    void close();
+
+    // records every flush of the panel from now on
+    void attach(SSD1306Panel &panel);
+    void detach(SSD1306Panel &panel);
+
+    // records one image in the SSD1306 page layout
+    void capture(const uint8_t *pages);
+
+    const std::vector<uint64_t> &hashes() const { return frameHashes; }
+    void clear() { frameHashes.clear(); }
+
+    static uint64_t hash(const uint8_t *pages);
+    // writes one P4 image of a page layout buffer
+    static void writePbm(FILE *out, const uint8_t *pages);
+
+private:
+    static void flushed(void *ctx, const SSD1306Panel &panel);
+
+    FILE *pbm = nullptr;
+    FILE *hashOut = nullptr;
+    std::vector<uint64_t> frameHashes;
+};
+
+#endif // FRAMERECORDER_H
@@ -0,0 +1,57 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: hostCard.cpp
+//
+// Description:
+//
+// simulated SD card set up from a folder, see hostCard.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <filesystem>
+
+#include "SD.h"
+#include "SD_MMC.h"
+#include "hostCard.h"
+
+bool hostCardImage(const char *source, const char *card)
+{
+    namespace stdfs = std::filesystem;
+    std::error_code ec;
+
+    if (!stdfs::is_directory(source, ec))
+    {
+        fprintf(stderr, "no animation folder at %s\n", source);
+        return false;
+    }
+    stdfs::remove_all(card, ec);
+    if (!stdfs::create_directories(card, ec))
+    {
+        fprintf(stderr, "cannot create %s\n", card);
+        return false;
+    }
+    for (const auto &entry : stdfs::directory_iterator(source, ec))
+    {
+        if (entry.is_regular_file(ec))
+        {
+            stdfs::copy_file(entry.path(), stdfs::path(card) / entry.path().filename(), ec);
+            if (ec)
+            {
+                fprintf(stderr, "cannot copy %s\n", entry.path().string().c_str());
+                return false;
+            }
+        }
+    }
+
+    // a new card: unmounted until the next SD.begin() or SD_MMC.begin()
+    SD.end();
+    SD.setRoot(card);
+    SD_MMC.end();
+    SD_MMC.setRoot(card);
+    return true;
+}
@@ -0,0 +1,31 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: hostCard.h
+//
+// Description:
+//
+// prepares the simulated SD card of a host program: a fresh copy of
+// the animation files (files/ by default) in a scratch directory,
+// mounted as the root of SD and SD_MMC. The sketch writes its index
+// next to the animations, the copy keeps the checked-in folder
+// untouched.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef HOSTCARD_H
+#define HOSTCARD_H
+
+// animation files checked in with the sketch, set by CMakeLists.txt
+#ifndef ANIM_FILES_DIR
+#define ANIM_FILES_DIR "files"
+#endif
+
+// copies every file of source into card (emptied first) and mounts it as SD and SD_MMC
+bool hostCardImage(const char *source, const char *card);
+
+#endif // HOSTCARD_H
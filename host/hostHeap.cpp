@@ -0,0 +1,200 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: hostHeap.cpp
+//
+// Description:
+//
+// global operator new/delete that keep a size header in front of each
+// block, see hostHeap.h. Also implements the ESP heap queries so that
+// this object is always linked in when the sketch asks for them.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+
+#include "Arduino.h"
+#include "hostHeap.h"
+
+// keeps the block behind it aligned for any type
+static const size_t hostHeapHeader = alignof(std::max_align_t);
+
+static HostHeapStats heapStats = {0, 0, 0, 0, 0};
+
+static HostHeapTag heapTags[hostHeapMaxTags] = {{"other", {}}};
+static uint8_t heapTagCount = 1;
+static uint8_t heapTagInUse = 0;
+
+// block header: size, then the tag the block is charged to
+struct HostHeapBlock
+{
+    size_t size;
+    uint8_t tag;
+};
+static_assert(sizeof(HostHeapBlock) <= hostHeapHeader, "block header does not fit");
+
+static void hostHeapCount(HostHeapStats &stats, size_t size)
+{
+    stats.used += size;
+    stats.peak = stats.used > stats.peak ? stats.used : stats.peak;
+    stats.highWater = stats.used > stats.highWater ? stats.used : stats.highWater;
+    stats.allocs++;
+}
+
+static size_t heapLimit = 0;
+
+static void *hostHeapAlloc(size_t size)
+{
+    if (heapLimit && heapStats.used + size > heapLimit)
+    {
+        return nullptr;
+    }
+    uint8_t *block = (uint8_t *)malloc(size + hostHeapHeader);
+    if (!block)
+    {
+        return nullptr;
+    }
+    HostHeapBlock *header = (HostHeapBlock *)block;
+    header->size = size;
+    header->tag = heapTagInUse;
+    hostHeapCount(heapStats, size);
+    hostHeapCount(heapTags[heapTagInUse].stats, size);
+    return block + hostHeapHeader;
+}
+
+static void hostHeapFree(void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    uint8_t *block = (uint8_t *)ptr - hostHeapHeader;
+    HostHeapBlock *header = (HostHeapBlock *)block;
+    heapStats.used -= header->size;
+    heapStats.frees++;
+    heapTags[header->tag].stats.used -= header->size;
+    heapTags[header->tag].stats.frees++;
+    free(block);
+}
+
+const HostHeapStats &hostHeap()
+{
+    return heapStats;
+}
+
+void hostHeapResetPeak()
+{
+    heapStats.peak = heapStats.used;
+    for (uint8_t i = 0; i < heapTagCount; i++)
+    {
+        heapTags[i].stats.peak = heapTags[i].stats.used;
+    }
+}
+
+void hostHeapLimit(size_t bytes)
+{
+    heapLimit = bytes;
+}
+
+uint8_t hostHeapTag(const char *name)
+{
+    for (uint8_t i = 0; i < heapTagCount; i++)
+    {
+        if (strcmp(heapTags[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+    if (heapTagCount == hostHeapMaxTags)
+    {
+        return 0;
+    }
+    heapTags[heapTagCount] = {name, {}};
+    return heapTagCount++;
+}
+
+uint8_t hostHeapEnter(uint8_t tag)
+{
+    uint8_t previous = heapTagInUse;
+    heapTagInUse = tag < heapTagCount ? tag : 0;
+    return previous;
+}
+
+const HostHeapTag *hostHeapTags(uint8_t &count)
+{
+    count = heapTagCount;
+    return heapTags;
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = hostHeapAlloc(size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return hostHeapAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return hostHeapAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    hostHeapFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    hostHeapFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    hostHeapFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    hostHeapFree(ptr);
+}
+
+EspClass ESP;
+
+uint32_t EspClass::getHeapSize()
+{
+    return hostHeapSize;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return heapStats.used > hostHeapSize ? 0 : hostHeapSize - heapStats.used;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    return heapStats.highWater > hostHeapSize ? 0 : hostHeapSize - heapStats.highWater;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+    return getFreeHeap();
+}
@@ -0,0 +1,70 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: hostHeap.h
+//
+// Description:
+//
+// counting replacement of the global operator new/delete used by the
+// host build. Every allocation made through new (the animation code
+// only allocates with new) is tracked, which gives the figures behind
+// ESP.getFreeHeap() and the per animation heap usage of bench_anim.
+//
+// hostHeapSize is the free heap of an ESP32 running this sketch with
+// WiFi off, roughly what ESP.getHeapSize() reports on the device.
+//
+// hostHeapLimit() makes allocations fail once the heap in use would
+// pass a limit, like the ESP32 heap running out: new throws, new
+// (std::nothrow) returns nullptr.
+//
+// Allocations are also attributed to the subsystem entered last with
+// hostHeapEnter() (MEM_SCOPE of memTelemetry.h), frees go back to the
+// subsystem that allocated the block.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef HOSTHEAP_H
+#define HOSTHEAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const uint32_t hostHeapSize = 320 * 1024;
+
+struct HostHeapStats
+{
+    size_t used;        // bytes currently allocated
+    size_t peak;        // highest value of used since the last hostHeapResetPeak()
+    size_t highWater;   // highest value of used since start
+    uint32_t allocs;    // allocations since start
+    uint32_t frees;
+};
+
+const HostHeapStats &hostHeap();
+
+// starts a new peak measurement from the current usage
+void hostHeapResetPeak();
+
+// allocations taking the heap in use past bytes fail, 0 lifts the limit
+void hostHeapLimit(size_t bytes);
+
+static const uint8_t hostHeapMaxTags = 8;
+
+struct HostHeapTag
+{
+    const char *name; // tag 0 is "other", whatever no subsystem claimed
+    HostHeapStats stats;
+};
+
+// index of the subsystem of that name, registered on first use
+uint8_t hostHeapTag(const char *name);
+// allocations go to the tag from now on, returns the tag in use before
+uint8_t hostHeapEnter(uint8_t tag);
+
+const HostHeapTag *hostHeapTags(uint8_t &count);
+
+#endif // HOSTHEAP_H
@@ -0,0 +1,107 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: panelIntensity.cpp
+//
+// Description:
+//
+// perceived pixel levels of the host build, see panelIntensity.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <math.h>
+#include <string.h>
+
+#include "panelIntensity.h"
+
+void PanelIntensity::attach(SSD1306Panel &panel, double tauMicros)
+{
+    tau = tauMicros;
+    started = false;
+    settled = false;
+    flushes = 0;
+    panel.onFlush(flushed, this);
+}
+
+void PanelIntensity::detach(SSD1306Panel &panel)
+{
+    panel.onFlush(nullptr, nullptr);
+}
+
+void PanelIntensity::flushed(void *ctx, const SSD1306Panel &panel)
+{
+    PanelIntensity &intensity = *(PanelIntensity *)ctx;
+    double now = hostClockMicros();
+    if (intensity.started)
+    {
+        intensity.advance(now);
+    }
+    memcpy(intensity.shown, panel.ram(), sizeof(intensity.shown));
+    if (!intensity.started)
+    {
+        intensity.started = true;
+        intensity.start = intensity.last = now;
+        for (uint16_t i = 0; i < width * height; i++)
+        {
+            intensity.onMicros[i] = 0;
+            intensity.level[i] = intensity.lit(i);
+        }
+    }
+    intensity.flushes++;
+}
+
+// the pixels held their state from last to now; the low pass only turns at the changes, where it peaks
+void PanelIntensity::advance(double now)
+{
+    double dt = now - last;
+    if (dt <= 0)
+    {
+        return;
+    }
+    double decay = exp(-dt / tau);
+    bool settle = !settled && now - start >= 5 * tau;
+    for (uint16_t i = 0; i < width * height; i++)
+    {
+        double on = lit(i);
+        onMicros[i] += on * dt;
+        level[i] = on + (level[i] - on) * decay;
+        if (settle)
+        {
+            low[i] = high[i] = level[i];
+        }
+        else if (settled)
+        {
+            low[i] = level[i] < low[i] ? level[i] : low[i];
+            high[i] = level[i] > high[i] ? level[i] : high[i];
+        }
+    }
+    settled = settled || settle;
+    last = now;
+}
+
+double PanelIntensity::mean(uint8_t x, uint8_t y) const
+{
+    uint16_t i = y * width + x;
+    double now = hostClockMicros();
+    if (!started || now <= start)
+    {
+        return 0;
+    }
+    double on = onMicros[i] + (lit(i) ? now - last : 0);
+    return on / (now - start);
+}
+
+double PanelIntensity::ripple(uint8_t x, uint8_t y) const
+{
+    uint16_t i = y * width + x;
+    return settled ? high[i] - low[i] : 0;
+}
+
+double PanelIntensity::elapsedMicros() const
+{
+    return started ? hostClockMicros() - start : 0;
+}
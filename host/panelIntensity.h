@@ -0,0 +1,66 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: panelIntensity.h
+//
+// Description:
+//
+// what the eye makes of the simulated SSD1306 when pixels blink faster
+// than it follows (the bit-planes of planePlayer.h): from the first
+// flush after attach() on, the time each pixel is lit is integrated on
+// the host clock. mean() is the share of the time lit, the level a steady
+// pixel would need to look the same. The eye is modelled as a first
+// order low pass of time constant tau (about 20 ms); ripple() is the
+// peak to peak swing of that perceived level once it settled (after 5
+// tau), 0 for a steady pixel and close to 1 for a pixel blinking
+// slowly: the flicker left at the slot rate.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef PANELINTENSITY_H
+#define PANELINTENSITY_H
+
+#include <stdint.h>
+
+#include "ssd1306Panel.h"
+
+class PanelIntensity
+{
+public:
+    static const uint8_t width = 128;
+    static const uint8_t height = 64;
+
+    // integrates what the panel shows from its next flush on
+    void attach(SSD1306Panel &panel, double tauMicros = 20000);
+    void detach(SSD1306Panel &panel);
+
+    // share of the time the pixel was lit since the first flush, up to now
+    double mean(uint8_t x, uint8_t y) const;
+    // peak to peak of the perceived level since it settled
+    double ripple(uint8_t x, uint8_t y) const;
+    double elapsedMicros() const;
+
+    uint32_t flushes = 0;
+
+private:
+    static void flushed(void *ctx, const SSD1306Panel &panel);
+    void advance(double now);
+    bool lit(uint16_t i) const { return shown[(i / width / 8) * width + i % width] & (1 << (i / width % 8)); }
+
+    uint8_t shown[width * height / 8] = {};
+    double tau = 20000;
+    double start = 0;
+    double last = 0;
+    double onMicros[width * height] = {};
+    double level[width * height] = {};
+    double low[width * height] = {};
+    double high[width * height] = {};
+    bool started = false;
+    bool settled = false;
+};
+
+#endif // PANELINTENSITY_H
@@ -0,0 +1,179 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: ssd1306Panel.cpp
+//
+// Description:
+//
+// SSD1306 command/data decoder of the host build, see ssd1306Panel.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "ssd1306Panel.h"
+
+// arguments following each multi byte command of the SSD1306
+static uint8_t panelArgCount(uint8_t c)
+{
+    switch (c)
+    {
+    case 0x20: // memory addressing mode
+    case 0x81: // contrast
+    case 0x8D: // charge pump
+    case 0xA8: // multiplex ratio
+    case 0xD3: // display offset
+    case 0xD5: // clock divide
+    case 0xD9: // pre-charge
+    case 0xDA: // COM pins
+    case 0xDB: // VCOMH
+        return 1;
+    case 0x21: // column address window
+    case 0x22: // page address window
+    case 0xA3: // vertical scroll area
+        return 2;
+    case 0x29:
+    case 0x2A: // vertical and horizontal scroll
+        return 5;
+    case 0x26:
+    case 0x27: // horizontal scroll
+        return 6;
+    }
+    return 0;
+}
+
+void SSD1306Panel::attach(TwoWire &wire, uint8_t address)
+{
+    detach();
+    bus = &wire;
+    this->address = address;
+    wire.attach(address, receive, this);
+}
+
+void SSD1306Panel::detach()
+{
+    if (bus)
+    {
+        bus->attach(address, nullptr, nullptr);
+        bus = nullptr;
+    }
+}
+
+void SSD1306Panel::onFlush(PanelFlush callback, void *ctx)
+{
+    flushed = callback;
+    flushedCtx = ctx;
+}
+
+// first byte is the control byte: 0x00 commands follow, 0x40 data follows
+void SSD1306Panel::receive(void *ctx, const uint8_t *data, size_t len)
+{
+    SSD1306Panel &panel = *(SSD1306Panel *)ctx;
+    if (len == 0)
+    {
+        return;
+    }
+    bool isData = data[0] & 0x40;
+    for (size_t i = 1; i < len; i++)
+    {
+        if (isData)
+        {
+            panel.data(data[i]);
+        }
+        else
+        {
+            panel.command(data[i]);
+        }
+    }
+}
+
+void SSD1306Panel::command(uint8_t c)
+{
+    commandBytes++;
+    if (argsLeft)
+    {
+        args[argCount++] = c;
+        if (--argsLeft)
+        {
+            return;
+        }
+        switch (pending)
+        {
+        case 0x20:
+            mode = args[0] & 3;
+            break;
+        case 0x21:
+            col0 = args[0] & 0x7F;
+            col1 = args[1] & 0x7F;
+            col = col0;
+            break;
+        case 0x22:
+            page0 = args[0] & 7;
+            page1 = args[1] & 7;
+            page = page0;
+            break;
+        }
+        return;
+    }
+
+    argsLeft = panelArgCount(c);
+    if (argsLeft)
+    {
+        pending = c;
+        argCount = 0;
+        return;
+    }
+
+    if (c == 0xAE || c == 0xAF)
+    {
+        on = c == 0xAF;
+    }
+    else if (c >= 0xB0 && c <= 0xB7)
+    {
+        page = c & 7;
+    }
+    else if (c <= 0x0F)
+    {
+        col = (col & 0xF0) | c;
+    }
+    else if (c >= 0x10 && c <= 0x17)
+    {
+        col = ((c & 0x07) << 4) | (col & 0x0F);
+    }
+}
+
+void SSD1306Panel::data(uint8_t d)
+{
+    dataBytes++;
+    gddram[page * width + (col & 0x7F)] = d;
+
+    if (mode == 2)
+    {
+        col = (col + 1) & 0x7F;
+        return;
+    }
+    if (mode == 1)
+    {
+        page = page < page1 ? page + 1 : page0;
+        if (page == page0)
+        {
+            col = col < col1 ? col + 1 : col0;
+        }
+        return;
+    }
+    col = col < col1 ? col + 1 : col0;
+    if (col == col0)
+    {
+        page = page < page1 ? page + 1 : page0;
+        if (page == page0)
+        {
+            flushes++;
+            if (flushed)
+            {
+                flushed(flushedCtx, *this);
+            }
+        }
+    }
+}
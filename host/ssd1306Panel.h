@@ -0,0 +1,79 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: ssd1306Panel.h
+//
+// Description:
+//
+// model of the SSD1306 controller on the other end of the host I2C
+// bus. Decodes the command and data streams sent by Adafruit_SSD1306,
+// u8g2 and oledFlushRegion() into its own 128x64 display RAM, so a
+// test can check what the panel really shows after partial updates,
+// not just what is in the sketch's buffer.
+//
+// Handles the horizontal (column/page window) and page addressing
+// modes; other commands are skipped with their arguments. In the
+// horizontal mode a flush is complete when the data pointer wraps back
+// to the start of the window, onFlush() is told about each one.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SSD1306PANEL_H
+#define SSD1306PANEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Wire.h"
+
+class SSD1306Panel;
+
+// called after every flush that filled its whole column/page window
+typedef void (*PanelFlush)(void *ctx, const SSD1306Panel &panel);
+
+class SSD1306Panel
+{
+public:
+    static const uint8_t width = 128;
+    static const uint8_t pages = 8;
+
+    // listens on the bus at address, 0x3C or 0x3D
+    void attach(TwoWire &wire, uint8_t address);
+    void detach();
+    void onFlush(PanelFlush callback, void *ctx);
+
+    const uint8_t *ram() const { return gddram; }
+    bool displayOn() const { return on; }
+
+    uint32_t commandBytes = 0;
+    uint32_t dataBytes = 0;
+    uint32_t flushes = 0;
+
+private:
+    static void receive(void *ctx, const uint8_t *data, size_t len);
+    void command(uint8_t c);
+    void data(uint8_t d);
+
+    uint8_t gddram[width * pages] = {};
+    bool on = false;
+    uint8_t mode = 2; // 0 horizontal, 1 vertical, 2 page (reset default)
+    uint8_t col0 = 0, col1 = width - 1, page0 = 0, page1 = pages - 1;
+    uint8_t col = 0, page = 0;
+
+    uint8_t pending = 0; // command waiting for its arguments
+    uint8_t argsLeft = 0;
+    uint8_t args[6];
+    uint8_t argCount = 0;
+
+    PanelFlush flushed = nullptr;
+    void *flushedCtx = nullptr;
+
+    TwoWire *bus = nullptr;
+    uint8_t address = 0;
+};
+
+#endif // SSD1306PANEL_H
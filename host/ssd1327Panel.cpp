@@ -0,0 +1,143 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: ssd1327Panel.cpp
+//
+// Description:
+//
+// SSD1327 command/data decoder of the host build, see ssd1327Panel.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "ssd1327Panel.h"
+
+// arguments following each multi byte command of the SSD1327
+static uint8_t panelArgCount(uint8_t c)
+{
+    switch (c)
+    {
+    case 0x81: // contrast
+    case 0xA0: // remap
+    case 0xA1: // start line
+    case 0xA2: // display offset
+    case 0xA8: // multiplex ratio
+    case 0xAB: // function selection A
+    case 0xB1: // phase length
+    case 0xB3: // clock divide
+    case 0xB6: // second pre-charge
+    case 0xBC: // pre-charge voltage
+    case 0xBE: // VCOMH
+    case 0xD5: // function selection B
+        return 1;
+    case 0x15: // column address window
+    case 0x75: // row address window
+        return 2;
+    case 0xB8: // gray scale table
+        return 15;
+    }
+    return 0;
+}
+
+void SSD1327Panel::attach(TwoWire &wire, uint8_t address)
+{
+    detach();
+    bus = &wire;
+    this->address = address;
+    wire.attach(address, receive, this);
+}
+
+void SSD1327Panel::detach()
+{
+    if (bus)
+    {
+        bus->attach(address, nullptr, nullptr);
+        bus = nullptr;
+    }
+}
+
+uint8_t SSD1327Panel::pixel(uint8_t x, uint8_t y) const
+{
+    uint8_t b = gddram[y * rowBytes + x / 2];
+    return x & 1 ? b & 0x0F : b >> 4;
+}
+
+// first byte is the control byte: 0x00 commands follow, 0x40 data follows
+void SSD1327Panel::receive(void *ctx, const uint8_t *data, size_t len)
+{
+    SSD1327Panel &panel = *(SSD1327Panel *)ctx;
+    if (len == 0)
+    {
+        return;
+    }
+    bool isData = data[0] & 0x40;
+    for (size_t i = 1; i < len; i++)
+    {
+        if (isData)
+        {
+            panel.data(data[i]);
+        }
+        else
+        {
+            panel.command(data[i]);
+        }
+    }
+}
+
+void SSD1327Panel::command(uint8_t c)
+{
+    commandBytes++;
+    if (argsLeft)
+    {
+        args[argCount++] = c;
+        if (--argsLeft)
+        {
+            return;
+        }
+        switch (pending)
+        {
+        case 0x15:
+            col0 = args[0] & 0x3F;
+            col1 = args[1] & 0x3F;
+            col = col0;
+            break;
+        case 0x75:
+            row0 = args[0] & 0x7F;
+            row1 = args[1] & 0x7F;
+            row = row0;
+            break;
+        }
+        return;
+    }
+
+    argsLeft = panelArgCount(c);
+    if (argsLeft)
+    {
+        pending = c;
+        argCount = 0;
+        return;
+    }
+    if (c == 0xAE || c == 0xAF)
+    {
+        on = c == 0xAF;
+    }
+}
+
+void SSD1327Panel::data(uint8_t d)
+{
+    dataBytes++;
+    gddram[row * rowBytes + (col & 0x3F)] = d;
+
+    col = col < col1 ? col + 1 : col0;
+    if (col == col0)
+    {
+        row = row < row1 ? row + 1 : row0;
+        if (row == row0)
+        {
+            flushes++;
+        }
+    }
+}
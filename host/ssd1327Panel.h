@@ -0,0 +1,70 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: ssd1327Panel.h
+//
+// Description:
+//
+// model of the SSD1327 controller (128x128, 4 bit grayscale) on the
+// other end of the host I2C bus, the counterpart of ssd1306Panel.h for
+// grayPanel.h. Decodes the command and data streams into its own 8 KB
+// display RAM: two pixels per byte, the left one in the high nibble.
+//
+// The column (0x15, in pairs of pixels) and row (0x75) windows are
+// applied, data fills the window row by row; a flush is complete when
+// the data pointer wraps back to the start of the window. Other
+// commands are skipped with their arguments.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SSD1327PANEL_H
+#define SSD1327PANEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Wire.h"
+
+class SSD1327Panel
+{
+public:
+    static const uint8_t width = 128;
+    static const uint8_t height = 128;
+    static const uint8_t rowBytes = width / 2;
+
+    // listens on the bus at address, 0x3C or 0x3D
+    void attach(TwoWire &wire, uint8_t address);
+    void detach();
+
+    const uint8_t *ram() const { return gddram; }
+    uint8_t pixel(uint8_t x, uint8_t y) const;
+    bool displayOn() const { return on; }
+
+    uint32_t commandBytes = 0;
+    uint32_t dataBytes = 0;
+    uint32_t flushes = 0;
+
+private:
+    static void receive(void *ctx, const uint8_t *data, size_t len);
+    void command(uint8_t c);
+    void data(uint8_t d);
+
+    uint8_t gddram[rowBytes * height] = {};
+    bool on = false;
+    uint8_t col0 = 0, col1 = rowBytes - 1, row0 = 0, row1 = height - 1;
+    uint8_t col = 0, row = 0;
+
+    uint8_t pending = 0; // command waiting for its arguments
+    uint8_t argsLeft = 0;
+    uint8_t args[16];
+    uint8_t argCount = 0;
+
+    TwoWire *bus = nullptr;
+    uint8_t address = 0;
+};
+
+#endif // SSD1327PANEL_H
@@ -0,0 +1,130 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: traceRecorder.cpp
+//
+// Description:
+//
+// Chrome trace_event writer of traceRecorder.h: complete events ("X")
+// in microseconds, one thread per track of a single process.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include "traceRecorder.h"
+
+#include <string>
+#include <vector>
+
+struct TraceEvent
+{
+    uint8_t track;
+    std::string name;
+    std::string args;
+    double start;
+    double duration;
+};
+
+static const char *const traceTrackNames[] = {"", "player", "i2c", "sd", "i2c1"};
+
+static std::string tracePath;
+static std::vector<TraceEvent> traceEvents;
+static bool traceRecording = false;
+
+bool traceOpen(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "cannot create %s\n", path);
+        return false;
+    }
+    fclose(f);
+    tracePath = path;
+    traceEvents.clear();
+    traceRecording = true;
+    return true;
+}
+
+bool traceActive()
+{
+    return traceRecording;
+}
+
+size_t traceEventCount()
+{
+    return traceEvents.size();
+}
+
+void traceSpan(uint8_t track, const char *name, double start, double duration, const char *args)
+{
+    if (traceRecording)
+    {
+        traceEvents.push_back({track, name, args ? args : "", start, duration});
+    }
+}
+
+static void traceString(FILE *f, const std::string &s)
+{
+    fputc('"', f);
+    for (unsigned char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            fprintf(f, "\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(f, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+bool traceClose()
+{
+    if (!traceRecording)
+    {
+        return true;
+    }
+    traceRecording = false;
+    FILE *f = fopen(tracePath.c_str(), "w");
+    if (!f)
+    {
+        fprintf(stderr, "cannot create %s\n", tracePath.c_str());
+        return false;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"firmware\"}}");
+    for (uint8_t t = TRACE_PLAYER; t <= TRACE_I2C1; t++)
+    {
+        fprintf(f, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}", t,
+                traceTrackNames[t]);
+        fprintf(f, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%u}}",
+                t, t);
+    }
+    for (const TraceEvent &e : traceEvents)
+    {
+        fprintf(f, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", e.track, e.start,
+                e.duration);
+        traceString(f, e.name);
+        if (!e.args.empty())
+        {
+            fprintf(f, ",\"args\":%s", e.args.c_str());
+        }
+        fputc('}', f);
+    }
+    fprintf(f, "\n]}\n");
+    bool ok = !ferror(f);
+    ok &= fclose(f) == 0;
+    traceEvents.clear();
+    return ok;
+}
@@ -0,0 +1,72 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: traceRecorder.h
+//
+// Description:
+//
+// timeline of a host session as Chrome trace_event JSON, which opens
+// in Perfetto (ui.perfetto.dev) and chrome://tracing. Spans go to
+// four tracks:
+//
+//   player  one span per category and per animation, with the load,
+//           decode, compose, caption and flush stages nested in it
+//           (ANIM_TRACE_SCOPE and ANIM_PROFILE_SCOPE of animProfile.h)
+//   i2c     every transmission of the Wire mock, its modelled bus time
+//   i2c1    the same for Wire1, the second controller
+//   sd      every open and read the card model of FS.h charged
+//
+// Timestamps come from hostClockMicros(): the host clock moved on by
+// the modelled bus and card time. The CPU stages run at host speed, so
+// the timeline shows where the player waits on a bus, not how long the
+// ESP32 computes. Nothing is recorded until traceOpen().
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Arduino.h"
+
+enum TraceTrack : uint8_t
+{
+    TRACE_PLAYER = 1,
+    TRACE_I2C = 2,
+    TRACE_SD = 3,
+    TRACE_I2C1 = 4,
+};
+
+// events are kept in memory and written by traceClose()
+bool traceOpen(const char *path);
+// returns false when the file could not be written
+bool traceClose();
+bool traceActive();
+size_t traceEventCount();
+
+// args is the JSON object shown with the span, nullptr for none
+void traceSpan(uint8_t track, const char *name, double start, double duration, const char *args = nullptr);
+
+struct TraceScope
+{
+    uint8_t track;
+    const char *name; // must outlive the scope
+    double start;
+
+    TraceScope(uint8_t track, const char *name) : track(track), name(name), start(hostClockMicros()) {}
+    ~TraceScope()
+    {
+        if (traceActive())
+        {
+            traceSpan(track, name, start, hostClockMicros() - start);
+        }
+    }
+};
+
+#endif // TRACERECORDER_H
@@ -0,0 +1,506 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: animLoader.h
+//
+// Description:
+//
+// reads byte array animation files from the SD card. Files either
+// start with the asset header of assetFormat.h or are the original
+// headerless 48x48 dumps. Small animations are loaded whole, long or
+// large ones are streamed one frame at a time. Delta encoded files
+// are decoded through frameCodec.h; tile encoded files keep their
+// dictionary in RAM and load their index grids like raw frames.
+// Animations linked in with -DANIM_EMBEDDED (assetBlobs.h) are played
+// from flash and never touch the card.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ANIMLOADER_H
+#define ANIMLOADER_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <new>
+
+#include "animations.h"
+#include "asyncLog.h"
+#include "sdStorage.h"
+
+extern FramePack framePack;
+
+// reads the directory of the animation pack and sets up its frame cache
+bool framePackOpen(fs::FS &fs, const char *path, FramePack &pack)
+{
+    pack.open = false;
+    pack.dirData = nullptr;
+
+    pack.file = fs.open(path);
+    if (!pack.file)
+    {
+        return false;
+    }
+
+    uint8_t head[packHeaderSize];
+    uint32_t dirSize = packDirSize(head, pack.file.read(head, sizeof(head)));
+    if (dirSize == 0 || dirSize > pack.file.size())
+    {
+        LOG_WARN("%s is not an animation pack", path);
+        pack.file.close();
+        return false;
+    }
+
+    pack.dirData = new (std::nothrow) uint8_t[dirSize];
+    if (!pack.dirData)
+    {
+        pack.file.close();
+        return false;
+    }
+    pack.file.seek(0);
+    if (pack.file.read(pack.dirData, dirSize) != dirSize || !packParseDir(pack.dirData, dirSize, pack.dir))
+    {
+        LOG_WARN("%s is damaged", path);
+        framePackClose(pack);
+        return false;
+    }
+
+    // slot size is the biggest frame of the pack
+    uint32_t slotBytes = 1;
+    for (uint16_t a = 0; a < pack.dir.animCount; a++)
+    {
+        PackEntry entry;
+        packEntry(pack.dir, a, entry);
+        uint32_t frameBytes = assetMaxFrameBytes(entry.header);
+        slotBytes = frameBytes > slotBytes ? frameBytes : slotBytes;
+    }
+    if (slotBytes > animFrameLimit)
+    {
+        LOG_WARN("%s holds frames of %u bytes, more than %u", path, slotBytes, animFrameLimit);
+        framePackClose(pack);
+        return false;
+    }
+    uint32_t slots = framePackCacheBytes / slotBytes;
+    slots = slots > framePackCacheSlots ? framePackCacheSlots : (slots < 1 ? 1 : slots);
+    if (!frameCacheBegin(pack.cache, slots, slotBytes))
+    {
+        // one slot: every frame read from the card when shown, nothing shared between animations
+        LOG_WARN("Not enough memory for %u cache slots, reading the pack uncached", (unsigned)slots);
+        slots = 1;
+        if (!frameCacheBegin(pack.cache, slots, slotBytes))
+        {
+            LOG_ERROR("Not enough memory for %s, animations read from their own files", path);
+            framePackClose(pack);
+            return false;
+        }
+    }
+
+    pack.open = true;
+    LOG_INFO("Animation pack: %u animations, %u unique frames, %u cache slots",
+             pack.dir.animCount, pack.dir.uniqueCount, (unsigned)slots);
+    return true;
+}; // end framePackOpen function
+
+void framePackClose(FramePack &pack)
+{
+    if (pack.open)
+    {
+        frameCacheEnd(pack.cache);
+    }
+    pack.file.close();
+    delete[] pack.dirData;
+    pack.dirData = nullptr;
+    pack.open = false;
+}; // end framePackClose function
+
+bool animPacked(const AnimDesc &anim)
+{
+    return framePack.open && packFind(framePack.dir, anim.id) >= 0;
+}; // end animPacked function
+
+// hands the delta codec the bytes it asks for, from RAM or from the open file
+static const uint8_t *animDeltaFetch(void *ctx, uint32_t offset, uint32_t len)
+{
+    AnimAsset &asset = *(AnimAsset *)ctx;
+    if ((uint64_t)offset + len > asset.fileSize)
+    {
+        return nullptr;
+    }
+    if (!asset.streaming)
+    {
+        return asset.data + offset;
+    }
+
+    // single window: the codec is done with the previous bytes when it asks for new ones
+    if (len > deltaMaxCodedBytes(asset.frameBytes))
+    {
+        return nullptr;
+    }
+    if (offset != asset.filePos)
+    {
+        asset.file.seek(offset);
+    }
+    if (asset.file.read(asset.data, len) != len)
+    {
+        asset.filePos = 0xFFFFFFFFu;
+        return nullptr;
+    }
+    asset.filePos = offset + len;
+    return asset.data;
+}; // end animDeltaFetch function
+
+// keyframe/delta files keep only the coded bytes and one decoded frame in RAM
+static bool animLoadDelta(const char *fileName, AnimAsset &asset)
+{
+    uint8_t info[deltaInfoSize];
+    if (asset.file.read(info, sizeof(info)) != sizeof(info) || !deltaParseInfo(asset.header, info, sizeof(info), asset.delta) ||
+        !deltaFits(asset.header, asset.delta, asset.fileSize) || assetFrameBytes(asset.header) > animFrameLimit)
+    {
+        LOG_WARN("Damaged delta header in %s", fileName);
+        asset.file.close();
+        return false;
+    }
+
+    asset.frameBytes = assetFrameBytes(asset.header);
+    asset.streaming = asset.fileSize > animLoadLimit;
+    uint32_t bufferBytes = asset.streaming ? deltaMaxCodedBytes(asset.frameBytes) : asset.fileSize;
+
+    asset.decoded = new (std::nothrow) uint8_t[asset.frameBytes];
+    asset.data = new (std::nothrow) uint8_t[bufferBytes];
+    if (!asset.decoded || !asset.data)
+    {
+        LOG_ERROR("Not enough memory for %s", fileName);
+        delete[] asset.decoded;
+        delete[] asset.data;
+        asset.decoded = nullptr;
+        asset.data = nullptr;
+        asset.file.close();
+        return false;
+    }
+
+    asset.cursor.frame = asset.decoded;
+    asset.cursor.frameBytes = asset.frameBytes;
+    deltaReset(asset.cursor);
+    asset.filePos = assetHeaderSize + deltaInfoSize;
+
+    if (!asset.streaming)
+    {
+        asset.file.seek(0);
+        bool ok = asset.file.read(asset.data, asset.fileSize) == asset.fileSize;
+        asset.file.close();
+        if (!ok)
+        {
+            delete[] asset.decoded;
+            delete[] asset.data;
+            asset.decoded = nullptr;
+            asset.data = nullptr;
+            return false;
+        }
+    }
+    return true;
+}; // end animLoadDelta function
+
+// reads the tile dictionary, the index grids are then loaded like raw frames
+static bool animLoadTileDict(const char *fileName, AnimAsset &asset)
+{
+    uint8_t info[tileInfoSize];
+    if (asset.file.read(info, sizeof(info)) != sizeof(info) || !tileParseInfo(asset.header, info, sizeof(info), asset.tiles) ||
+        asset.tiles.framesOffset > asset.fileSize)
+    {
+        LOG_WARN("Damaged tile header in %s", fileName);
+        return false;
+    }
+
+    uint32_t dictBytes = (uint32_t)asset.tiles.tileCount * tileBytes;
+    asset.dict = new (std::nothrow) uint8_t[dictBytes];
+    if (!asset.dict)
+    {
+        LOG_ERROR("Not enough memory for %s", fileName);
+        return false;
+    }
+    if (asset.file.read(asset.dict, dictBytes) != dictBytes)
+    {
+        delete[] asset.dict;
+        asset.dict = nullptr;
+        return false;
+    }
+
+    asset.dataOffset = asset.tiles.framesOffset;
+    asset.frameBytes = asset.tiles.frameBytes;
+    return true;
+}; // end animLoadTileDict function
+
+bool animEmbedded(const AnimDesc &anim)
+{
+    return assetBlobFind(anim) != nullptr;
+}; // end animEmbedded function
+
+// raw files linked into the firmware, the frames are used where they are in flash
+static bool animLoadBlob(const AssetBlob &blob, const AnimDesc &anim, AnimAsset &asset)
+{
+    uint32_t size = blob.end - blob.data;
+    asset.fileSize = size;
+    if (assetParseHeader(blob.data, size, asset.header))
+    {
+        if (asset.header.encoding != ASSET_RAW)
+        {
+            LOG_WARN("Only raw files can be embedded, %s is encoded", anim.id);
+            return false;
+        }
+        asset.dataOffset = assetHeaderSize;
+    }
+    else if (assetHasMagic(blob.data, size))
+    {
+        LOG_WARN("Unsupported asset header in embedded %s", anim.id);
+        return false;
+    }
+    else
+    {
+        asset.header = assetLegacyHeader(anim.width, anim.height, size);
+        asset.dataOffset = 0;
+    }
+
+    asset.frameBytes = assetFrameBytes(asset.header);
+    uint32_t available = asset.frameBytes ? (size - asset.dataOffset) / asset.frameBytes : 0;
+    if (asset.header.frameCount > available)
+    {
+        asset.header.frameCount = available;
+    }
+    asset.blob = blob.data + asset.dataOffset;
+    return asset.header.frameCount > 0;
+}; // end animLoadBlob function
+
+bool loadAnimation(const char *fileName, const AnimDesc &anim, AnimAsset &asset)
+{
+    asset.data = nullptr;
+    asset.decoded = nullptr;
+    asset.dict = nullptr;
+    asset.streaming = false;
+    asset.packed = false;
+    asset.blob = nullptr;
+    asset.header.frameCount = 0;
+
+    // animations linked into the firmware need neither the card nor the heap
+    const AssetBlob *blob = assetBlobFind(anim);
+    if (blob)
+    {
+        return animLoadBlob(*blob, anim, asset);
+    }
+
+    // frames shared with other animations come from the pack and its cache
+    int16_t packed = framePack.open ? packFind(framePack.dir, anim.id) : -1;
+    if (packed >= 0)
+    {
+        packEntry(framePack.dir, packed, asset.entry);
+        asset.header = asset.entry.header;
+        asset.frameBytes = assetFrameBytes(asset.header);
+        asset.fileSize = 0;
+        asset.packed = true;
+        return asset.header.frameCount > 0 && assetMaxFrameBytes(asset.header) <= framePack.cache.slotBytes;
+    }
+
+    if (!storageMount())
+    {
+        LOG_ERROR("SD card initialization failed!");
+        return false;
+    }
+
+    // Open the file
+    asset.file = storageFS().open(fileName);
+    if (!asset.file)
+    {
+        LOG_ERROR("Failed to open file");
+        return false;
+    }
+
+    uint32_t fileSize = asset.file.size();
+    asset.fileSize = fileSize;
+    uint8_t head[assetHeaderSize];
+    size_t headLen = asset.file.read(head, sizeof(head));
+
+    bool described = assetParseHeader(head, headLen, asset.header);
+    if (described && asset.header.encoding == ASSET_DELTA)
+    {
+        asset.dataOffset = assetHeaderSize;
+        return animLoadDelta(fileName, asset);
+    }
+    else if (described && asset.header.encoding == ASSET_TILES)
+    {
+        if (!animLoadTileDict(fileName, asset))
+        {
+            asset.file.close();
+            return false;
+        }
+    }
+    else if (described && (asset.header.encoding == ASSET_RAW || asset.header.encoding == ASSET_GRAY4 ||
+                           assetPlaneCount(asset.header) > 1))
+    {
+        asset.dataOffset = assetHeaderSize;
+        asset.frameBytes = assetFrameBytes(asset.header);
+    }
+    else if (assetHasMagic(head, headLen))
+    {
+        LOG_WARN("Unsupported asset header in %s", fileName);
+        asset.file.close();
+        return false;
+    }
+    else
+    {
+        asset.header = assetLegacyHeader(anim.width, anim.height, fileSize);
+        asset.dataOffset = 0;
+        asset.frameBytes = assetFrameBytes(asset.header);
+    }
+
+    // never trust the header beyond what the file really holds
+    // (nor the geometry of a headerless file, it comes from the registry or the index)
+    uint32_t available = asset.frameBytes ? (fileSize - asset.dataOffset) / asset.frameBytes : 0;
+    if (asset.header.frameCount > available)
+    {
+        asset.header.frameCount = available;
+    }
+    if (asset.header.frameCount == 0)
+    {
+        LOG_WARN("No frames in %s", fileName);
+        asset.file.close();
+        delete[] asset.dict;
+        asset.dict = nullptr;
+        return false;
+    }
+
+    asset.streaming = (uint64_t)asset.header.frameCount * asset.frameBytes > animLoadLimit;
+    uint32_t bufferBytes = asset.streaming ? asset.frameBytes : asset.header.frameCount * asset.frameBytes;
+
+    // Allocate memory for the data
+    asset.data = new (std::nothrow) uint8_t[bufferBytes];
+    if (!asset.data)
+    {
+        LOG_ERROR("Not enough memory for %s", fileName);
+        asset.file.close();
+        delete[] asset.dict;
+        asset.dict = nullptr;
+        return false;
+    }
+
+    // a short read leaves bytes of the heap in the buffer, never drawn
+    asset.file.seek(asset.dataOffset);
+    if (asset.file.read(asset.data, bufferBytes) != bufferBytes)
+    {
+        LOG_ERROR("Failed to read %s", fileName);
+        asset.file.close();
+        asset.streaming = false;
+        delete[] asset.data;
+        asset.data = nullptr;
+        delete[] asset.dict;
+        asset.dict = nullptr;
+        return false;
+    }
+    if (asset.streaming)
+    {
+        // keep the file open, frames are read on demand
+        asset.loadedFrame = 0;
+        return true;
+    }
+
+    // Close the file
+    asset.file.close();
+    return true;
+}; // end loadAnimation function
+
+// reads one unique frame of the pack into a cache slot
+static bool animReadPacked(AnimAsset &asset, uint16_t id, uint8_t *slot)
+{
+    framePack.file.seek(packFrameOffset(framePack.dir, id));
+    if (asset.header.encoding == ASSET_RAW)
+    {
+        return framePack.file.read(slot, asset.frameBytes) == asset.frameBytes;
+    }
+
+    // sparse: the box tells how many cropped bytes follow
+    AssetBox box;
+    if (framePack.file.read(slot, assetBoxSize) != assetBoxSize)
+    {
+        return false;
+    }
+    assetReadBox(slot, box);
+    uint32_t bytes = assetBoxBytes(box);
+    return assetBoxValid(asset.header, box) && framePack.file.read(slot + assetBoxSize, bytes) == bytes;
+}; // end animReadPacked function
+
+// returns the frame, reading it from the card when streaming
+// frame must be below asset.header.frameCount, which loadAnimation() clamped to the file
+// packed sparse frames start with their AssetBox, see assetFormat.h
+// tile encoded frames are the index grid into asset.dict, see tileCodec.h
+const uint8_t *animFrame(AnimAsset &asset, uint32_t frame)
+{
+    if (asset.packed)
+    {
+        uint16_t id = packFrameId(framePack.dir, asset.entry, frame);
+        bool hit;
+        uint8_t *slot = frameCacheGet(framePack.cache, id, hit);
+        if (!hit && !animReadPacked(asset, id, slot))
+        {
+            frameCacheDrop(framePack.cache, id);
+            memset(slot, 0, assetMaxFrameBytes(asset.header)); // shows as an empty frame
+        }
+        return slot;
+    }
+
+    if (asset.blob)
+    {
+        return asset.blob + frame * asset.frameBytes;
+    }
+
+    if (asset.decoded)
+    {
+        // keyframe + at most K-1 deltas, or a single delta when playing in order
+        if (!deltaSeek(asset.header, asset.delta, asset.cursor, frame, animDeltaFetch, &asset))
+        {
+            memset(asset.decoded, 0, asset.frameBytes); // shows as an empty frame
+        }
+        return asset.decoded;
+    }
+
+    if (!asset.streaming)
+    {
+        return &asset.data[frame * asset.frameBytes];
+    }
+
+    if (frame != asset.loadedFrame)
+    {
+        // sequential playback needs no seek, only the wrap around does
+        if (frame != asset.loadedFrame + 1)
+        {
+            asset.file.seek(asset.dataOffset + frame * asset.frameBytes);
+        }
+        asset.loadedFrame = frame;
+        if (asset.file.read(asset.data, asset.frameBytes) != asset.frameBytes)
+        {
+            // file cut or read error: an empty frame, and the next read seeks again
+            memset(asset.data, 0, asset.frameBytes);
+            asset.loadedFrame = asset.header.frameCount;
+        }
+    }
+    return asset.data;
+}; // end animFrame function
+
+void unloadAnimation(AnimAsset &asset)
+{
+    if (asset.streaming)
+    {
+        asset.file.close();
+    }
+
+    // Don't forget to delete the data array to free up memory
+    delete[] asset.data;
+    asset.data = nullptr;
+    delete[] asset.decoded;
+    asset.decoded = nullptr;
+    delete[] asset.dict;
+    asset.dict = nullptr;
+}; // end unloadAnimation function
+
+#endif // ANIMLOADER_H
@@ -0,0 +1,578 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: animPlayer.h
+//
+// Description:
+//
+// plays the byte array animations listed in animRegistry.h, either a
+// whole category with its caption or a single animation on its own.
+// Replaces the per-category byteArrayAnim_*.h files which all carried
+// the same loops and one wrapper function per animation.
+//
+// The caption is drawn once per animation into the u8g2 buffer and
+// merged into the Adafruit buffer (both use the SSD1306 page layout).
+// Each frame then only clears, redraws and flushes the union of the
+// previous and the current frame box, the full 1 KB buffer is sent
+// once per animation. Row major frames are put into the buffer by the
+// 8x8 bit transpose of bitTranspose.h rather than drawBitmap().
+//
+// Text comes from the glyph atlas (glyphAtlas.h) filled by
+// animAtlasBegin() at boot with the characters of the captions and
+// of animStatusChars; a caption with any other character is drawn by
+// u8g2. The formatter set with animOnStatus() gives a short text
+// (battery level, temperature) drawn right of the animation area on
+// every frame and flushed when it changed.
+//
+// Everything is drawn on an AnimPanel: an Adafruit_SSD1306 buffer with
+// the bus and address it is flushed to. animMainPanel is the global
+// display at SCREEN_I2C_ADDR on Wire, its caption layer is the u8g2
+// buffer. A deferred panel only queues the regions to flush, the
+// display manager (displayManager.h) sends them on its bus later.
+//
+// Loading, decoding, drawing, caption and flush are timed per stage
+// when built with ANIM_PROFILE, and traced per category and animation
+// in the host build, see animProfile.h. Memory is sampled
+// once per animation while it is loaded, see memTelemetry.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ANIMPLAYER_H
+#define ANIMPLAYER_H
+
+// install ibraries
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+
+#include "animations.h"
+#include "animProfile.h"
+#include "animRegistry.h"
+#include "asyncLog.h"
+#include "assetIndex.h"
+#include "bitTranspose.h"
+#include "frameRegion.h"
+#include "glyphAtlas.h"
+#include "memTelemetry.h"
+#include "oledFlush.h"
+
+#ifndef SCREEN_I2C_ADDR
+#define SCREEN_I2C_ADDR 0x3C
+#endif
+
+extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
+extern Adafruit_SSD1306 display;
+extern AssetIndex assetIndex;
+
+static bool animFirstFrameShown = false;
+
+// status text of the frame, false when there is none
+typedef bool (*AnimStatusFormatter)(const AnimDesc &anim, uint32_t frame, char *text, size_t size);
+
+static const uint8_t animStatusMax = 12;
+static const int16_t animStatusX = 52;
+// characters the status formatter may use, besides those of the captions
+static const char *animStatusChars = "0123456789 %.,:+-CFV";
+
+static GlyphAtlas animAtlas;
+static AnimStatusFormatter animStatusFormatter = nullptr;
+
+static const char *animCategoryName(AnimCategory category)
+{
+    switch (category)
+    {
+    case AnimCategory::Meteo:
+        return "Meteo";
+    case AnimCategory::Position:
+        return "Position";
+    case AnimCategory::Battery:
+        return "Battery";
+    case AnimCategory::System:
+        return "System";
+    case AnimCategory::Icons:
+        return "Icons";
+    }
+    return "";
+}; // end animCategoryName function
+
+// the 48x48 area under the caption, anything taller is shown full screen
+static const int16_t animAreaTop = 15;
+static const int16_t animAreaSize = 48;
+
+// regions a deferred panel holds until they are flushed, more are merged into the last one
+static const uint8_t animQueueMax = 3;
+
+// a panel the player draws on
+struct AnimPanel
+{
+    Adafruit_SSD1306 *oled; // frame buffer, the same size as the u8g2 one
+    TwoWire *wire;
+    uint8_t address;
+    uint8_t *caption; // caption layer in the page layout, nullptr for the u8g2 buffer
+    bool deferred;    // regions queued for the display manager instead of flushed
+    uint8_t queued;
+    FrameRect queue[animQueueMax];
+};
+
+static AnimPanel animMainPanel = {&display, &Wire, SCREEN_I2C_ADDR, nullptr, false, 0, {}};
+
+// what is on the panel while an animation plays
+struct AnimScreen
+{
+    AnimPanel *panel;
+    const AnimDesc *anim;
+    int16_t x; // origin of the animation
+    int16_t y;
+    bool caption;
+    bool status;                   // room for the status text right of the animation
+    char statusText[animStatusMax]; // on the panel
+    FrameRect drawn;               // box of the previous frame
+};
+
+// formatter of the status text, nullptr for none
+static void animOnStatus(AnimStatusFormatter formatter)
+{
+    animStatusFormatter = formatter;
+}; // end animOnStatus function
+
+// reserves the characters of text not yet in the atlas, at their u8g2 advance
+static void animAtlasReserve(const char *text)
+{
+    char glyph[2] = {0, 0};
+    for (; *text; text++)
+    {
+        if (glyphAtlasSlot(animAtlas, *text) == glyphNone)
+        {
+            glyph[0] = *text;
+            u8g2.clearBuffer();
+            glyphAtlasReserve(animAtlas, *text, u8g2.drawStr(0, animAtlas.ascent, glyph));
+        }
+    }
+}; // end animAtlasReserve function
+
+// renders the characters of the captions and of the status text with the current u8g2 font, once at boot
+static bool animAtlasBegin(void)
+{
+    MEM_SCOPE("caption");
+    glyphAtlasFree(animAtlas);
+    if (!glyphAtlasBegin(animAtlas, u8g2.getFontAscent(), -u8g2.getFontDescent()))
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        animAtlasReserve(animRegistry[i].name);
+    }
+    animAtlasReserve(animStatusChars);
+    if (!glyphAtlasAllocate(animAtlas))
+    {
+        return false;
+    }
+
+    // each glyph drawn with its top on row 0, then copied into the strip
+    char glyph[2] = {0, 0};
+    for (uint8_t c = glyphFirst; c <= glyphLast; c++)
+    {
+        if (glyphAtlasSlot(animAtlas, c) != glyphNone)
+        {
+            glyph[0] = c;
+            u8g2.clearBuffer();
+            u8g2.drawStr(0, animAtlas.ascent, glyph);
+            glyphAtlasCapture(animAtlas, c, u8g2.getBufferPtr(), u8g2.getDisplayWidth(), 0);
+        }
+    }
+    u8g2.clearBuffer();
+    LOG_INFO("Glyph atlas: %u characters, %u bytes", animAtlas.count, animAtlas.pages * animAtlas.columns);
+    return true;
+}; // end animAtlasBegin function
+
+static bool animFullScreen(const AssetHeader &header)
+{
+    return header.height > animAreaSize || header.width > animAreaSize;
+}; // end animFullScreen function
+
+// top left corner of the animation, smaller icons are centered in the area
+static void animOrigin(Adafruit_SSD1306 &oled, const AssetHeader &header, int16_t &x, int16_t &y)
+{
+    if (animFullScreen(header))
+    {
+        x = (oled.width() - (int16_t)header.width) / 2;
+        y = (oled.height() - (int16_t)header.height) / 2;
+    }
+    else
+    {
+        x = (animAreaSize - (int16_t)header.width) / 2;
+        y = animAreaTop + (animAreaSize - (int16_t)header.height) / 2;
+    }
+}; // end animOrigin function
+
+// sets the pixels drawBitmap(x, y, bitmap, width, height, 1) sets, transposed to the page layout 8x8 at a time
+static void animBlit(Adafruit_SSD1306 &oled, int16_t x, int16_t y, const uint8_t *bitmap, uint16_t width,
+                     uint16_t height, uint16_t stride)
+{
+    bitBlitRows(bitmap, width, height, stride, oled.getBuffer(), oled.width(), oled.height(), x, y);
+}; // end animBlit function
+
+static uint8_t *animCaptionLayer(AnimPanel &panel)
+{
+    return panel.caption ? panel.caption : u8g2.getBufferPtr();
+}; // end animCaptionLayer function
+
+// ORs the caption layer of the panel into the pages of the region
+static void animComposeCaption(AnimPanel &panel, const FrameRect &region)
+{
+    Adafruit_SSD1306 &oled = *panel.oled;
+    FrameRect r = frameRectClip(region, oled.width(), oled.height());
+    if (frameRectIsEmpty(r))
+    {
+        return;
+    }
+
+    const uint8_t *caption = animCaptionLayer(panel);
+    uint8_t *buffer = oled.getBuffer();
+    for (int16_t page = r.y0 / 8; page <= (r.y1 - 1) / 8; page++)
+    {
+        for (int16_t col = r.x0; col < r.x1; col++)
+        {
+            buffer[page * oled.width() + col] |= caption[page * oled.width() + col];
+        }
+    }
+}; // end animComposeCaption function
+
+// keeps the region for the display manager, merged into the last one when the queue is full
+static void animQueue(AnimPanel &panel, const FrameRect &region)
+{
+    if (frameRectIsEmpty(region))
+    {
+        return;
+    }
+    if (panel.queued < animQueueMax)
+    {
+        panel.queue[panel.queued++] = region;
+    }
+    else
+    {
+        panel.queue[animQueueMax - 1] = frameRectUnion(panel.queue[animQueueMax - 1], region);
+    }
+}; // end animQueue function
+
+static void animShow(AnimPanel &panel, const FrameRect &region)
+{
+    if (panel.deferred)
+    {
+        animQueue(panel, region);
+        return;
+    }
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+        oledFlushRegion(*panel.oled, *panel.wire, panel.address, region);
+    }
+    if (!animFirstFrameShown)
+    {
+        animFirstFrameShown = true;
+        LOG_INFO("First frame shown %u ms after boot", (unsigned)millis());
+    }
+}; // end animShow function
+
+// clears the panel and shows the caption, sent in full once per animation
+static void animBeginScreen(const AnimDesc &anim, const AssetHeader &header, bool caption, AnimScreen &screen,
+                            AnimPanel &panel = animMainPanel)
+{
+    Adafruit_SSD1306 &oled = *panel.oled;
+    animOrigin(oled, header, screen.x, screen.y);
+    screen.panel = &panel;
+    screen.anim = &anim;
+    screen.caption = caption && !animFullScreen(header);
+    screen.status = !animFullScreen(header);
+    screen.statusText[0] = 0;
+    screen.drawn = frameRectEmpty;
+
+    oled.clearDisplay();
+    if (screen.caption)
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_CAPTION);
+        MEM_SCOPE("caption");
+        uint8_t *layer = animCaptionLayer(panel);
+        size_t layerBytes = (size_t)oled.width() * oled.height() / 8;
+        // pre-rendered glyphs when the atlas holds them all, u8g2 decodes the font otherwise
+        if (glyphAtlasCovers(animAtlas, anim.name))
+        {
+            memset(layer, 0, layerBytes);
+            glyphAtlasDraw(animAtlas, anim.name, layer, oled.width(), oled.height(), 3, oled_LineH * 1 + 2);
+        }
+        else
+        {
+            u8g2.clearBuffer();
+            u8g2.drawStr(3, oled_LineH * 1 + 2, anim.name);
+            if (layer != u8g2.getBufferPtr())
+            {
+                memcpy(layer, u8g2.getBufferPtr(), layerBytes);
+            }
+        }
+        animComposeCaption(panel, {0, 0, oled.width(), oled.height()});
+    }
+    if (panel.deferred)
+    {
+        animQueue(panel, {0, 0, oled.width(), oled.height()});
+        return;
+    }
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+        oled.display();
+    }
+}; // end animBeginScreen function
+
+// draws the status text of the frame when it changed, returns the box to flush
+static FrameRect animDrawStatus(AnimScreen &screen, uint32_t frame)
+{
+    char text[animStatusMax] = "";
+    if (!screen.status || !animStatusFormatter || !animStatusFormatter(*screen.anim, frame, text, sizeof(text)))
+    {
+        text[0] = 0;
+    }
+    text[animStatusMax - 1] = 0;
+    if (!strcmp(text, screen.statusText))
+    {
+        return frameRectEmpty;
+    }
+
+    // centered on the animation area, as high as the glyphs of the atlas
+    Adafruit_SSD1306 &oled = *screen.panel->oled;
+    int16_t baseline = animAreaTop + animAreaSize / 2 + animAtlas.ascent / 2;
+    int16_t top = baseline - animAtlas.ascent;
+    FrameRect box = frameRectClip({animStatusX, top, oled.width(), (int16_t)(top + animAtlas.pages * 8)},
+                                  oled.width(), oled.height());
+    if (!frameRectIsEmpty(box))
+    {
+        oled.fillRect(box.x0, box.y0, box.x1 - box.x0, box.y1 - box.y0, 0);
+    }
+    glyphAtlasDraw(animAtlas, text, oled.getBuffer(), oled.width(), oled.height(), animStatusX, baseline);
+    strcpy(screen.statusText, text);
+    return box;
+}; // end animDrawStatus function
+
+// redraws only what changed between the previous frame and this one
+static void animDrawFrame(AnimScreen &screen, AnimAsset &asset, uint32_t frame)
+{
+    AnimPanel &panel = *screen.panel;
+    Adafruit_SSD1306 &oled = *panel.oled;
+    const uint8_t *bits;
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_DECODE);
+        bits = animFrame(asset, frame);
+    }
+    FrameRect box;
+    uint16_t stride;
+
+    if (asset.header.encoding == ASSET_SPARSE)
+    {
+        AssetBox crop;
+        assetReadBox(bits, crop);
+        bits += assetBoxSize;
+        stride = assetMinStride(crop.width);
+        box = {(int16_t)(screen.x + crop.x), (int16_t)(screen.y + crop.y),
+               (int16_t)(screen.x + crop.x + crop.width), (int16_t)(screen.y + crop.y + crop.height)};
+    }
+    else
+    {
+        stride = asset.header.stride;
+        box = {screen.x, screen.y, (int16_t)(screen.x + asset.header.width), (int16_t)(screen.y + asset.header.height)};
+    }
+
+    FrameRect dirty = frameRectClip(frameRectUnion(screen.drawn, box), oled.width(), oled.height());
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_COMPOSE);
+        if (!frameRectIsEmpty(dirty))
+        {
+            oled.fillRect(dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0, 0);
+        }
+        if (asset.header.encoding == ASSET_TILES)
+        {
+            // straight into the page buffer, 8 bytes per tile
+            tileBlit(asset.tiles, asset.dict, bits, oled.getBuffer(), oled.width(), oled.height(), box.x0, box.y0);
+        }
+        else if (!frameRectIsEmpty(box))
+        {
+            animBlit(oled, box.x0, box.y0, bits, box.x1 - box.x0, box.y1 - box.y0, stride);
+        }
+    }
+    // frame and caption are both ORed in, the caption can come last
+    if (screen.caption && !frameRectIsEmpty(dirty))
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_CAPTION);
+        animComposeCaption(panel, dirty);
+    }
+    // flushed on its own, the union with the frame box would span the whole width
+    FrameRect status = frameRectEmpty;
+    if (screen.status && (animStatusFormatter || screen.statusText[0]))
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_CAPTION);
+        status = animDrawStatus(screen, frame);
+    }
+
+    animShow(panel, dirty);
+    if (!frameRectIsEmpty(status))
+    {
+        animShow(panel, status);
+    }
+    screen.drawn = box;
+}; // end animDrawFrame function
+
+// what the caller of animOpen() can play besides 1 bit frames
+static const uint8_t animAcceptGray = 0x01;   // ASSET_GRAY4, see displayBackend.h
+static const uint8_t animAcceptPlanes = 0x02; // ASSET_PLANES2 and 3, see planePlayer.h
+
+// loads an animation from flash, the pack or the asset index, skips files missing from the card
+// and the encodings the caller did not accept
+static bool animOpen(const AnimDesc &anim, AnimAsset &asset, uint8_t accept = 0)
+{
+    ANIM_PROFILE_SCOPE(PROFILE_LOAD);
+    MEM_SCOPE("load");
+    if (animEmbedded(anim) || animPacked(anim))
+    {
+        return loadAnimation(anim.path, anim, asset);
+    }
+
+    const AssetIndexEntry *entry = assetIndexFind(assetIndex, anim.path);
+    if (!entry)
+    {
+        LOG_WARN("%s is not on the SD card", anim.path);
+        return false;
+    }
+    if (!loadAnimation(anim.path, anim, asset))
+    {
+        assetIndexInvalidate(storageFS());
+        return false;
+    }
+    if (asset.fileSize != entry->size)
+    {
+        // the file changed behind the index, play it but rescan on the next boot
+        LOG_WARN("%s changed since it was indexed", anim.path);
+        assetIndexInvalidate(storageFS());
+    }
+    if (asset.header.encoding == ASSET_GRAY4 && !(accept & animAcceptGray))
+    {
+        LOG_WARN("%s is a 4 bit grayscale asset, not for a monochrome panel", anim.path);
+        unloadAnimation(asset);
+        return false;
+    }
+    if (assetPlaneCount(asset.header) > 1 && !(accept & animAcceptPlanes))
+    {
+        LOG_WARN("%s holds bit-planes, played by planePlay() only", anim.path);
+        unloadAnimation(asset);
+        return false;
+    }
+    return true;
+}; // end animOpen function
+
+// plays every animation of the category with its caption
+void byteArray_Anim(AnimCategory category)
+{
+    ANIM_TRACE_SCOPE(animCategoryName(category));
+    LOG_INFO("Starting %s byte Array loop", animCategoryName(category));
+
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        const AnimDesc &anim = animRegistry[i];
+        if (anim.category != category)
+        {
+            continue;
+        }
+        ANIM_TRACE_SCOPE(anim.id);
+
+        AnimAsset asset;
+        if (!animOpen(anim, asset))
+        {
+            continue;
+        }
+
+        AnimScreen screen;
+        animBeginScreen(anim, asset.header, true, screen);
+        memSample(anim.id);
+
+        uint32_t frame = 0;
+        uint8_t effecttime = 30;
+
+        while (effecttime > 0)
+        {
+            animDrawFrame(screen, asset, frame);
+            frame = (frame + 1) % asset.header.frameCount;
+            effecttime--;
+        }
+
+        unloadAnimation(asset);
+    }
+
+    LOG_INFO("ending loop");
+}; // end byte Array Animation Loop function
+
+// plays a single animation once, without caption
+void byteArray_Display(uint8_t i)
+{
+    const AnimDesc &anim = animRegistry[i];
+    ANIM_TRACE_SCOPE(anim.id);
+    AnimAsset asset;
+
+    if (!animOpen(anim, asset))
+    {
+        return;
+    }
+
+    AnimScreen screen;
+    animBeginScreen(anim, asset.header, false, screen);
+    memSample(anim.id);
+
+    for (uint32_t frame = 0; frame < asset.header.frameCount; frame++)
+    {
+        animDrawFrame(screen, asset, frame);
+    }
+
+    unloadAnimation(asset);
+
+}; // end byte Array Animation Display function
+
+// plays the animations found on the card that are not listed in animRegistry.h
+void byteArray_Unlisted(void)
+{
+    for (uint16_t i = 0; i < assetIndex.count; i++)
+    {
+        const AssetIndexEntry &entry = assetIndex.entries[i];
+        bool listed = false;
+        for (uint8_t j = 0; j < animTotal && !listed; j++)
+        {
+            listed = strcmp(animRegistry[j].path, entry.path) == 0;
+        }
+        // bit-planes are cycled by byteArray_Planes(), see planePlayer.h
+        if (listed || entry.encoding == ASSET_PLANES2 || entry.encoding == ASSET_PLANES3)
+        {
+            continue;
+        }
+
+        // caption is the file name, geometry comes from the index
+        const AnimDesc anim = {AnimCategory::Icons, entry.path + 1, entry.path, entry.path + 1,
+                               entry.width, entry.height, entry.frameCount};
+        ANIM_TRACE_SCOPE(anim.id);
+        AnimAsset asset;
+        if (!animOpen(anim, asset))
+        {
+            continue;
+        }
+
+        AnimScreen screen;
+        animBeginScreen(anim, asset.header, true, screen);
+        memSample(anim.id);
+        for (uint32_t frame = 0; frame < asset.header.frameCount; frame++)
+        {
+            animDrawFrame(screen, asset, frame);
+        }
+
+        unloadAnimation(asset);
+    }
+}; // end byte Array Unlisted function
+
+#endif // ANIMPLAYER_H
@@ -0,0 +1,112 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: animProfile.h
+//
+// Description:
+//
+// stage timers of the player, enabled by building with -DANIM_PROFILE
+// (see platformio.ini). ANIM_PROFILE_SCOPE(stage) times the rest of
+// the enclosing block with the CPU cycle counter and adds it to the
+// histogram of the stage (profileRecord.h): two counter reads and a
+// bucket increment, no Serial output on the hot path.
+//
+// Sending 'p' over Serial asks for the histograms: animProfilePoll()
+// answers with one binary record and starts over. tools/profdump
+// prints p50/p95/p99 per stage from a capture of the Serial output.
+//
+// Without ANIM_PROFILE the macros are empty and nothing is compiled in.
+//
+// The host build defines ANIM_TRACE: every stage and every
+// ANIM_TRACE_SCOPE(name) (a category, an animation) is also a span of
+// the session trace of host/traceRecorder.h. The firmware never sets it.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ANIMPROFILE_H
+#define ANIMPROFILE_H
+
+#define ANIM_PROFILE_JOIN2(a, b) a##b
+#define ANIM_PROFILE_JOIN(a, b) ANIM_PROFILE_JOIN2(a, b)
+
+#if defined(ANIM_PROFILE) || defined(ANIM_TRACE)
+#include "profileRecord.h"
+#endif
+
+#ifdef ANIM_TRACE
+#include "traceRecorder.h"
+
+#define ANIM_TRACE_SCOPE(name) TraceScope ANIM_PROFILE_JOIN(animTraceScope, __LINE__)(TRACE_PLAYER, name)
+#else
+#define ANIM_TRACE_SCOPE(name)
+#endif // ANIM_TRACE
+
+#ifdef ANIM_PROFILE
+
+#include <Arduino.h>
+#include <new>
+
+#include "asyncLog.h"
+
+static ProfileHistogram animProfileStages[profileStageCount];
+
+struct AnimProfileScope
+{
+    uint8_t stage;
+    uint32_t start;
+
+    AnimProfileScope(uint8_t stage) : stage(stage), start(ESP.getCycleCount()) {}
+    ~AnimProfileScope() { profileAdd(animProfileStages[stage], ESP.getCycleCount() - start); }
+};
+
+#define ANIM_PROFILE_SCOPE(stage)                                              \
+    AnimProfileScope ANIM_PROFILE_JOIN(animProfileScope, __LINE__)(stage); \
+    ANIM_TRACE_SCOPE(profileStageNames[stage])
+
+// sends the histograms as one binary record and clears them
+// without memory for the record nothing is sent, the histograms are kept for the next 'p'
+static void animProfileReport(void)
+{
+    uint8_t *record = new (std::nothrow) uint8_t[profileRecordMaxBytes];
+    if (!record)
+    {
+        LOG_ERROR("Profile: no memory for the %u byte record", (unsigned)profileRecordMaxBytes);
+        return;
+    }
+    size_t size = profileEncode(animProfileStages, ESP.getCpuFreqMHz(), record);
+    // binary: no log line may land in the middle of it
+    logPause();
+    Serial.write(record, size);
+    logResume();
+    delete[] record;
+
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        profileClear(animProfileStages[s]);
+    }
+}; // end animProfileReport function
+
+// answers a 'p' received over Serial, other input is left alone
+static void animProfilePoll(void)
+{
+    if (Serial.available() && Serial.peek() == 'p')
+    {
+        Serial.read();
+        animProfileReport();
+    }
+}; // end animProfilePoll function
+
+#define ANIM_PROFILE_POLL() animProfilePoll()
+
+#else
+
+#define ANIM_PROFILE_SCOPE(stage) ANIM_TRACE_SCOPE(profileStageNames[stage])
+#define ANIM_PROFILE_POLL()
+
+#endif // ANIM_PROFILE
+
+#endif // ANIMPROFILE_H
@@ -0,0 +1,210 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: animRegistry.h
+//
+// Description:
+//
+// single compile-time table describing every byte array animation
+// stored on the SD card. Replaces the five per-category Frame arrays
+// and their hand-kept totalarrays_* counts.
+//
+// Adding an animation = adding one line to ANIM_REGISTRY below.
+//
+// The files used to be named in 8.3 form on the card (/by_batLv.bin,
+// /by_cldWx.bin, ...). They are now named after their id like in the
+// files folder; cards written for the first releases are renamed the
+// first time the card is scanned, see assetIndexMigrate().
+//
+// Lookups by id are resolved by a FNV-1a hash and a binary search
+// over a table sorted at compile time, so no heap and no string
+// compares are needed. Use ANIM("id") to resolve an id at compile
+// time (unknown ids fail the build).
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ANIMREGISTRY_H
+#define ANIMREGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <type_traits>
+
+enum class AnimCategory : uint8_t
+{
+    Meteo,
+    Position,
+    Battery,
+    System,
+    Icons,
+};
+
+struct AnimDesc
+{
+    AnimCategory category;
+    const char *id;   // lookup key, matches the file name in the files folder
+    const char *path; // location of the byte array file on the SD card (same name as in the files folder)
+    const char *name; // caption displayed above the animation
+    uint16_t width;       // geometry used for headerless files,
+    uint16_t height;      // files with an asset header describe themselves
+    uint32_t frameCounts;
+    const char *legacyPath; // 8.3 name of the first releases, renamed to path by assetIndexMigrate()
+};
+
+// the registry must stay a plain constant table in flash (.rodata):
+// no constructors to run before setup() and no heap for the captions
+static_assert(std::is_trivially_copyable<AnimDesc>::value, "AnimDesc must stay trivially copyable");
+static_assert(std::is_trivially_destructible<AnimDesc>::value, "AnimDesc must stay trivially destructible");
+
+// every animation: X(category, id, caption, width, height, frameCounts, legacyPath)
+// the card path is the id, see AnimDesc; assetBlobs.h builds its table from the same list
+// NOTE: keep entries grouped by category, the playlist plays them in this order
+#define ANIM_REGISTRY(X)                                                                     \
+    /* Meteo */                                                                              \
+    X(Meteo, cloudyWeather, "Cloudy Weather", 48, 48, 28, "/by_cldWx.bin")                   \
+    X(Meteo, lightSnowWeather, "Light Snow Weather", 48, 48, 28, "/by_lSnWx.bin")            \
+    X(Meteo, lightningWeather, "Lightning Weather", 48, 48, 28, "/by_lngWx.bin")             \
+    X(Meteo, lightningboltWeather, "Lightning Bolt Weather", 48, 48, 28, "/by_bltWx.bin")    \
+    X(Meteo, rainyWeather, "Rainy Weather", 48, 48, 28, "/by_rngWx.bin")                     \
+    X(Meteo, snowStormWeather, "Snowstorm Weather", 48, 48, 28, "/by_snoWx.bin")             \
+    X(Meteo, stormyWeather, "Stormy Weather", 48, 48, 28, "/by_stoWx.bin")                   \
+    X(Meteo, sunWeather, "Sun Weather", 48, 48, 28, "/by_sunWx.bin")                         \
+    X(Meteo, temperatureWeather, "Temperature Weather", 48, 48, 28, "/by_tmpWx.bin")         \
+    X(Meteo, torrentialRainWeather, "Torrential Rain Weather", 48, 48, 28, "/by_tRnWx.bin")  \
+    X(Meteo, windyWeather, "Windy Weather", 48, 48, 28, "/by_wndWx.bin")                     \
+    /* Position */                                                                           \
+    X(Position, uninstallingUpdates, "Uninstalling Updates", 48, 48, 28, "/by_unUpd.bin")    \
+    X(Position, installingUpdates, "Installing Updates", 48, 48, 28, "/by_insUpd.bin")       \
+    X(Position, upload, "Upload", 48, 48, 28, "/by_upld.bin")                                \
+    X(Position, download, "Download", 48, 48, 28, "/by_dwnld.bin")                           \
+    X(Position, downArrow, "Down Arrow", 48, 48, 28, "/by_dwnAr.bin")                        \
+    /* Battery */                                                                            \
+    X(Battery, batteryLevel, "Battery Level", 48, 48, 28, "/by_batLv.bin")                   \
+    X(Battery, chargedBattery, "Charged Battery", 48, 48, 28, "/by_chBat.bin")               \
+    X(Battery, chargingBattery, "Charging Battery", 48, 48, 28, "/by_cgBat.bin")             \
+    X(Battery, lowBattery, "Low Battery", 48, 48, 28, "/by_lwBat.bin")                       \
+    /* System */                                                                             \
+    X(System, bell, "Bell", 48, 48, 28, "/by_bell.bin")                                      \
+    X(System, checkmarkOK, "Checkmark OK", 48, 48, 28, "/by_chkOK.bin")                      \
+    X(System, clockspin, "Spinning Clock", 48, 48, 28, "/by_clksp.bin")                      \
+    X(System, globe, "Globe", 48, 48, 28, "/by_globe.bin")                                   \
+    X(System, home, "Home", 48, 48, 28, "/by_home.bin")                                      \
+    X(System, hourglass, "Hourglass", 48, 48, 28, "/by_hrgl.bin")                            \
+    X(System, noConnection, "No Connection", 48, 48, 28, "/by_noCon.bin")                    \
+    X(System, sound, "Sound", 48, 48, 28, "/by_snd.bin")                                     \
+    X(System, wifisearch, "WIFI Search", 48, 48, 28, "/by_wifish.bin")                       \
+    X(System, gear, "Gear", 48, 48, 28, "/by_gear.bin")                                      \
+    X(System, gears, "Gears", 48, 48, 28, "/by_gears.bin")                                   \
+    X(System, settings, "Settings", 48, 48, 28, "/by_setng.bin")                             \
+    /* Icons */                                                                              \
+    X(Icons, heartbeat, "Heartbeat", 48, 48, 28, "/by_hrtbt.bin")                            \
+    X(Icons, aircraft, "Aircraft", 48, 48, 28, "/by_acft.bin")                               \
+    X(Icons, event, "Event", 48, 48, 28, "/by_event.bin")                                    \
+    X(Icons, plot, "Plot", 48, 48, 28, "/by_plot.bin")                                       \
+    X(Icons, toggle, "Toggle", 48, 48, 28, "/by_toggl.bin")                                  \
+    X(Icons, openLetter, "Open Letter", 48, 48, 28, "/by_opLet.bin")                         \
+    X(Icons, phoneringing, "Phone Ringing", 48, 48, 28, "/by_phrng.bin")
+
+#define ANIM_REGISTRY_ENTRY(category, id, name, width, height, frameCounts, legacyPath) \
+    {AnimCategory::category, #id, "/" #id ".bin", name, width, height, frameCounts, legacyPath},
+
+constexpr AnimDesc animRegistry[] = {ANIM_REGISTRY(ANIM_REGISTRY_ENTRY)};
+
+constexpr uint8_t animTotal = sizeof(animRegistry) / sizeof(animRegistry[0]);
+
+// FNV-1a, usable both at compile time and at run time
+constexpr uint32_t animHash(const char *s, uint32_t h = 2166136261u)
+{
+    return *s ? animHash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+struct AnimKey
+{
+    uint32_t hash;
+    uint8_t index;
+};
+
+// builds the id hash table once, at compile time, sorted for binary search
+constexpr std::array<AnimKey, animTotal> animBuildKeys()
+{
+    std::array<AnimKey, animTotal> keys{};
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        AnimKey k{animHash(animRegistry[i].id), i};
+        uint8_t j = i;
+        while (j > 0 && keys[j - 1].hash > k.hash)
+        {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = k;
+    }
+    return keys;
+}
+
+constexpr std::array<AnimKey, animTotal> animKeys = animBuildKeys();
+
+constexpr bool animKeysUnique()
+{
+    for (uint8_t i = 1; i < animTotal; i++)
+    {
+        if (animKeys[i - 1].hash == animKeys[i].hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(animKeysUnique(), "two animation ids hash to the same value, rename one of them");
+
+// returns the registry index for the id, or -1 when it is not registered
+// NOTE: ids are not compared, an unregistered id can (very rarely) collide
+constexpr int16_t animIndex(const char *id)
+{
+    const uint32_t h = animHash(id);
+    uint8_t lo = 0;
+    uint8_t hi = animTotal;
+    while (lo < hi)
+    {
+        const uint8_t mid = (lo + hi) / 2;
+        if (animKeys[mid].hash < h)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo < animTotal && animKeys[lo].hash == h) ? animKeys[lo].index : -1;
+}
+
+template <int16_t I>
+constexpr uint8_t animChecked()
+{
+    static_assert(I >= 0, "unknown animation id");
+    return (uint8_t)I;
+}
+
+// compile-time lookup, e.g. byteArray_Display(ANIM("heartbeat"));
+#define ANIM(id) animChecked<animIndex(id)>()
+
+constexpr uint8_t animCount(AnimCategory category)
+{
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        if (animRegistry[i].category == category)
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+#endif // ANIMREGISTRY_H
@@ -6,19 +6,68 @@
 #include <SD.h>
 #include <SPI.h>
 
+#include "animRegistry.h"
+#include "assetBlobs.h"
+#include "assetFormat.h"
+#include "framePack.h"
+#include "frameCodec.h"
+#include "tileCodec.h"
+
+// geometry of the original headerless 48x48 dumps
 static const uint8_t framewidth = 48;
 static const uint8_t frameheight = 48;
-static const uint8_t framecount = 28;
+
+// animations bigger than this are streamed from the SD card one frame at a time
+// (0 streams everything, the host golden tests use it to cover the streaming path)
+static uint32_t animLoadLimit = 32 * 1024;
+
+// largest frame decoded into RAM or held by a cache slot, bigger ones are refused as damaged
+// (a delta coded or packed frame does not need its size in the file, only raw ones do)
+static const uint32_t animFrameLimit = 16 * 1024;
+
+// frame cache of the animation pack, slots hold the largest frame of the pack
+static const uint32_t framePackCacheBytes = 16 * 1024;
+static const uint8_t framePackCacheSlots = 32;
 
 static uint8_t oled_LineH = 0;
 
-struct Frame
+struct FramePack
 {
-    const char *fileName;
-    uint8_t frameCounts;
-    const String name;
+    bool open;
+    uint8_t *dirData; // everything in front of the frame data
+    FramePackDir dir;
+    FrameCache cache;
+    File file;
 };
 
-void loadAnimation(const char *fileName, uint8_t **data, uint8_t *dataSize);
+struct AnimAsset
+{
+    AssetHeader header;
+    uint32_t frameBytes;
+    uint32_t dataOffset;  // position of frame 0 in the file
+    uint32_t fileSize;
+    uint8_t *data;        // every frame (or the coded file), or one frame only when streaming
+    bool streaming;
+    uint32_t loadedFrame; // frame held in data when streaming
+    File file;            // stays open while streaming
+    bool packed;          // frames come from the animation pack
+    PackEntry entry;
+    uint8_t *decoded;     // delta encoded files: the frame rebuilt by the codec
+    DeltaInfo delta;
+    DeltaCursor cursor;
+    uint32_t filePos;     // read position while streaming a delta encoded file
+    uint8_t *dict;        // tile encoded files: the tile dictionary, data holds the indices
+    TileInfo tiles;
+    const uint8_t *blob;  // embedded files: frame 0 in flash, see assetBlobs.h
+};
+
+bool framePackOpen(fs::FS &fs, const char *path, FramePack &pack);
+void framePackClose(FramePack &pack);
+bool animPacked(const AnimDesc &anim);
+bool animEmbedded(const AnimDesc &anim);
+
+bool loadAnimation(const char *fileName, const AnimDesc &anim, AnimAsset &asset);
+const uint8_t *animFrame(AnimAsset &asset, uint32_t frame);
+void unloadAnimation(AnimAsset &asset);
 
-#endif // ANIMATION_H
\ No newline at end of file
+#endif // ANIMATION_H
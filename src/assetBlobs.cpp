@@ -0,0 +1,37 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: assetBlobs.cpp
+//
+// Description:
+//
+// the .incbin of every animation of ANIM_REGISTRY, built in with
+// -DANIM_EMBEDDED. Kept out of assetBlobs.h: the assembler defines
+// global symbols here, once, whatever includes the header.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifdef ANIM_EMBEDDED
+
+#include "assetBlobs.h"
+
+// a missing file fails the build
+#define ANIM_BLOB_INCBIN(category, id, name, width, height, frameCounts, legacyPath) \
+    __asm__(".section .rodata.animBlob_" #id ",\"a\"\n"                              \
+            ".balign 4\n"                                                            \
+            ".global animBlob_" #id "\n"                                             \
+            ".type animBlob_" #id ", @object\n"                                      \
+            "animBlob_" #id ":\n"                                                    \
+            ".incbin \"" ANIM_BLOB_DIR "/" #id ".bin\"\n"                            \
+            ".size animBlob_" #id ", . - animBlob_" #id "\n"                         \
+            ".global animBlob_" #id "_end\n"                                         \
+            "animBlob_" #id "_end:\n"                                                \
+            ".previous\n");
+
+ANIM_REGISTRY(ANIM_BLOB_INCBIN)
+
+#endif // ANIM_EMBEDDED
@@ -0,0 +1,89 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: assetBlobs.h
+//
+// Description:
+//
+// animation files linked into the firmware instead of read from the
+// SD card, built in with -DANIM_EMBEDDED (see platformio.ini). The
+// assembler pulls every animation of ANIM_REGISTRY (animRegistry.h) out
+// of the files folder byte for byte with .incbin, into a .rodata
+// section (flash on the ESP32): the compiler never parses the frames,
+// unlike the 1.1 MB of integer literals of the lib/*ver1.h headers.
+// The .incbin lives in assetBlobs.cpp, the one translation unit that
+// defines the symbols; this header only declares them.
+//
+// Each file becomes the symbols animBlob_<id> and animBlob_<id>_end
+// with its size set, so nm and the map file show what every animation
+// costs. assetBlobs[] follows the registry, so a blob is found by the
+// registry index of its animation. loadAnimation() plays a blob
+// straight from flash, no heap and no card access; animations without
+// a blob still come from the card.
+//
+// Paths are relative to ANIM_BLOB_DIR: the files folder, from the
+// project directory PlatformIO compiles in, or the absolute path the
+// host build passes as ANIM_FILES_DIR. Both use GNU as on ELF targets.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ASSETBLOBS_H
+#define ASSETBLOBS_H
+
+#include <stdint.h>
+
+#include "animRegistry.h"
+
+struct AssetBlob
+{
+    const uint8_t *data;
+    const uint8_t *end;
+};
+
+#ifdef ANIM_EMBEDDED
+
+#ifndef ANIM_BLOB_DIR
+#ifdef ANIM_FILES_DIR
+#define ANIM_BLOB_DIR ANIM_FILES_DIR
+#else
+#define ANIM_BLOB_DIR "files"
+#endif
+#endif
+
+#define ANIM_BLOB_DECLARE(category, id, name, width, height, frameCounts, legacyPath) \
+    extern "C" const uint8_t animBlob_##id[];                                         \
+    extern "C" const uint8_t animBlob_##id##_end[];
+
+#define ANIM_BLOB_ENTRY(category, id, name, width, height, frameCounts, legacyPath) \
+    {animBlob_##id, animBlob_##id##_end},
+
+ANIM_REGISTRY(ANIM_BLOB_DECLARE)
+
+// in registry order
+static const AssetBlob assetBlobs[animTotal] = {ANIM_REGISTRY(ANIM_BLOB_ENTRY)};
+static const uint8_t assetBlobCount = animTotal;
+
+// the blob of a registry entry, nullptr for the animations found on the card only
+static const AssetBlob *assetBlobFind(const AnimDesc &anim)
+{
+    // ids are hashed, not compared: only an entry of the registry itself matches
+    int16_t i = animIndex(anim.id);
+    return i >= 0 && animRegistry[i].id == anim.id ? &assetBlobs[i] : nullptr;
+}; // end assetBlobFind function
+
+#else
+
+static const uint8_t assetBlobCount = 0;
+
+static const AssetBlob *assetBlobFind(const AnimDesc &anim)
+{
+    return nullptr;
+}; // end assetBlobFind function
+
+#endif // ANIM_EMBEDDED
+
+#endif // ASSETBLOBS_H
@@ -0,0 +1,234 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: assetFormat.h
+//
+// Description:
+//
+// self-describing header placed in front of the frames of a byte
+// array animation file. Lets the player run animations of any size
+// (32x32 icons, 48x48, full screen 128x64) and any length instead
+// of the fixed 48x48, 288 byte frames.
+//
+// Layout (16 bytes, little endian):
+//   0  char[4]  magic "OBA1"
+//   4  uint8    version
+//   5  uint8    encoding (see AssetEncoding)
+//   6  uint16   width in pixels
+//   8  uint16   height in pixels
+//  10  uint16   stride, bytes per row (>= (width + 7) / 8, (width + 1) / 2 for 4 bit)
+//  12  uint32   frame count
+//
+// Standalone files use the raw, the delta (frameCodec.h) or the tile
+// (tileCodec.h) encoding, 4 bit grayscale frames for the panels of
+// grayPanel.h or the bit-planes of planePlayer.h; the sparse encoding
+// (frames cropped to their bounding box) needs the per-frame offsets
+// of the animation pack (framePack.h).
+//
+// Files without the magic are the original headerless dumps, their
+// geometry comes from the registry and the frame count from the
+// file size.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ASSETFORMAT_H
+#define ASSETFORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+static const uint8_t assetMagic[4] = {'O', 'B', 'A', '1'};
+static const uint8_t assetVersion = 1;
+static const uint8_t assetHeaderSize = 16;
+
+enum AssetEncoding : uint8_t
+{
+    ASSET_RAW = 0,    // row major, MSB first, as drawn by display.drawBitmap
+    ASSET_SPARSE = 1, // bounding box followed by the cropped raw rows, see assetSparseEncode
+    ASSET_DELTA = 2,  // keyframes and XOR deltas with a seek table, see frameCodec.h
+    ASSET_TILES = 3,  // grids of indices into an 8x8 tile dictionary, see tileCodec.h
+    ASSET_GRAY4 = 4,  // row major, 4 bits per pixel, the left pixel in the high nibble, see grayPanel.h
+    ASSET_PLANES2 = 5, // raw bit-planes, 2 per frame from the least significant one, see planePlayer.h
+    ASSET_PLANES3 = 6, // the same with 3 planes per frame
+};
+
+// bounding box of the lit pixels of a frame, x and width are byte aligned
+struct AssetBox
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+};
+
+static const uint8_t assetBoxSize = 8;
+
+struct AssetHeader
+{
+    uint8_t version;
+    uint8_t encoding;
+    uint16_t width;
+    uint16_t height;
+    uint16_t stride;
+    uint32_t frameCount;
+};
+
+// bytes per row for a bitmap of the given width
+inline uint16_t assetMinStride(uint16_t width)
+{
+    return (width + 7) / 8;
+}
+
+// bytes per row of a 4 bit grayscale bitmap
+inline uint16_t assetGrayStride(uint16_t width)
+{
+    return (width + 1) / 2;
+}
+
+// bit-planes per frame of a plane asset, 1 for the others; each plane counts as a frame of the header
+inline uint8_t assetPlaneCount(const AssetHeader &header)
+{
+    return header.encoding == ASSET_PLANES2 ? 2 : header.encoding == ASSET_PLANES3 ? 3 : 1;
+}
+
+inline uint32_t assetFrameBytes(const AssetHeader &header)
+{
+    return (uint32_t)header.stride * header.height;
+}
+
+// header describing an original headerless dump of the given size
+inline AssetHeader assetLegacyHeader(uint16_t width, uint16_t height, uint32_t fileSize)
+{
+    AssetHeader header = {assetVersion, ASSET_RAW, width, height, assetMinStride(width), 0};
+    uint32_t frameBytes = assetFrameBytes(header);
+    header.frameCount = frameBytes ? fileSize / frameBytes : 0;
+    return header;
+}
+
+inline bool assetHasMagic(const uint8_t *buf, size_t len)
+{
+    return len >= 4 && buf[0] == assetMagic[0] && buf[1] == assetMagic[1] && buf[2] == assetMagic[2] && buf[3] == assetMagic[3];
+}
+
+// parses and validates a header, returns false when it is not usable
+inline bool assetParseHeader(const uint8_t *buf, size_t len, AssetHeader &header)
+{
+    if (len < assetHeaderSize || !assetHasMagic(buf, len))
+    {
+        return false;
+    }
+    header.version = buf[4];
+    header.encoding = buf[5];
+    header.width = buf[6] | (buf[7] << 8);
+    header.height = buf[8] | (buf[9] << 8);
+    header.stride = buf[10] | (buf[11] << 8);
+    header.frameCount = (uint32_t)buf[12] | ((uint32_t)buf[13] << 8) | ((uint32_t)buf[14] << 16) | ((uint32_t)buf[15] << 24);
+
+    uint16_t minStride = header.encoding == ASSET_GRAY4 ? assetGrayStride(header.width) : assetMinStride(header.width);
+    return header.version == assetVersion && header.width > 0 && header.height > 0 && header.stride >= minStride;
+}
+
+inline void assetWriteHeader(const AssetHeader &header, uint8_t *buf)
+{
+    buf[0] = assetMagic[0];
+    buf[1] = assetMagic[1];
+    buf[2] = assetMagic[2];
+    buf[3] = assetMagic[3];
+    buf[4] = header.version;
+    buf[5] = header.encoding;
+    buf[6] = header.width & 0xFF;
+    buf[7] = header.width >> 8;
+    buf[8] = header.height & 0xFF;
+    buf[9] = header.height >> 8;
+    buf[10] = header.stride & 0xFF;
+    buf[11] = header.stride >> 8;
+    buf[12] = header.frameCount & 0xFF;
+    buf[13] = (header.frameCount >> 8) & 0xFF;
+    buf[14] = (header.frameCount >> 16) & 0xFF;
+    buf[15] = header.frameCount >> 24;
+}
+
+// biggest encoded frame, what a buffer holding one frame of the asset needs
+inline uint32_t assetMaxFrameBytes(const AssetHeader &header)
+{
+    return assetFrameBytes(header) + (header.encoding == ASSET_SPARSE ? assetBoxSize : 0);
+}
+
+inline void assetReadBox(const uint8_t *buf, AssetBox &box)
+{
+    box.x = buf[0] | (buf[1] << 8);
+    box.y = buf[2] | (buf[3] << 8);
+    box.width = buf[4] | (buf[5] << 8);
+    box.height = buf[6] | (buf[7] << 8);
+}
+
+// bytes of the cropped rows following the box
+inline uint32_t assetBoxBytes(const AssetBox &box)
+{
+    return (uint32_t)assetMinStride(box.width) * box.height;
+}
+
+// a box read from a file must lie inside the frame and be byte aligned
+inline bool assetBoxValid(const AssetHeader &header, const AssetBox &box)
+{
+    return (box.x & 7) == 0 && (uint32_t)box.x + box.width <= header.width && (uint32_t)box.y + box.height <= header.height;
+}
+
+// crops a raw frame to the bytes holding lit pixels, writes box + rows to out
+// returns the encoded size, at most assetMaxFrameBytes(header)
+inline uint32_t assetSparseEncode(const AssetHeader &header, const uint8_t *frame, uint8_t *out)
+{
+    uint16_t rowBytes = assetMinStride(header.width);
+    int32_t top = -1, bottom = -1, left = rowBytes, right = -1;
+
+    for (uint16_t y = 0; y < header.height; y++)
+    {
+        const uint8_t *row = frame + (uint32_t)y * header.stride;
+        for (uint16_t b = 0; b < rowBytes; b++)
+        {
+            if (row[b])
+            {
+                top = top < 0 ? y : top;
+                bottom = y;
+                left = b < left ? b : left;
+                right = b > right ? b : right;
+            }
+        }
+    }
+
+    AssetBox box = {0, 0, 0, 0};
+    if (top >= 0)
+    {
+        box.x = left * 8;
+        box.y = top;
+        box.width = (right + 1) * 8 > header.width ? header.width - box.x : (right - left + 1) * 8;
+        box.height = bottom - top + 1;
+    }
+
+    out[0] = box.x & 0xFF;
+    out[1] = box.x >> 8;
+    out[2] = box.y & 0xFF;
+    out[3] = box.y >> 8;
+    out[4] = box.width & 0xFF;
+    out[5] = box.width >> 8;
+    out[6] = box.height & 0xFF;
+    out[7] = box.height >> 8;
+
+    uint32_t len = assetBoxSize;
+    uint16_t boxBytes = assetMinStride(box.width);
+    for (uint16_t y = 0; y < box.height; y++)
+    {
+        memcpy(out + len, frame + (uint32_t)(box.y + y) * header.stride + box.x / 8, boxBytes);
+        len += boxBytes;
+    }
+    return len;
+}
+
+#endif // ASSETFORMAT_H
@@ -0,0 +1,312 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306, SD card reader
+//
+// File: assetIndex.h
+//
+// Description:
+//
+// discovers the animation files on the SD card once and keeps the
+// result in a small binary index file (/anim.idx), keyed by file
+// name, size and modification time. Later boots only read the index,
+// unless the card fingerprint (used bytes) changed or a file no
+// longer matches its entry, in which case the card is scanned again.
+// The fingerprint moves in whole clusters only, so every entry is
+// also checked against the size and modification time of its file:
+// one open per animation instead of reading every header.
+//
+// Before a scan, the files still carrying the 8.3 names of the first
+// releases (/by_batLv.bin, ...) are renamed to the registry paths, so
+// a card written for those releases keeps playing without copying the
+// files folder again.
+//
+// Every file found is validated: it must either carry a valid asset
+// header (assetFormat.h) or be a whole number of 48x48 frames.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ASSETINDEX_H
+#define ASSETINDEX_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include "animations.h"
+#include "asyncLog.h"
+
+static const char *assetIndexPath = "/anim.idx";
+static const uint8_t assetIndexMagic[4] = {'O', 'B', 'A', 'I'};
+static const uint8_t assetIndexVersion = 1;
+static const uint8_t assetIndexMax = 64;
+static const uint8_t assetPathMax = 32;
+
+struct AssetIndexEntry
+{
+    char path[assetPathMax];
+    uint32_t size;
+    uint32_t mtime;
+    uint32_t frameCount;
+    uint16_t width;
+    uint16_t height;
+    uint16_t stride;
+    uint8_t encoding;
+    uint8_t dataOffset; // 0 for headerless files, assetHeaderSize otherwise
+};
+static_assert(sizeof(AssetIndexEntry) == 52, "index entries are written to the card as is");
+
+struct AssetIndexFileHeader
+{
+    uint8_t magic[4];
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t count;
+    uint64_t fingerprint;
+};
+
+struct AssetIndex
+{
+    uint64_t fingerprint;
+    uint16_t count;
+    AssetIndexEntry entries[assetIndexMax];
+};
+
+const AssetIndexEntry *assetIndexFind(const AssetIndex &index, const char *path)
+{
+    for (uint16_t i = 0; i < index.count; i++)
+    {
+        if (strcmp(index.entries[i].path, path) == 0)
+        {
+            return &index.entries[i];
+        }
+    }
+    return nullptr;
+}; // end assetIndexFind function
+
+// checks one file and fills its entry, returns false when it is not a playable animation
+static bool assetIndexValidate(File &file, const char *path, AssetIndexEntry &entry)
+{
+    size_t len = strlen(path);
+    if (len >= assetPathMax || len < 5 || strcmp(path + len - 4, ".bin") != 0)
+    {
+        return false;
+    }
+
+    uint8_t head[assetHeaderSize];
+    size_t headLen = file.read(head, sizeof(head));
+    AssetHeader header;
+
+    memset(&entry, 0, sizeof(entry));
+    strcpy(entry.path, path);
+    entry.size = file.size();
+    entry.mtime = (uint32_t)file.getLastWrite();
+
+    if (assetParseHeader(head, headLen, header))
+    {
+        uint64_t minSize = header.encoding == ASSET_DELTA   ? assetHeaderSize + deltaInfoSize
+                           : header.encoding == ASSET_TILES ? assetHeaderSize + tileInfoSize
+                                                            : assetHeaderSize + (uint64_t)header.frameCount * assetFrameBytes(header);
+        if ((header.encoding != ASSET_RAW && header.encoding != ASSET_DELTA && header.encoding != ASSET_TILES &&
+             header.encoding != ASSET_GRAY4 && assetPlaneCount(header) == 1) ||
+            header.frameCount == 0 || entry.size < minSize)
+        {
+            return false;
+        }
+        entry.dataOffset = assetHeaderSize;
+    }
+    else
+    {
+        if (assetHasMagic(head, headLen))
+        {
+            return false;
+        }
+        header = assetLegacyHeader(framewidth, frameheight, entry.size);
+        if (header.frameCount == 0 || header.frameCount * assetFrameBytes(header) != entry.size)
+        {
+            return false;
+        }
+        entry.dataOffset = 0;
+    }
+
+    entry.width = header.width;
+    entry.height = header.height;
+    entry.stride = header.stride;
+    entry.encoding = header.encoding;
+    entry.frameCount = header.frameCount;
+    return true;
+}; // end assetIndexValidate function
+
+// renames the files of the registry still under their 8.3 name, returns how many were renamed
+// the long name wins when both are on the card
+uint8_t assetIndexMigrate(fs::FS &fs)
+{
+    uint8_t renamed = 0;
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        const AnimDesc &anim = animRegistry[i];
+        if (anim.legacyPath && !fs.exists(anim.path) && fs.exists(anim.legacyPath))
+        {
+            if (fs.rename(anim.legacyPath, anim.path))
+            {
+                renamed++;
+            }
+            else
+            {
+                LOG_WARN("Failed to rename %s to %s", anim.legacyPath, anim.path);
+            }
+        }
+    }
+    if (renamed)
+    {
+        LOG_INFO("Asset index: %u files renamed from their 8.3 name", renamed);
+    }
+    return renamed;
+}; // end assetIndexMigrate function
+
+// walks the root directory once and rebuilds the index
+uint16_t assetIndexScan(fs::FS &fs, AssetIndex &index)
+{
+    index.count = 0;
+
+    File root = fs.open("/");
+    if (!root || !root.isDirectory())
+    {
+        LOG_ERROR("Failed to open root directory");
+        return 0;
+    }
+
+    char path[assetPathMax + 1];
+    File file = root.openNextFile();
+    while (file)
+    {
+        if (!file.isDirectory())
+        {
+            // name() has no leading slash on recent cores, path() is not available on older ones
+            const char *name = file.name();
+            snprintf(path, sizeof(path), "%s%s", name[0] == '/' ? "" : "/", name);
+
+            if (index.count < assetIndexMax && assetIndexValidate(file, path, index.entries[index.count]))
+            {
+                index.count++;
+            }
+            else if (strcmp(path, assetIndexPath) != 0)
+            {
+                LOG_DEBUG("  skipped %s", path);
+            }
+        }
+        file = root.openNextFile();
+    }
+    root.close();
+
+    LOG_INFO("Asset index: %u animations found", index.count);
+    return index.count;
+}; // end assetIndexScan function
+
+bool assetIndexSave(fs::FS &fs, const AssetIndex &index)
+{
+    File file = fs.open(assetIndexPath, FILE_WRITE);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open asset index for writing");
+        return false;
+    }
+
+    AssetIndexFileHeader header;
+    memcpy(header.magic, assetIndexMagic, sizeof(header.magic));
+    header.version = assetIndexVersion;
+    header.reserved = 0;
+    header.count = index.count;
+    header.fingerprint = index.fingerprint;
+
+    bool ok = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header);
+    size_t entryBytes = index.count * sizeof(AssetIndexEntry);
+    ok = ok && file.write((const uint8_t *)index.entries, entryBytes) == entryBytes;
+    file.close();
+    return ok;
+}; // end assetIndexSave function
+
+// reads the index, returns false when it is missing, damaged, for another card state or a file changed
+bool assetIndexLoad(fs::FS &fs, uint64_t fingerprint, AssetIndex &index)
+{
+    index.count = 0;
+
+    File file = fs.open(assetIndexPath);
+    if (!file)
+    {
+        return false;
+    }
+
+    AssetIndexFileHeader header;
+    bool ok = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              memcmp(header.magic, assetIndexMagic, sizeof(header.magic)) == 0 &&
+              header.version == assetIndexVersion && header.count <= assetIndexMax &&
+              header.fingerprint == fingerprint &&
+              file.size() == sizeof(header) + header.count * sizeof(AssetIndexEntry);
+
+    size_t entryBytes = header.count * sizeof(AssetIndexEntry);
+    ok = ok && file.read((uint8_t *)index.entries, entryBytes) == entryBytes;
+    file.close();
+
+    // lookups strcmp the paths and the player trusts the geometry, a damaged entry means a rescan
+    for (uint16_t i = 0; ok && i < header.count; i++)
+    {
+        const AssetIndexEntry &entry = index.entries[i];
+        ok = memchr(entry.path, 0, assetPathMax) != nullptr && entry.path[0] == '/' && entry.width > 0 &&
+             entry.height > 0 && entry.stride >= assetMinStride(entry.width);
+    }
+
+    // a file touched or replaced by one of about the same size keeps the fingerprint, not its size and time
+    for (uint16_t i = 0; ok && i < header.count; i++)
+    {
+        const AssetIndexEntry &entry = index.entries[i];
+        File asset = fs.open(entry.path);
+        ok = asset && !asset.isDirectory() && asset.size() == entry.size &&
+             (uint32_t)asset.getLastWrite() == entry.mtime;
+        asset.close();
+        if (!ok)
+        {
+            LOG_DEBUG("  %s changed since the index was written", entry.path);
+        }
+    }
+
+    if (ok)
+    {
+        index.count = header.count;
+        index.fingerprint = fingerprint;
+    }
+    return ok;
+}; // end assetIndexLoad function
+
+// marks the index stale so the next boot scans the card again
+void assetIndexInvalidate(fs::FS &fs)
+{
+    fs.remove(assetIndexPath);
+}; // end assetIndexInvalidate function
+
+// loads the index or scans the card and writes a fresh one
+// fingerprint() is called again after writing, the index file itself uses card space
+// returns true when the index could be used as is
+bool assetIndexBegin(fs::FS &fs, uint64_t (*fingerprint)(), AssetIndex &index)
+{
+    if (assetIndexLoad(fs, fingerprint(), index))
+    {
+        LOG_INFO("Asset index loaded: %u animations", index.count);
+        return true;
+    }
+
+    LOG_INFO("Asset index missing or stale, scanning card");
+    assetIndexMigrate(fs);
+    assetIndexScan(fs, index);
+    index.fingerprint = 0;
+    if (assetIndexSave(fs, index))
+    {
+        // same size rewrite, takes the same clusters so the fingerprint stays valid
+        index.fingerprint = fingerprint();
+        assetIndexSave(fs, index);
+    }
+    return false;
+}; // end assetIndexBegin function
+
+#endif // ASSETINDEX_H
@@ -0,0 +1,207 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32
+//
+// File: asyncLog.h
+//
+// Description:
+//
+// the sketch logs with LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG(format,
+// ...) instead of Serial.printf(). The line is formatted on the
+// caller's stack and pushed into the ring of logRing.h; the drain
+// task started by logBegin() writes it to Serial later, on core 0 at
+// low priority. At 115200 baud a line blocks Serial for milliseconds
+// once the UART FIFO is full, now the drain task waits instead of the
+// render loop. When the ring is full the line is dropped, and the
+// drain task reports how many were before the next one it writes.
+//
+// LOG_LEVEL (platformio.ini, LOG_LEVEL_INFO by default) strips the
+// calls above it at compile time, arguments included. Lines are
+// written as given, the newline is added by the drain.
+//
+// Until logBegin() succeeded (and on the host, which has one task)
+// every line is written out right away, in the caller.
+//
+// logReport() is for output asked for (benchmark tables, CSV lines):
+// not stripped by LOG_LEVEL and never dropped, the caller waits for
+// room in the ring instead. Output that is not text, like the binary
+// profile record, goes between logPause() and logResume(): the drain
+// task stops after its current line, the caller writes out what is
+// left in the ring and has Serial to itself until it resumes.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ASYNCLOG_H
+#define ASYNCLOG_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include "logRing.h"
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+static const uint16_t logDrainStack = 3072;
+static const uint32_t logDrainPeriodMs = 10;
+
+enum LogDrainState : uint8_t
+{
+    LOG_DRAIN_RUN,
+    LOG_DRAIN_PAUSING, // asked by logPause(), the drain task finishes its pass first
+    LOG_DRAIN_PAUSED,  // the drain task keeps off the ring and Serial
+};
+
+static LogRing logRing;
+static TaskHandle_t logTask = nullptr;
+static uint32_t logDroppedReported = 0;
+static std::atomic<uint8_t> logDrainState{LOG_DRAIN_RUN};
+
+// writes every pending line to Serial, the drain task body
+static void logDrain(void)
+{
+    LogRecord record;
+    while (logRingPop(logRing, record))
+    {
+        uint32_t dropped = logRing.dropped.load(std::memory_order_relaxed);
+        if (dropped != logDroppedReported)
+        {
+            Serial.printf("Log: %u lines dropped\n", dropped - logDroppedReported);
+            logDroppedReported = dropped;
+        }
+        Serial.println(record.text);
+    }
+}; // end logDrain function
+
+// one pass of the drain task, a pause is acknowledged between two passes, never in the middle of a line
+static void logDrainPass(void)
+{
+    uint8_t state = LOG_DRAIN_PAUSING;
+    if (!logDrainState.compare_exchange_strong(state, LOG_DRAIN_PAUSED) && state == LOG_DRAIN_RUN)
+    {
+        logDrain();
+    }
+}; // end logDrainPass function
+
+static void logDrainTask(void *)
+{
+    for (;;)
+    {
+        logDrainPass();
+        vTaskDelay(pdMS_TO_TICKS(logDrainPeriodMs));
+    }
+}; // end logDrainTask function
+
+// starts the drain task, lines stay synchronous when it cannot be created
+static bool logBegin(void)
+{
+    if (!logTask && xTaskCreatePinnedToCore(logDrainTask, "logDrain", logDrainStack, nullptr, tskIDLE_PRIORITY + 1,
+                                            &logTask, 0) != pdPASS)
+    {
+        logTask = nullptr;
+    }
+    return logTask != nullptr;
+}; // end logBegin function
+
+// lines dropped since boot
+static uint32_t logDropped(void)
+{
+    return logRing.dropped.load(std::memory_order_relaxed);
+}; // end logDropped function
+
+// stops the drain task and writes out the pending lines, Serial belongs to the caller until logResume()
+static void logPause(void)
+{
+    if (logTask)
+    {
+        logDrainState.store(LOG_DRAIN_PAUSING);
+        while (logDrainState.load() != LOG_DRAIN_PAUSED)
+        {
+            vTaskDelay(1);
+        }
+    }
+    logDrain();
+}; // end logPause function
+
+static void logResume(void)
+{
+    logDrainState.store(LOG_DRAIN_RUN);
+}; // end logResume function
+
+static void logWriteArgs(uint8_t level, bool wait, const char *format, va_list args)
+{
+    char text[logLineMax + 1];
+    int length = vsnprintf(text, sizeof(text), format, args);
+    if (length < 0)
+    {
+        return;
+    }
+    size_t size = (size_t)length < sizeof(text) ? length : sizeof(text) - 1;
+    while (wait && logTask && !logRingFits(logRing, size))
+    {
+        vTaskDelay(1);
+    }
+    logRingPush(logRing, level, text, size);
+    // while paused the caller owns Serial, its lines go out right away
+    if (!logTask || logDrainState.load() == LOG_DRAIN_PAUSED)
+    {
+        logDrain();
+    }
+}; // end logWriteArgs function
+
+static void logWrite(uint8_t level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void logWrite(uint8_t level, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    logWriteArgs(level, false, format, args);
+    va_end(args);
+}; // end logWrite function
+
+// a line of a report, whatever LOG_LEVEL, waits for room in the ring rather than being dropped
+static void logReport(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+static void logReport(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    logWriteArgs(LOG_LEVEL_INFO, true, format, args);
+    va_end(args);
+}; // end logReport function
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#endif // ASYNCLOG_H
@@ -0,0 +1,166 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: bitTranspose.h
+//
+// Description:
+//
+// converts row major bitmaps (MSB first, the layout of the wokwi
+// animator arrays and of drawBitmap) to the SSD1306 page layout (one
+// byte per column and page, bit 0 on top) at run time, for the frames
+// that reach the player row major: raw, sparse and delta assets, frames
+// streamed from the card or supplied by the user.
+//
+// The frame is cut in blocks of 8x8 pixels. The 8 row bytes of a block
+// are loaded into one 64 bit word and transposed by three shift and
+// mask exchanges (2x2, 4x4 then 8x8 sub-blocks of bits), which gives
+// the 8 column bytes of the block in the page layout. A 48x48 frame is
+// 36 blocks, empty ones are skipped. bitBlitRows() ORs each block into
+// the display buffer like drawBitmap(x, y, bitmap, w, h, 1) sets its
+// pixels: one 64 bit OR on a page boundary, two shifted ones when the
+// block straddles two pages (the animation area starts at y = 15), the
+// clipped blocks at the edges through tileDraw().
+//
+// The buffer words are read and written with memcpy in the byte order
+// of the ESP32 and the host, little endian.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef BITTRANSPOSE_H
+#define BITTRANSPOSE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "tileCodec.h"
+
+// 8x8 bits: row r in byte r with its left pixel in bit 7, to column c in byte c with row r in bit r
+inline uint64_t bitTranspose8(uint64_t rows)
+{
+    uint64_t t;
+    t = (rows ^ (rows >> 7)) & 0x00AA00AA00AA00AAull;
+    rows ^= t ^ (t << 7);
+    t = (rows ^ (rows >> 14)) & 0x0000CCCC0000CCCCull;
+    rows ^= t ^ (t << 14);
+    t = (rows ^ (rows >> 28)) & 0x00000000F0F0F0F0ull;
+    rows ^= t ^ (t << 28);
+    // the left pixel was bit 7, its column has to be byte 0
+    return __builtin_bswap64(rows);
+}
+
+// the byte column of up to 8 rows starting at bitmap, the bits right of the bitmap masked out
+inline uint64_t bitGatherRows(const uint8_t *bitmap, uint16_t stride, uint8_t rows, uint8_t mask)
+{
+    uint64_t word = 0;
+    for (uint8_t r = 0; r < rows; r++)
+    {
+        word |= (uint64_t)(bitmap[r * stride] & mask) << (8 * r);
+    }
+    return word;
+}
+
+// mask of the pixels of byte column bx that lie inside a bitmap of width pixels
+inline uint8_t bitColumnMask(uint16_t width, uint16_t bx)
+{
+    uint16_t left = width - bx * 8;
+    return left >= 8 ? 0xFF : (uint8_t)(0xFF << (8 - left));
+}
+
+// whole frame to the page layout: (height + 7) / 8 pages of width bytes, the rows under the frame clear
+inline void bitRowsToPages(const uint8_t *bitmap, uint16_t width, uint16_t height, uint16_t stride, uint8_t *pages)
+{
+    uint16_t byteColumns = (width + 7) / 8;
+    for (uint16_t page = 0; page * 8 < height; page++)
+    {
+        uint8_t rows = height - page * 8 < 8 ? height - page * 8 : 8;
+        uint8_t *dst = pages + page * width;
+        for (uint16_t bx = 0; bx < byteColumns; bx++)
+        {
+            uint64_t block = bitTranspose8(bitGatherRows(bitmap + page * 8 * stride + bx, stride, rows,
+                                                         bitColumnMask(width, bx)));
+            uint8_t columns = width - bx * 8 < 8 ? width - bx * 8 : 8;
+            if (columns == 8)
+            {
+                memcpy(dst + bx * 8, &block, 8);
+            }
+            else
+            {
+                for (uint8_t c = 0; c < columns; c++)
+                {
+                    dst[bx * 8 + c] = block >> (8 * c);
+                }
+            }
+        }
+    }
+}
+
+// ORs a row major bitmap into the page buffer with its top left corner at (x, y), clipped to the buffer
+inline void bitBlitRows(const uint8_t *bitmap, uint16_t width, uint16_t height, uint16_t stride, uint8_t *buffer,
+                        int16_t bufWidth, int16_t bufHeight, int16_t x, int16_t y)
+{
+    uint16_t byteColumns = (width + 7) / 8;
+    int16_t pages = bufHeight / 8;
+    for (uint16_t by = 0; by < height; by += 8)
+    {
+        int16_t top = y + by;
+        if (top >= bufHeight)
+        {
+            break;
+        }
+        if (top <= -8)
+        {
+            continue;
+        }
+        uint8_t rows = height - by < 8 ? height - by : 8;
+        int16_t page = top >= 0 ? top / 8 : -1;
+        uint8_t shift = top & 7;
+        bool rowsInside = page >= 0 && page + (shift != 0) < pages;
+        for (uint16_t bx = 0; bx < byteColumns; bx++)
+        {
+            int16_t left = x + bx * 8;
+            if (left <= -8 || left >= bufWidth)
+            {
+                continue;
+            }
+            uint64_t block = bitTranspose8(bitGatherRows(bitmap + by * stride + bx, stride, rows,
+                                                         bitColumnMask(width, bx)));
+            if (!block)
+            {
+                continue;
+            }
+            if (!rowsInside || left < 0 || left + 8 > bufWidth)
+            {
+                uint8_t tile[tileBytes];
+                memcpy(tile, &block, tileBytes);
+                tileDraw(tile, buffer, bufWidth, bufHeight, left, top);
+                continue;
+            }
+
+            uint64_t word;
+            uint8_t *dst = buffer + page * bufWidth + left;
+            memcpy(&word, dst, 8);
+            if (shift == 0)
+            {
+                word |= block;
+                memcpy(dst, &word, 8);
+                continue;
+            }
+            // every column byte shifted down by shift rows, what leaves a byte goes to the page below
+            uint64_t keep = 0x0101010101010101ull * (uint8_t)(0xFF << shift);
+            word |= (block << shift) & keep;
+            memcpy(dst, &word, 8);
+            memcpy(&word, dst + bufWidth, 8);
+            word |= (block >> (8 - shift)) & ~keep;
+            memcpy(dst + bufWidth, &word, 8);
+        }
+    }
+}
+
+#endif // BITTRANSPOSE_H
@@ -0,0 +1,211 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306 or SSD1327
+//
+// File: displayBackend.h
+//
+// Description:
+//
+// what a panel has to offer to play the animations, whatever its pixel
+// format: clear a rectangle, draw a 1 bit or a 4 bit bitmap, flush a
+// rectangle. displayBackendMono() puts an AnimPanel of animPlayer.h
+// (SSD1306, 1 bit pages) behind it, displayBackendGray() a GrayPanel
+// of grayPanel.h (SSD1327, 4 bit).
+//
+// backendPlay() plays an animation on any backend the way
+// byteArray_Display() does on the SSD1306: centered, only the union of
+// the previous and the current frame box cleared, drawn and flushed.
+// 1 bit frames (raw, sparse, delta) are drawn by drawMono, 4 bit ones
+// (ASSET_GRAY4) by drawGray; a monochrome panel shows the 4 bit pixels
+// from level 8 up. Tile encoded assets are in the SSD1306 page layout
+// and are left to the player of animPlayer.h.
+//
+// The SSD1306 player keeps its own path (caption, status text, tiles
+// straight into the pages), this is for the panels that do not share
+// its layout.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef DISPLAYBACKEND_H
+#define DISPLAYBACKEND_H
+
+#include <Arduino.h>
+
+#include "animPlayer.h"
+#include "grayPanel.h"
+
+typedef void (*BackendClear)(void *ctx, const FrameRect &region);
+typedef void (*BackendDraw)(void *ctx, int16_t x, int16_t y, const uint8_t *bitmap, uint16_t width, uint16_t height,
+                            uint16_t stride);
+typedef bool (*BackendFlush)(void *ctx, const FrameRect &region);
+
+struct DisplayBackend
+{
+    const char *name;
+    uint8_t bitsPerPixel;
+    int16_t width;
+    int16_t height;
+    void *ctx; // the panel
+    BackendClear clear;
+    BackendDraw drawMono; // row major, MSB first, as drawBitmap
+    BackendDraw drawGray; // row major, 4 bits per pixel, the left one in the high nibble
+    BackendFlush flush;
+};
+
+static void backendMonoClear(void *ctx, const FrameRect &region)
+{
+    Adafruit_SSD1306 &oled = *((AnimPanel *)ctx)->oled;
+    FrameRect r = frameRectClip(region, oled.width(), oled.height());
+    if (!frameRectIsEmpty(r))
+    {
+        oled.fillRect(r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0, 0);
+    }
+}; // end backendMonoClear function
+
+static void backendMonoDraw(void *ctx, int16_t x, int16_t y, const uint8_t *bitmap, uint16_t width, uint16_t height,
+                            uint16_t stride)
+{
+    animBlit(*((AnimPanel *)ctx)->oled, x, y, bitmap, width, height, stride);
+}; // end backendMonoDraw function
+
+// 4 bit pixels from level 8 up are lit
+static void backendMonoDrawGray(void *ctx, int16_t x, int16_t y, const uint8_t *pixels, uint16_t width,
+                                uint16_t height, uint16_t stride)
+{
+    Adafruit_SSD1306 &oled = *((AnimPanel *)ctx)->oled;
+    for (uint16_t row = 0; row < height; row++)
+    {
+        for (uint16_t col = 0; col < width; col++)
+        {
+            uint8_t b = pixels[(uint32_t)row * stride + col / 2];
+            if ((col & 1 ? b & 0x0F : b >> 4) >= 8)
+            {
+                oled.drawPixel(x + col, y + row, 1);
+            }
+        }
+    }
+}; // end backendMonoDrawGray function
+
+static bool backendMonoFlush(void *ctx, const FrameRect &region)
+{
+    AnimPanel &panel = *(AnimPanel *)ctx;
+    return oledFlushRegion(*panel.oled, *panel.wire, panel.address, region);
+}; // end backendMonoFlush function
+
+static void displayBackendMono(DisplayBackend &backend, AnimPanel &panel)
+{
+    backend = {"SSD1306", 1, panel.oled->width(), panel.oled->height(), &panel, backendMonoClear, backendMonoDraw,
+               backendMonoDrawGray, backendMonoFlush};
+}; // end displayBackendMono function
+
+static void backendGrayClear(void *ctx, const FrameRect &region)
+{
+    GrayPanel &panel = *(GrayPanel *)ctx;
+    grayFill(panel, region, panel.off);
+}; // end backendGrayClear function
+
+static void backendGrayDrawMono(void *ctx, int16_t x, int16_t y, const uint8_t *bitmap, uint16_t width,
+                                uint16_t height, uint16_t stride)
+{
+    grayDrawMono(*(GrayPanel *)ctx, x, y, bitmap, width, height, stride);
+}; // end backendGrayDrawMono function
+
+static void backendGrayDraw(void *ctx, int16_t x, int16_t y, const uint8_t *pixels, uint16_t width, uint16_t height,
+                            uint16_t stride)
+{
+    grayDrawGray(*(GrayPanel *)ctx, x, y, pixels, width, height, stride);
+}; // end backendGrayDraw function
+
+static bool backendGrayFlush(void *ctx, const FrameRect &region)
+{
+    return grayFlushRegion(*(GrayPanel *)ctx, region);
+}; // end backendGrayFlush function
+
+static void displayBackendGray(DisplayBackend &backend, GrayPanel &panel)
+{
+    backend = {"SSD1327", 4, panel.width, panel.height, &panel, backendGrayClear, backendGrayDrawMono,
+               backendGrayDraw, backendGrayFlush};
+}; // end displayBackendGray function
+
+// draws the frame with its top left corner at x, y; returns the box it covers, empty when it cannot be drawn
+static FrameRect backendDrawFrame(DisplayBackend &backend, AnimAsset &asset, uint32_t frame, int16_t x, int16_t y)
+{
+    const uint8_t *bits;
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_DECODE);
+        bits = animFrame(asset, frame);
+    }
+    ANIM_PROFILE_SCOPE(PROFILE_COMPOSE);
+    const AssetHeader &header = asset.header;
+    if (header.encoding == ASSET_SPARSE)
+    {
+        AssetBox crop;
+        assetReadBox(bits, crop);
+        FrameRect box = {(int16_t)(x + crop.x), (int16_t)(y + crop.y), (int16_t)(x + crop.x + crop.width),
+                         (int16_t)(y + crop.y + crop.height)};
+        backend.drawMono(backend.ctx, box.x0, box.y0, bits + assetBoxSize, crop.width, crop.height,
+                         assetMinStride(crop.width));
+        return box;
+    }
+    FrameRect box = {x, y, (int16_t)(x + header.width), (int16_t)(y + header.height)};
+    if (header.encoding == ASSET_GRAY4)
+    {
+        backend.drawGray(backend.ctx, x, y, bits, header.width, header.height, header.stride);
+    }
+    else if (header.encoding == ASSET_TILES)
+    {
+        return frameRectEmpty;
+    }
+    else
+    {
+        backend.drawMono(backend.ctx, x, y, bits, header.width, header.height, header.stride);
+    }
+    return box;
+}; // end backendDrawFrame function
+
+// plays frames of the animation centered on the panel, returns the frames shown
+static uint32_t backendPlay(DisplayBackend &backend, const AnimDesc &anim, uint32_t frames)
+{
+    ANIM_TRACE_SCOPE(anim.id);
+    AnimAsset asset;
+    if (!animOpen(anim, asset, backend.bitsPerPixel > 1 ? animAcceptGray : 0))
+    {
+        return 0;
+    }
+    if (asset.header.encoding == ASSET_TILES)
+    {
+        LOG_WARN("%s is tile encoded, the %s backend draws raw frames only", anim.path, backend.name);
+        unloadAnimation(asset);
+        return 0;
+    }
+
+    int16_t x = ((backend.width - (int16_t)asset.header.width) / 2) & ~1; // even: whole bytes on a 4 bit panel
+    int16_t y = (backend.height - (int16_t)asset.header.height) / 2;
+    FrameRect screen = {0, 0, backend.width, backend.height};
+    backend.clear(backend.ctx, screen);
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+        backend.flush(backend.ctx, screen);
+    }
+
+    FrameRect drawn = frameRectEmpty;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        // clear what the previous frame covered, then draw and send the union
+        backend.clear(backend.ctx, drawn);
+        FrameRect box = backendDrawFrame(backend, asset, f % asset.header.frameCount, x, y);
+        FrameRect dirty = frameRectClip(frameRectUnion(drawn, box), backend.width, backend.height);
+        {
+            ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+            backend.flush(backend.ctx, dirty);
+        }
+        drawn = box;
+    }
+    unloadAnimation(asset);
+    return frames;
+}; // end backendPlay function
+
+#endif // DISPLAYBACKEND_H
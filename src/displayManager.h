@@ -0,0 +1,321 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306 (up to 4)
+//
+// File: displayManager.h
+//
+// Description:
+//
+// several SSD1306 panels driven at once, on both I2C controllers of
+// the ESP32 (Wire and Wire1) at 0x3C and 0x3D: weather on one panel,
+// system and battery status on the others. Each panel has its own
+// Adafruit_SSD1306 buffer, caption layer and player (screen, asset,
+// frame) going through the animations of its category, 30 frames each
+// like byteArray_Anim(), from the first again after the last.
+//
+// displayStep() draws the next frame of every panel with the player
+// of animPlayer.h, the panels deferred so the regions to send are only
+// queued, then hands each bus to its flush task. The two tasks send
+// their panels side by side and the step waits for both, so a step
+// costs the busiest bus instead of the sum of all panel flushes: with
+// the panels spread over both buses, frames/s doubles. Panels on one
+// bus are flushed one after the other.
+//
+// Without the tasks (xTaskCreatePinnedToCore failed, or the host) the
+// buses are flushed in turn by the caller. The host build defines
+// ANIM_HOST_WIRE: the Wire mock then counts the two buses as running
+// side by side, see host/Wire.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef DISPLAYMANAGER_H
+#define DISPLAYMANAGER_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+
+#include <new>
+
+#include "animPlayer.h"
+
+static const uint8_t displayBusCount = 2;
+static const uint8_t displayPanelMax = 2 * displayBusCount; // 0x3C and 0x3D on each bus
+static const uint8_t displayFramesPerAnim = 30;
+static const uint16_t displayFlushStack = 3072;
+
+struct DisplayManager;
+
+// one I2C controller and the task flushing its panels
+struct DisplayBus
+{
+    DisplayManager *manager;
+    TwoWire *wire;
+    TaskHandle_t task;
+};
+
+// one panel and the animation it plays
+struct DisplayPanel
+{
+    AnimPanel panel;
+    uint8_t bus;
+    AnimCategory category;
+    bool present;  // answered at displayBegin(), something left to play
+    bool playing;  // asset loaded, screen begun
+    uint8_t next;  // registry index the next animation is searched from
+    AnimAsset asset;
+    AnimScreen screen;
+    uint32_t frame;
+    uint8_t framesLeft;
+    uint32_t frames; // drawn since displayBegin()
+    uint32_t nacks;  // flushes the panel did not acknowledge
+};
+
+struct DisplayManager
+{
+    DisplayPanel panels[displayPanelMax];
+    uint8_t count = 0;
+    DisplayBus buses[displayBusCount];
+    uint8_t busCount = 0;
+    bool tasks = false;           // every bus has its flush task
+    TaskHandle_t waiting = nullptr; // the task running displayStep()
+};
+
+// adds a panel playing category; the sketch owns oled, built with &wire
+static bool displayAdd(DisplayManager &dm, Adafruit_SSD1306 &oled, TwoWire &wire, uint8_t address,
+                       AnimCategory category)
+{
+    if (dm.count == displayPanelMax)
+    {
+        return false;
+    }
+    uint8_t bus = 0;
+    while (bus < dm.busCount && dm.buses[bus].wire != &wire)
+    {
+        bus++;
+    }
+    if (bus == displayBusCount)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < dm.count; i++)
+    {
+        if (dm.panels[i].bus == bus && dm.panels[i].panel.address == address)
+        {
+            return false;
+        }
+    }
+
+    uint8_t *caption;
+    {
+        MEM_SCOPE("caption");
+        caption = new (std::nothrow) uint8_t[(size_t)oled.width() * oled.height() / 8];
+    }
+    if (!caption)
+    {
+        return false;
+    }
+    if (bus == dm.busCount)
+    {
+        dm.buses[bus] = {&dm, &wire, nullptr};
+        dm.busCount++;
+    }
+
+    DisplayPanel &p = dm.panels[dm.count++];
+    p.panel = {&oled, &wire, address, caption, true, 0, {}};
+    p.bus = bus;
+    p.category = category;
+    p.present = false;
+    p.playing = false;
+    p.next = 0;
+    p.frame = 0;
+    p.framesLeft = 0;
+    p.frames = 0;
+    p.nacks = 0;
+    return true;
+}; // end displayAdd function
+
+// sends what the panels of the bus queued since the last flush
+static void displayFlushBus(DisplayManager &dm, uint8_t bus)
+{
+    for (uint8_t i = 0; i < dm.count; i++)
+    {
+        DisplayPanel &p = dm.panels[i];
+        if (p.bus != bus)
+        {
+            continue;
+        }
+        for (uint8_t q = 0; q < p.panel.queued; q++)
+        {
+            p.nacks += !oledFlushRegion(*p.panel.oled, *p.panel.wire, p.panel.address, p.panel.queue[q]);
+        }
+        p.panel.queued = 0;
+    }
+}; // end displayFlushBus function
+
+static void displayFlushTask(void *parameter)
+{
+    DisplayBus &bus = *(DisplayBus *)parameter;
+    uint8_t index = &bus - bus.manager->buses;
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        displayFlushBus(*bus.manager, index);
+        xTaskNotifyGive(bus.manager->waiting);
+    }
+}; // end displayFlushTask function
+
+// every bus flushed, side by side when the tasks run
+static void displayFlush(DisplayManager &dm)
+{
+    ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+    if (dm.tasks)
+    {
+        for (uint8_t b = 0; b < dm.busCount; b++)
+        {
+            xTaskNotifyGive(dm.buses[b].task);
+        }
+        // one notification back per bus
+        for (uint8_t b = 0; b < dm.busCount; b++)
+        {
+            ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        }
+        return;
+    }
+
+#ifdef ANIM_HOST_WIRE
+    hostWireOverlap();
+#endif
+    for (uint8_t b = 0; b < dm.busCount; b++)
+    {
+        displayFlushBus(dm, b);
+    }
+#ifdef ANIM_HOST_WIRE
+    hostWireJoin();
+#endif
+}; // end displayFlush function
+
+// starts the panels that answer and the flush tasks; the sketch has begun the buses with their pins
+static bool displayBegin(DisplayManager &dm)
+{
+    uint8_t present = 0;
+    for (uint8_t i = 0; i < dm.count; i++)
+    {
+        DisplayPanel &p = dm.panels[i];
+        TwoWire &wire = *p.panel.wire;
+        wire.beginTransmission(p.panel.address);
+        p.present = wire.endTransmission() == 0;
+        if (!p.present)
+        {
+            LOG_WARN("No panel at 0x%02X on I2C bus %u", p.panel.address, p.bus);
+            continue;
+        }
+        // a panel the sketch already started (the main display) keeps its buffer
+        if (!p.panel.oled->getBuffer())
+        {
+            MEM_SCOPE("display");
+            p.present = p.panel.oled->begin(SSD1306_SWITCHCAPVCC, p.panel.address, true, false);
+        }
+        present += p.present;
+    }
+
+    dm.waiting = xTaskGetCurrentTaskHandle();
+    dm.tasks = dm.busCount > 0;
+    for (uint8_t b = 0; b < dm.busCount; b++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "flushI2C%u", b);
+        // above the log drain, a burst of lines must not hold a flush back
+        if (!dm.buses[b].task)
+        {
+            if (xTaskCreatePinnedToCore(displayFlushTask, name, displayFlushStack, &dm.buses[b], tskIDLE_PRIORITY + 2,
+                                        &dm.buses[b].task, 0) == pdPASS)
+            {
+                memWatchTask(dm.buses[b].task);
+            }
+            else
+            {
+                dm.buses[b].task = nullptr;
+            }
+        }
+        dm.tasks = dm.tasks && dm.buses[b].task;
+    }
+    LOG_INFO("Displays: %u of %u panels on %u buses, flushed %s", present, dm.count, dm.busCount,
+             dm.tasks ? "by one task per bus" : "in turn");
+    return present == dm.count;
+}; // end displayBegin function
+
+// opens the next animation of the panel's category, false when none of them loads
+static bool displayNextAnim(DisplayPanel &p)
+{
+    for (uint8_t tried = 0; tried < animTotal; tried++)
+    {
+        const AnimDesc &anim = animRegistry[p.next];
+        p.next = (p.next + 1) % animTotal;
+        if (anim.category != p.category || !animOpen(anim, p.asset))
+        {
+            continue;
+        }
+        animBeginScreen(anim, p.asset.header, true, p.screen, p.panel);
+        memSample(anim.id);
+        p.playing = true;
+        p.frame = 0;
+        p.framesLeft = displayFramesPerAnim;
+        return true;
+    }
+    return false;
+}; // end displayNextAnim function
+
+// draws the next frame on every panel and flushes them, returns the frames shown
+static uint8_t displayStep(DisplayManager &dm)
+{
+    uint8_t shown = 0;
+    for (uint8_t i = 0; i < dm.count; i++)
+    {
+        DisplayPanel &p = dm.panels[i];
+        if (!p.present || (!p.playing && !displayNextAnim(p)))
+        {
+            if (p.present)
+            {
+                LOG_WARN("Display %u: no %s animation to play", i, animCategoryName(p.category));
+                p.present = false;
+            }
+            continue;
+        }
+
+        animDrawFrame(p.screen, p.asset, p.frame);
+        p.frame = (p.frame + 1) % p.asset.header.frameCount;
+        p.frames++;
+        shown++;
+        if (--p.framesLeft == 0)
+        {
+            // the frame is in the buffer already, the asset can go before the flush
+            unloadAnimation(p.asset);
+            p.playing = false;
+        }
+    }
+    displayFlush(dm);
+    return shown;
+}; // end displayStep function
+
+// stops the players and forgets the panels, which keep their last image; the buses and their tasks stay
+static void displayEnd(DisplayManager &dm)
+{
+    for (uint8_t i = 0; i < dm.count; i++)
+    {
+        DisplayPanel &p = dm.panels[i];
+        if (p.playing)
+        {
+            unloadAnimation(p.asset);
+            p.playing = false;
+        }
+        delete[] p.panel.caption;
+        p.panel.caption = nullptr;
+    }
+    dm.count = 0;
+}; // end displayEnd function
+
+#endif // DISPLAYMANAGER_H
@@ -0,0 +1,262 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: frameCodec.h
+//
+// Description:
+//
+// keyframe/delta codec for animation files (encoding ASSET_DELTA).
+// Every frame is coded as the XOR against the previous frame, with
+// runs of unchanged bytes skipped. Every K-th frame is a keyframe,
+// coded against a blank frame, and listed in a seek table, so any
+// frame is reached by decoding one keyframe and at most K-1 deltas.
+// K is chosen per asset when it is built (assetpack delta --key K):
+// small K seeks faster, large K gives smaller files.
+//
+// File layout after the 16 byte asset header (little endian):
+//   uint16  K, keyframe interval
+//   uint16  0
+//   uint32  keyframe count (frameCount + K - 1) / K
+//   uint32  file offset of each keyframe
+//   coded frames, each: uint16 length, then the ops
+//
+// Ops: 0nnnnnnn skip n+1 unchanged bytes,
+//      1nnnnnnn XOR the next n+1 bytes with the following n+1 literals
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef FRAMECODEC_H
+#define FRAMECODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "assetFormat.h"
+
+static const uint8_t deltaInfoSize = 8;
+static const uint32_t deltaNoFrame = 0xFFFFFFFFu;
+
+struct DeltaInfo
+{
+    uint16_t keyInterval;
+    uint32_t keyCount;
+    uint32_t seekTable; // file offset of the keyframe offsets
+};
+
+// largest coded frame including its length prefix
+// literal runs swallow single unchanged bytes, so a 1 byte skip only follows a full literal run
+inline uint32_t deltaMaxCodedBytes(uint32_t frameBytes)
+{
+    return 4 + frameBytes + 2 * ((frameBytes + 127) / 128);
+}
+
+// codes cur against prev (nullptr for a keyframe), returns the bytes written to out
+inline uint32_t deltaEncode(const uint8_t *prev, const uint8_t *cur, uint32_t n, uint8_t *out)
+{
+    uint32_t len = 2;
+    uint32_t i = 0;
+    while (i < n)
+    {
+        if ((prev ? prev[i] : 0) == cur[i])
+        {
+            uint32_t run = 1;
+            while (i + run < n && run < 128 && (prev ? prev[i + run] : 0) == cur[i + run])
+            {
+                run++;
+            }
+            // a trailing skip is implied by the frame size
+            if (i + run == n)
+            {
+                break;
+            }
+            out[len++] = run - 1;
+            i += run;
+            continue;
+        }
+
+        uint32_t j = i + 1;
+        while (j < n && j - i < 128)
+        {
+            if ((prev ? prev[j] : 0) != cur[j])
+            {
+                j++;
+            }
+            else if (j + 1 < n && j + 1 - i < 128 && (prev ? prev[j + 1] : 0) != cur[j + 1])
+            {
+                j += 2; // cheaper to copy one unchanged byte than to skip it
+            }
+            else
+            {
+                break;
+            }
+        }
+        out[len++] = 0x80 | (j - i - 1);
+        for (uint32_t k = i; k < j; k++)
+        {
+            out[len++] = cur[k] ^ (prev ? prev[k] : 0);
+        }
+        i = j;
+    }
+    out[0] = (len - 2) & 0xFF;
+    out[1] = (len - 2) >> 8;
+    return len;
+}
+
+// applies the ops of one coded frame (without its length prefix) to frame
+// returns false when the ops are malformed or run past the frame
+inline bool deltaApply(const uint8_t *ops, uint32_t len, uint8_t *frame, uint32_t n)
+{
+    uint32_t pos = 0;
+    uint32_t i = 0;
+    while (i < len)
+    {
+        uint8_t op = ops[i++];
+        uint32_t run = (op & 0x7F) + 1;
+        if (pos + run > n)
+        {
+            return false;
+        }
+        if (op & 0x80)
+        {
+            if (i + run > len)
+            {
+                return false;
+            }
+            for (uint32_t k = 0; k < run; k++)
+            {
+                frame[pos + k] ^= ops[i + k];
+            }
+            i += run;
+        }
+        pos += run;
+    }
+    return true;
+}
+
+inline uint16_t deltaRead16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+inline uint32_t deltaRead32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// reads the codec info found right after the asset header
+inline bool deltaParseInfo(const AssetHeader &header, const uint8_t *buf, size_t len, DeltaInfo &info)
+{
+    if (len < deltaInfoSize)
+    {
+        return false;
+    }
+    info.keyInterval = deltaRead16(buf);
+    info.keyCount = deltaRead32(buf + 4);
+    info.seekTable = assetHeaderSize + deltaInfoSize;
+    return info.keyInterval > 0 && header.frameCount > 0 &&
+           info.keyCount == ((uint64_t)header.frameCount + info.keyInterval - 1) / info.keyInterval;
+}
+
+// a file of fileSize bytes must hold the seek table and at least the length prefix of every frame
+inline bool deltaFits(const AssetHeader &header, const DeltaInfo &info, uint32_t fileSize)
+{
+    return (uint64_t)info.seekTable + (uint64_t)info.keyCount * 4 + (uint64_t)header.frameCount * 2 <= fileSize;
+}
+
+// gives access to len bytes at a file offset, nullptr when out of range
+typedef const uint8_t *(*DeltaFetch)(void *ctx, uint32_t offset, uint32_t len);
+
+// decoding position: the frame in the buffer and where the next coded frame starts
+struct DeltaCursor
+{
+    uint8_t *frame;
+    uint32_t frameBytes;
+    uint32_t current;
+    uint32_t next;
+};
+
+inline void deltaReset(DeltaCursor &cursor)
+{
+    cursor.current = deltaNoFrame;
+    cursor.next = 0;
+}
+
+// decodes the coded frame at cursor.next as frame number index
+inline bool deltaStep(const DeltaInfo &info, DeltaCursor &cursor, uint32_t index, DeltaFetch fetch, void *ctx)
+{
+    const uint8_t *prefix = fetch(ctx, cursor.next, 2);
+    if (!prefix)
+    {
+        return false;
+    }
+    uint16_t len = deltaRead16(prefix);
+    const uint8_t *ops = fetch(ctx, cursor.next + 2, len);
+    if (!ops)
+    {
+        return false;
+    }
+    if (index % info.keyInterval == 0)
+    {
+        memset(cursor.frame, 0, cursor.frameBytes);
+    }
+    if (!deltaApply(ops, len, cursor.frame, cursor.frameBytes))
+    {
+        return false;
+    }
+    cursor.current = index;
+    cursor.next += 2 + len;
+    return true;
+}
+
+// brings the cursor to the target frame, decoding at most keyInterval frames
+inline bool deltaSeek(const AssetHeader &header, const DeltaInfo &info, DeltaCursor &cursor, uint32_t target,
+                      DeltaFetch fetch, void *ctx)
+{
+    if (target >= header.frameCount)
+    {
+        return false;
+    }
+    if (cursor.current == target)
+    {
+        return true;
+    }
+
+    uint32_t index;
+    bool sameGroup = cursor.current != deltaNoFrame && cursor.current < target &&
+                     cursor.current / info.keyInterval == target / info.keyInterval;
+    if (sameGroup || (cursor.current != deltaNoFrame && cursor.current + 1 == target))
+    {
+        // keep going forward from the frame already decoded
+        index = cursor.current + 1;
+    }
+    else
+    {
+        uint32_t key = target / info.keyInterval;
+        const uint8_t *entry = fetch(ctx, info.seekTable + key * 4, 4);
+        if (!entry)
+        {
+            return false;
+        }
+        cursor.next = deltaRead32(entry);
+        index = key * info.keyInterval;
+    }
+
+    for (; index <= target; index++)
+    {
+        if (!deltaStep(info, cursor, index, fetch, ctx))
+        {
+            deltaReset(cursor);
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // FRAMECODEC_H
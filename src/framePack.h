@@ -0,0 +1,271 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: framePack.h
+//
+// Description:
+//
+// content addressed animation pack (/anims.pak). Every distinct frame
+// is stored once, each animation only keeps a table of frame ids, so
+// blank lead-in frames, held poses and loops back to the first frame
+// cost 2 bytes instead of a whole frame. Built on the host by
+// tools/assetpack.cpp ("assetpack pack").
+//
+// Layout (little endian), everything before the frame data is the
+// directory, small enough to be kept in RAM:
+//   header       16 bytes  "OBAP", version, 0, anim count (u16),
+//                          unique frame count (u32), offset table (u32)
+//   anim entries 48 bytes  name[32], width, height, stride (u16),
+//                          encoding, 0, frame count (u32), id table (u32)
+//                          (raw, or sparse: frames cropped to their box)
+//   id tables              u16 unique frame id per animation frame
+//   offset table           u32 file offset per unique frame
+//   frame data
+//
+// Also holds the LRU frame cache shared by every packed animation,
+// a frame used by several animations is read from the card once.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef FRAMEPACK_H
+#define FRAMEPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+
+#include "assetFormat.h"
+
+static const uint8_t packMagic[4] = {'O', 'B', 'A', 'P'};
+static const uint8_t packVersion = 1;
+static const uint8_t packHeaderSize = 16;
+static const uint8_t packEntrySize = 48;
+static const uint8_t packNameMax = 32;
+
+struct FramePackDir
+{
+    const uint8_t *dir;
+    uint32_t dirSize; // offset of the first frame in the file
+    uint16_t animCount;
+    uint32_t uniqueCount;
+    uint32_t offsetTable;
+};
+
+struct PackEntry
+{
+    const char *name;
+    AssetHeader header;
+    uint32_t idTable;
+};
+
+inline uint16_t packRead16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+inline uint32_t packRead32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline void packWrite16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+inline void packWrite32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+// size of the directory, read from the first packHeaderSize bytes, 0 when not a pack
+inline uint32_t packDirSize(const uint8_t *buf, size_t len)
+{
+    if (len < packHeaderSize || memcmp(buf, packMagic, 4) != 0 || buf[4] != packVersion)
+    {
+        return 0;
+    }
+    uint64_t size = (uint64_t)packRead32(buf + 12) + (uint64_t)packRead32(buf + 8) * 4;
+    return size > 0xFFFFFFFFu ? 0 : (uint32_t)size;
+}
+
+inline void packEntry(const FramePackDir &pack, uint16_t anim, PackEntry &entry)
+{
+    const uint8_t *p = pack.dir + packHeaderSize + anim * packEntrySize;
+    entry.name = (const char *)p;
+    entry.header.version = assetVersion;
+    entry.header.width = packRead16(p + 32);
+    entry.header.height = packRead16(p + 34);
+    entry.header.stride = packRead16(p + 36);
+    entry.header.encoding = p[38];
+    entry.header.frameCount = packRead32(p + 40);
+    entry.idTable = packRead32(p + 44);
+}
+
+// checks the whole directory, later lookups do not need bounds checks
+inline bool packParseDir(const uint8_t *buf, size_t len, FramePackDir &pack)
+{
+    uint32_t dirSize = packDirSize(buf, len);
+    if (dirSize == 0 || dirSize > len)
+    {
+        return false;
+    }
+
+    pack.dir = buf;
+    pack.dirSize = dirSize;
+    pack.animCount = packRead16(buf + 6);
+    pack.uniqueCount = packRead32(buf + 8);
+    pack.offsetTable = packRead32(buf + 12);
+
+    if (pack.uniqueCount > 0x10000 || packHeaderSize + (uint32_t)pack.animCount * packEntrySize > pack.offsetTable)
+    {
+        return false;
+    }
+
+    for (uint16_t a = 0; a < pack.animCount; a++)
+    {
+        PackEntry entry;
+        packEntry(pack, a, entry);
+        if (memchr(entry.name, 0, packNameMax) == nullptr || entry.header.width == 0 || entry.header.height == 0 ||
+            (entry.header.encoding != ASSET_RAW && entry.header.encoding != ASSET_SPARSE) ||
+            entry.header.stride < assetMinStride(entry.header.width) ||
+            entry.idTable < packHeaderSize + (uint32_t)pack.animCount * packEntrySize ||
+            (uint64_t)entry.idTable + (uint64_t)entry.header.frameCount * 2 > pack.offsetTable)
+        {
+            return false;
+        }
+        for (uint32_t f = 0; f < entry.header.frameCount; f++)
+        {
+            if (packRead16(buf + entry.idTable + f * 2) >= pack.uniqueCount)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline int16_t packFind(const FramePackDir &pack, const char *name)
+{
+    for (uint16_t a = 0; a < pack.animCount; a++)
+    {
+        if (strncmp((const char *)pack.dir + packHeaderSize + a * packEntrySize, name, packNameMax) == 0)
+        {
+            return a;
+        }
+    }
+    return -1;
+}
+
+inline uint16_t packFrameId(const FramePackDir &pack, const PackEntry &entry, uint32_t frame)
+{
+    return packRead16(pack.dir + entry.idTable + frame * 2);
+}
+
+inline uint32_t packFrameOffset(const FramePackDir &pack, uint16_t id)
+{
+    return packRead32(pack.dir + pack.offsetTable + id * 4);
+}
+
+// least recently used cache of frames, keyed by unique frame id
+struct FrameCache
+{
+    uint8_t slots;
+    uint32_t slotBytes;
+    uint8_t *pool;
+    uint32_t *keys;
+    uint32_t *used;
+    uint32_t tick;
+    uint32_t hits;
+    uint32_t misses;
+};
+
+static const uint32_t frameCacheEmpty = 0xFFFFFFFFu;
+
+inline void frameCacheEnd(FrameCache &cache)
+{
+    delete[] cache.pool;
+    delete[] cache.keys;
+    delete[] cache.used;
+    cache.pool = nullptr;
+    cache.keys = nullptr;
+    cache.used = nullptr;
+    cache.slots = 0;
+}
+
+// false when the heap cannot hold slots frames, the cache is then left empty
+inline bool frameCacheBegin(FrameCache &cache, uint8_t slots, uint32_t slotBytes)
+{
+    cache.slots = slots;
+    cache.slotBytes = slotBytes;
+    cache.pool = new (std::nothrow) uint8_t[(size_t)slots * slotBytes];
+    cache.keys = new (std::nothrow) uint32_t[slots];
+    cache.used = new (std::nothrow) uint32_t[slots];
+    cache.tick = 0;
+    cache.hits = 0;
+    cache.misses = 0;
+    if (!cache.pool || !cache.keys || !cache.used)
+    {
+        frameCacheEnd(cache);
+        return false;
+    }
+    for (uint8_t i = 0; i < slots; i++)
+    {
+        cache.keys[i] = frameCacheEmpty;
+        cache.used[i] = 0;
+    }
+    return true;
+}
+
+// returns the slot holding the key, hit is false when the caller has to fill it
+inline uint8_t *frameCacheGet(FrameCache &cache, uint32_t key, bool &hit)
+{
+    uint8_t victim = 0;
+    cache.tick++;
+    for (uint8_t i = 0; i < cache.slots; i++)
+    {
+        if (cache.keys[i] == key)
+        {
+            cache.used[i] = cache.tick;
+            cache.hits++;
+            hit = true;
+            return cache.pool + (size_t)i * cache.slotBytes;
+        }
+        if (cache.used[i] < cache.used[victim])
+        {
+            victim = i;
+        }
+    }
+
+    cache.keys[victim] = key;
+    cache.used[victim] = cache.tick;
+    cache.misses++;
+    hit = false;
+    return cache.pool + (size_t)victim * cache.slotBytes;
+}
+
+// drops a slot whose fill failed so it is not served later
+inline void frameCacheDrop(FrameCache &cache, uint32_t key)
+{
+    for (uint8_t i = 0; i < cache.slots; i++)
+    {
+        if (cache.keys[i] == key)
+        {
+            cache.keys[i] = frameCacheEmpty;
+            cache.used[i] = 0;
+        }
+    }
+}
+
+#endif // FRAMEPACK_H
@@ -0,0 +1,79 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: frameRegion.h
+//
+// Description:
+//
+// screen rectangles used to clear, draw and flush only the part of
+// the display an animation frame changes. The SSD1306 is written in
+// pages of 8 rows, so a flush covers whole pages of the rectangle.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef FRAMEREGION_H
+#define FRAMEREGION_H
+
+#include <stdint.h>
+
+// x0/y0 inclusive, x1/y1 exclusive
+struct FrameRect
+{
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+};
+
+static const FrameRect frameRectEmpty = {0, 0, 0, 0};
+
+inline bool frameRectIsEmpty(const FrameRect &r)
+{
+    return r.x1 <= r.x0 || r.y1 <= r.y0;
+}
+
+inline FrameRect frameRectUnion(const FrameRect &a, const FrameRect &b)
+{
+    if (frameRectIsEmpty(a))
+    {
+        return b;
+    }
+    if (frameRectIsEmpty(b))
+    {
+        return a;
+    }
+    FrameRect r;
+    r.x0 = a.x0 < b.x0 ? a.x0 : b.x0;
+    r.y0 = a.y0 < b.y0 ? a.y0 : b.y0;
+    r.x1 = a.x1 > b.x1 ? a.x1 : b.x1;
+    r.y1 = a.y1 > b.y1 ? a.y1 : b.y1;
+    return r;
+}
+
+inline FrameRect frameRectClip(const FrameRect &r, int16_t width, int16_t height)
+{
+    FrameRect c;
+    c.x0 = r.x0 < 0 ? 0 : r.x0;
+    c.y0 = r.y0 < 0 ? 0 : r.y0;
+    c.x1 = r.x1 > width ? width : r.x1;
+    c.y1 = r.y1 > height ? height : r.y1;
+    return frameRectIsEmpty(c) ? frameRectEmpty : c;
+}
+
+// bytes sent to the display when flushing the rectangle, whole pages of 8 rows
+inline uint32_t frameRectFlushBytes(const FrameRect &r)
+{
+    if (frameRectIsEmpty(r))
+    {
+        return 0;
+    }
+    return (uint32_t)(r.x1 - r.x0) * ((r.y1 - 1) / 8 - r.y0 / 8 + 1);
+}
+
+#endif // FRAMEREGION_H
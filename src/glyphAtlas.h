@@ -0,0 +1,250 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: glyphAtlas.h
+//
+// Description:
+//
+// pre-rendered glyphs for the captions and the text drawn on every
+// frame. u8g2 decodes its compressed font glyph by glyph, pixel by
+// pixel, on every drawStr(); the atlas keeps the glyphs of the
+// characters in use already decoded, side by side in one strip in the
+// SSD1306 page layout (one byte per column and page, bit 0 on top).
+//
+// The strip is filled once at boot from glyphs drawn into a page
+// buffer with their top on row 0 (see animAtlasBegin() in
+// animPlayer.h). Each glyph keeps its advance columns and the rows
+// from the font ascent to the descent; ink outside is cut.
+//
+// glyphAtlasDraw() first copies the columns of the string out of the
+// strip, then ORs them into the page buffer eight columns at a time:
+// a 64 bit word shifted down by the distance to the page boundary,
+// with the bits crossing from one byte lane into the next masked off.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <new>
+
+static const uint8_t glyphFirst = ' ';
+static const uint8_t glyphLast = '~';
+static const uint8_t glyphCount = glyphLast - glyphFirst + 1;
+static const uint8_t glyphNone = 0xFF;
+static const uint8_t glyphPagesMax = 3;  // fonts up to 24 rows
+static const uint16_t glyphRunMax = 128; // columns drawn per call, the width of the panel
+
+struct GlyphAtlas
+{
+    uint8_t ascent; // rows above the baseline, row 0 of the strip
+    uint8_t pages;  // strip height
+    uint8_t count;  // glyphs in the strip
+    uint16_t columns;
+    uint8_t slot[glyphCount];     // index of each character in the strip, glyphNone when missing
+    uint16_t offset[glyphCount];  // first strip column, per slot
+    uint8_t width[glyphCount];    // advance, per slot
+    uint8_t *strip;               // pages rows of columns bytes
+};
+
+inline uint8_t glyphAtlasSlot(const GlyphAtlas &atlas, char c)
+{
+    uint8_t code = (uint8_t)c;
+    return code >= glyphFirst && code <= glyphLast ? atlas.slot[code - glyphFirst] : glyphNone;
+}
+
+// empty atlas for a font of the given ascent and descent (rows below the baseline)
+inline bool glyphAtlasBegin(GlyphAtlas &atlas, uint8_t ascent, uint8_t descent)
+{
+    atlas.ascent = ascent;
+    atlas.pages = (ascent + descent + 7) / 8;
+    atlas.count = 0;
+    atlas.columns = 0;
+    atlas.strip = nullptr;
+    memset(atlas.slot, glyphNone, sizeof(atlas.slot));
+    return atlas.pages > 0 && atlas.pages <= glyphPagesMax;
+}
+
+// makes room for a character of the given advance, before glyphAtlasAllocate()
+inline bool glyphAtlasReserve(GlyphAtlas &atlas, char c, uint8_t width)
+{
+    uint8_t code = (uint8_t)c;
+    if (code < glyphFirst || code > glyphLast || atlas.strip)
+    {
+        return false;
+    }
+    if (atlas.slot[code - glyphFirst] == glyphNone)
+    {
+        atlas.slot[code - glyphFirst] = atlas.count;
+        atlas.offset[atlas.count] = atlas.columns;
+        atlas.width[atlas.count] = width;
+        atlas.count++;
+        atlas.columns += width;
+    }
+    return true;
+}
+
+inline bool glyphAtlasAllocate(GlyphAtlas &atlas)
+{
+    atlas.strip = new (std::nothrow) uint8_t[atlas.pages * atlas.columns + 1];
+    if (atlas.strip)
+    {
+        memset(atlas.strip, 0, atlas.pages * atlas.columns + 1);
+    }
+    return atlas.strip != nullptr;
+}
+
+inline void glyphAtlasFree(GlyphAtlas &atlas)
+{
+    delete[] atlas.strip;
+    atlas.strip = nullptr;
+    atlas.count = 0;
+    atlas.columns = 0;
+    memset(atlas.slot, glyphNone, sizeof(atlas.slot));
+}
+
+// copies a reserved glyph drawn at column x with its top on row 0 of the page buffer
+inline void glyphAtlasCapture(GlyphAtlas &atlas, char c, const uint8_t *buffer, int16_t bufWidth, int16_t x)
+{
+    uint8_t s = glyphAtlasSlot(atlas, c);
+    if (s == glyphNone || !atlas.strip)
+    {
+        return;
+    }
+    for (uint8_t page = 0; page < atlas.pages; page++)
+    {
+        for (uint8_t col = 0; col < atlas.width[s]; col++)
+        {
+            int16_t from = x + col;
+            atlas.strip[page * atlas.columns + atlas.offset[s] + col] =
+                from >= 0 && from < bufWidth ? buffer[page * bufWidth + from] : 0;
+        }
+    }
+}
+
+// true when every character of text is in the atlas
+inline bool glyphAtlasCovers(const GlyphAtlas &atlas, const char *text)
+{
+    if (!atlas.strip)
+    {
+        return false;
+    }
+    for (; *text; text++)
+    {
+        if (glyphAtlasSlot(atlas, *text) == glyphNone)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// pixels the text advances, characters missing from the atlas count for nothing
+inline uint16_t glyphAtlasWidth(const GlyphAtlas &atlas, const char *text)
+{
+    uint16_t width = 0;
+    for (; *text; text++)
+    {
+        uint8_t s = glyphAtlasSlot(atlas, *text);
+        width += s == glyphNone ? 0 : atlas.width[s];
+    }
+    return width;
+}
+
+// one byte lane mask repeated over the 8 columns of a word
+inline uint64_t glyphLanes(uint8_t lane)
+{
+    return 0x0101010101010101ull * lane;
+}
+
+// ORs text with its baseline on row y into the page buffer, clipped to the buffer; returns its width
+inline uint16_t glyphAtlasDraw(const GlyphAtlas &atlas, const char *text, uint8_t *buffer, int16_t bufWidth,
+                               int16_t bufHeight, int16_t x, int16_t y)
+{
+    // the columns of the string, strip page by strip page, plus an empty page above the first
+    uint8_t run[glyphPagesMax + 1][glyphRunMax];
+    int16_t left = x < 0 ? 0 : x;
+    int16_t end = x + glyphAtlasWidth(atlas, text);
+    end = end < bufWidth ? end : bufWidth;
+    end = end < left + glyphRunMax ? end : left + glyphRunMax;
+    for (uint8_t page = 0; end > left && page <= atlas.pages; page++)
+    {
+        memset(run[page], 0, end - left);
+    }
+    int16_t right = left;
+    uint16_t width = 0;
+    for (; *text; text++)
+    {
+        uint8_t s = glyphAtlasSlot(atlas, *text);
+        if (s == glyphNone || !atlas.strip)
+        {
+            continue;
+        }
+        // the part of the glyph inside the buffer and the run
+        int16_t from = x + width < left ? left - (x + width) : 0;
+        int16_t to = atlas.width[s];
+        if (x + width + to > bufWidth)
+        {
+            to = bufWidth - (x + width);
+        }
+        if (x + width + to > left + glyphRunMax)
+        {
+            to = left + glyphRunMax - (x + width);
+        }
+        for (uint8_t page = 0; from < to && page < atlas.pages; page++)
+        {
+            memcpy(&run[page + 1][x + width + from - left], &atlas.strip[page * atlas.columns + atlas.offset[s] + from],
+                   to - from);
+        }
+        right = from < to ? x + width + to : right;
+        width += atlas.width[s];
+    }
+
+    // page and shift of the top row, rounding down above the buffer too
+    int16_t top = y - atlas.ascent;
+    int16_t page = top >= 0 ? top / 8 : -((7 - top) / 8);
+    uint8_t shift = top - page * 8;
+    uint64_t lowLanes = glyphLanes((uint8_t)(0xFF << shift));
+    uint64_t highLanes = glyphLanes(0xFF >> (8 - shift));
+    uint8_t rows = atlas.pages + (shift ? 1 : 0);
+    int16_t pages = bufHeight / 8;
+    for (uint8_t r = 0; r < rows; r++)
+    {
+        // destination page r takes strip page r shifted down and what strip page r - 1 pushed over
+        int16_t dst = page + r;
+        if (dst < 0 || dst >= pages)
+        {
+            continue;
+        }
+        const uint8_t *lower = r < atlas.pages ? run[r + 1] : run[0];
+        const uint8_t *upper = run[r];
+        uint8_t *out = buffer + dst * bufWidth + left;
+        int16_t col = 0;
+        for (; col + 8 <= right - left; col += 8)
+        {
+            uint64_t low, high, word;
+            memcpy(&low, lower + col, 8);
+            memcpy(&high, upper + col, 8);
+            memcpy(&word, out + col, 8);
+            word |= ((low << shift) & lowLanes) | ((high >> (8 - shift)) & highLanes);
+            memcpy(out + col, &word, 8);
+        }
+        for (; col < right - left; col++)
+        {
+            out[col] |= (uint8_t)(lower[col] << shift) | (uint8_t)(upper[col] >> (8 - shift));
+        }
+    }
+    return width;
+}
+
+#endif // GLYPHATLAS_H
@@ -0,0 +1,291 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1327 128x128 (4 bit grayscale, I2C)
+//
+// File: grayPanel.h
+//
+// Description:
+//
+// frame buffer and flush of the 4 bit grayscale panels (SSD1327, and
+// the SSD1322 class with the same data format): two pixels per byte,
+// the left one in the high nibble, rows of width / 2 bytes. A full
+// 128x128 frame is 8 KB instead of the 1 KB of the SSD1306, so only
+// windows are sent: grayFlushRegion() sets the column (0x15, in pairs
+// of pixels) and row (0x75) window of the panel and streams the bytes
+// of the rectangle, filled up to the chunk size across row ends like
+// oledFlushRegion().
+//
+// The 1 bit assets are expanded through a 256 entry table built by
+// grayLevels(): one source byte (8 pixels) gives the 4 bytes of its 8
+// nibbles, the lit pixels at the on level and the others at the off
+// level, so a row of a 48 pixel wide frame is 6 table reads. Unlit
+// pixels are written too, the player clears the dirty box first anyway.
+// The fast path needs an even x and whole source bytes inside the
+// buffer, anything else goes pixel by pixel. Native 4 bit assets
+// (ASSET_GRAY4 of assetFormat.h) are copied row by row.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef GRAYPANEL_H
+#define GRAYPANEL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <new>
+
+#include "frameRegion.h"
+#include "i2cTiming.h"
+#include "oledFlush.h"
+
+#define SSD1327_COLUMNADDR 0x15
+#define SSD1327_ROWADDR 0x75
+
+struct GrayPanel
+{
+    int16_t width;
+    int16_t height;
+    uint8_t *buffer; // height rows of width / 2 bytes
+    TwoWire *wire;
+    uint8_t address;
+    uint8_t on;  // level of the lit pixels of 1 bit assets, 0 to 15
+    uint8_t off; // and of the unlit ones
+    uint32_t expand[256]; // 8 pixels of a 1 bit row to their 4 bytes, in memory order
+};
+
+inline uint16_t grayRowBytes(const GrayPanel &panel)
+{
+    return panel.width / 2;
+}
+
+inline uint8_t grayPixel(const GrayPanel &panel, int16_t x, int16_t y)
+{
+    uint8_t b = panel.buffer[y * grayRowBytes(panel) + x / 2];
+    return x & 1 ? b & 0x0F : b >> 4;
+}
+
+inline void graySetPixel(GrayPanel &panel, int16_t x, int16_t y, uint8_t level)
+{
+    if (x < 0 || y < 0 || x >= panel.width || y >= panel.height)
+    {
+        return;
+    }
+    uint8_t &b = panel.buffer[y * grayRowBytes(panel) + x / 2];
+    b = x & 1 ? (b & 0xF0) | (level & 0x0F) : (b & 0x0F) | (level << 4);
+}
+
+// levels of the lit and unlit pixels of 1 bit assets
+static void grayLevels(GrayPanel &panel, uint8_t on, uint8_t off)
+{
+    panel.on = on & 0x0F;
+    panel.off = off & 0x0F;
+    for (uint16_t bits = 0; bits < 256; bits++)
+    {
+        uint8_t out[4];
+        for (uint8_t pair = 0; pair < 4; pair++)
+        {
+            // MSB first: bit 7 is the leftmost pixel, the high nibble of out[0]
+            uint8_t left = bits & (0x80 >> (2 * pair)) ? panel.on : panel.off;
+            uint8_t right = bits & (0x40 >> (2 * pair)) ? panel.on : panel.off;
+            out[pair] = (left << 4) | right;
+        }
+        memcpy(&panel.expand[bits], out, sizeof(out));
+    }
+}; // end grayLevels function
+
+static void grayCommands(GrayPanel &panel, const uint8_t *commands, uint8_t count)
+{
+    panel.wire->beginTransmission(panel.address);
+    panel.wire->write((uint8_t)0x00);
+    panel.wire->write(commands, count);
+    panel.wire->endTransmission();
+}; // end grayCommands function
+
+// allocates the buffer and starts the panel, false when there is no memory or no answer
+static bool grayBegin(GrayPanel &panel, int16_t width, int16_t height, TwoWire &wire, uint8_t address)
+{
+    panel.width = width & ~1;
+    panel.height = height;
+    panel.wire = &wire;
+    panel.address = address;
+    panel.buffer = new (std::nothrow) uint8_t[(size_t)grayRowBytes(panel) * height];
+    if (!panel.buffer)
+    {
+        return false;
+    }
+    memset(panel.buffer, 0, (size_t)grayRowBytes(panel) * height);
+    grayLevels(panel, 15, 0);
+
+    wire.beginTransmission(address);
+    if (wire.endTransmission() != 0)
+    {
+        return false;
+    }
+    // remap 0x51: the left pixel of each byte in the high nibble, COM split, top row first
+    static const uint8_t init[] = {0xAE, 0xA0, 0x51, 0xA1, 0x00, 0xA2, 0x00, 0xA4, 0xA8, 0x7F, 0xAB, 0x01,
+                                   0xB1, 0xF1, 0xB3, 0x00, 0xB6, 0x0F, 0xBC, 0x08, 0xBE, 0x07, 0x81, 0x7F,
+                                   0xD5, 0x62, 0xAF};
+    grayCommands(panel, init, sizeof(init));
+    return true;
+}; // end grayBegin function
+
+static void grayEnd(GrayPanel &panel)
+{
+    delete[] panel.buffer;
+    panel.buffer = nullptr;
+}; // end grayEnd function
+
+// sets the pixels of the rectangle to the level
+static void grayFill(GrayPanel &panel, const FrameRect &region, uint8_t level)
+{
+    FrameRect r = frameRectClip(region, panel.width, panel.height);
+    for (int16_t y = r.y0; y < r.y1; y++)
+    {
+        int16_t x = r.x0;
+        if (x & 1 && x < r.x1)
+        {
+            graySetPixel(panel, x++, y, level);
+        }
+        int16_t pairs = (r.x1 - x) / 2;
+        memset(&panel.buffer[y * grayRowBytes(panel) + x / 2], level * 0x11, pairs);
+        if (x + 2 * pairs < r.x1)
+        {
+            graySetPixel(panel, r.x1 - 1, y, level);
+        }
+    }
+}; // end grayFill function
+
+// 1 bit row major bitmap, MSB first as drawn by drawBitmap, expanded to the on and off levels
+static void grayDrawMono(GrayPanel &panel, int16_t x, int16_t y, const uint8_t *bitmap, uint16_t width,
+                         uint16_t height, uint16_t stride)
+{
+    uint16_t rowBytes = grayRowBytes(panel);
+    for (uint16_t row = 0; row < height; row++)
+    {
+        int16_t dy = y + row;
+        if (dy < 0 || dy >= panel.height)
+        {
+            continue;
+        }
+        const uint8_t *src = bitmap + (uint32_t)row * stride;
+        // whole source bytes landing inside the buffer at an even column, 4 bytes each from the table
+        uint16_t first = 0;
+        uint16_t last = width / 8;
+        if (!(x & 1))
+        {
+            first = x < 0 ? (-x + 7) / 8 : 0;
+            int32_t room = (panel.width - x) / 8;
+            last = room < last ? (room > 0 ? room : 0) : last;
+        }
+        else
+        {
+            last = 0;
+        }
+        uint8_t *dst = panel.buffer + dy * rowBytes;
+        for (uint16_t b = first; b < last; b++)
+        {
+            memcpy(dst + (x + b * 8) / 2, &panel.expand[src[b]], 4);
+        }
+        // the rest pixel by pixel: partial bytes, clipped columns, odd x
+        for (uint16_t col = 0; col < width; col++)
+        {
+            if (col < first * 8 || col >= last * 8)
+            {
+                bool lit = src[col / 8] & (0x80 >> (col & 7));
+                graySetPixel(panel, x + col, dy, lit ? panel.on : panel.off);
+            }
+        }
+    }
+}; // end grayDrawMono function
+
+// 4 bit row major bitmap, the left pixel in the high nibble (ASSET_GRAY4)
+static void grayDrawGray(GrayPanel &panel, int16_t x, int16_t y, const uint8_t *pixels, uint16_t width,
+                         uint16_t height, uint16_t stride)
+{
+    uint16_t rowBytes = grayRowBytes(panel);
+    int16_t x0 = x < 0 ? -x : 0;
+    int16_t x1 = x + width > panel.width ? panel.width - x : width;
+    for (uint16_t row = 0; row < height && x0 < x1; row++)
+    {
+        int16_t dy = y + row;
+        if (dy < 0 || dy >= panel.height)
+        {
+            continue;
+        }
+        const uint8_t *src = pixels + (uint32_t)row * stride;
+        int16_t col = x0;
+        if (!(x & 1))
+        {
+            // pairs of pixels already line up with the buffer bytes
+            int16_t from = (col + 1) & ~1;
+            if (col < from)
+            {
+                graySetPixel(panel, x + col, dy, src[col / 2] & 0x0F);
+            }
+            int16_t pairs = (x1 - from) / 2;
+            memcpy(panel.buffer + dy * rowBytes + (x + from) / 2, src + from / 2, pairs);
+            col = from + 2 * pairs;
+        }
+        for (; col < x1; col++)
+        {
+            uint8_t b = src[col / 2];
+            graySetPixel(panel, x + col, dy, col & 1 ? b & 0x0F : b >> 4);
+        }
+    }
+}; // end grayDrawGray function
+
+// sends the bytes of the rectangle, widened to whole pixel pairs; false when the panel did not acknowledge
+static bool grayFlushRegion(GrayPanel &panel, const FrameRect &region, uint16_t chunk = oledWireChunk)
+{
+    FrameRect r = frameRectClip(region, panel.width, panel.height);
+    if (frameRectIsEmpty(r))
+    {
+        return true;
+    }
+    uint8_t col0 = r.x0 / 2;
+    uint8_t col1 = (r.x1 - 1) / 2;
+    const uint8_t window[] = {SSD1327_COLUMNADDR, col0, col1, SSD1327_ROWADDR, (uint8_t)r.y0, (uint8_t)(r.y1 - 1)};
+
+    TwoWire &wire = *panel.wire;
+    uint32_t restoreClock = wire.getClock();
+    wire.setClock(oledWireClock);
+    grayCommands(panel, window, sizeof(window));
+
+    uint16_t payload = i2cChunkPayload(chunk);
+    uint16_t inChunk = 0;
+    bool acked = true;
+    for (int16_t y = r.y0; y < r.y1; y++)
+    {
+        const uint8_t *src = panel.buffer + y * grayRowBytes(panel) + col0;
+        int16_t left = col1 - col0 + 1;
+        while (left > 0)
+        {
+            if (inChunk == 0)
+            {
+                wire.beginTransmission(panel.address);
+                wire.write((uint8_t)0x40);
+            }
+            int16_t n = left < payload - inChunk ? left : payload - inChunk;
+            wire.write(src, n);
+            src += n;
+            left -= n;
+            inChunk += n;
+            if (inChunk == payload)
+            {
+                acked &= wire.endTransmission() == 0;
+                inChunk = 0;
+            }
+        }
+    }
+    if (inChunk)
+    {
+        acked &= wire.endTransmission() == 0;
+    }
+    wire.setClock(restoreClock);
+    return acked;
+}; // end grayFlushRegion function
+
+#endif // GRAYPANEL_H
@@ -0,0 +1,136 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: i2cBench.h
+//
+// Description:
+//
+// transport benchmark of the panel, built in with -DI2C_BENCH (see
+// platformio.ini) and run once from setup(). Sends the whole display
+// buffer through oledFlushRegion() at every SCL clock of
+// i2cBenchClocks and every chunk size of i2cBenchChunks, then prints
+// per combination the payload bytes/s, the cost of one transaction on
+// top of its payload bytes (start, address, control byte, stop and
+// the driver) and the failed transactions.
+//
+// A clock is stable when no transaction failed at any chunk size, the
+// highest stable clock is returned. The SSD1306 does not answer reads
+// over I2C, so failures show up as missing ACKs only: check the panel
+// too, a garbled picture during the sweep means the clock is too high.
+//
+// The same code runs against the host bus mock (tools/bench_i2c.cpp),
+// where the numbers follow the model of i2cTiming.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef I2CBENCH_H
+#define I2CBENCH_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+
+#include "asyncLog.h"
+#include "i2cTiming.h"
+#include "oledFlush.h"
+
+static const uint32_t i2cBenchClocks[] = {100000, 400000, 800000, 1000000};
+static const uint16_t i2cBenchChunks[] = {16, 32, 64, 128};
+static const uint8_t i2cBenchClockCount = sizeof(i2cBenchClocks) / sizeof(i2cBenchClocks[0]);
+static const uint8_t i2cBenchChunkCount = sizeof(i2cBenchChunks) / sizeof(i2cBenchChunks[0]);
+
+struct I2cBenchResult
+{
+    uint32_t clock;
+    uint16_t chunk;
+    uint32_t flushes;
+    uint32_t transactions; // data transactions, the window commands are not counted
+    uint32_t payloadBytes;
+    uint32_t failed;       // flushes with a transaction not acknowledged
+    uint32_t micros;
+    float bytesPerSecond;
+    float transactionMicros; // cost of a transaction beyond its 9 clocks per payload byte
+};
+
+// sends the display buffer flushes times at the given clock and chunk size
+static void i2cBenchRun(Adafruit_SSD1306 &oled, TwoWire &wire, uint8_t address, uint32_t clock, uint16_t chunk,
+                        uint32_t flushes, I2cBenchResult &result)
+{
+    uint32_t savedClock = oledWireClock;
+    oledWireClock = clock;
+
+    uint32_t payload = oled.width() * ((oled.height() + 7) / 8);
+    result = {clock, chunk, flushes, 0, 0, 0, 0, 0, 0};
+
+    // the window commands of each flush, timed on their own and left out of the transaction cost
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < flushes; i++)
+    {
+        static const uint8_t window[] = {SSD1306_PAGEADDR, 0, 7, SSD1306_COLUMNADDR, 0, 127};
+        for (uint8_t j = 0; j < sizeof(window); j++)
+        {
+            oled.ssd1306_command(window[j]);
+        }
+    }
+    uint32_t commandMicros = micros() - start;
+
+    start = micros();
+    for (uint32_t i = 0; i < flushes; i++)
+    {
+        if (!oledFlushRegion(oled, wire, address, {0, 0, oled.width(), oled.height()}, chunk))
+        {
+            result.failed++;
+        }
+    }
+    result.micros = micros() - start;
+    oledWireClock = savedClock;
+
+    result.transactions = flushes * i2cChunkTransactions(payload, chunk);
+    result.payloadBytes = flushes * payload;
+    if (result.micros)
+    {
+        result.bytesPerSecond = result.payloadBytes * 1e6f / result.micros;
+    }
+    float payloadMicros = result.payloadBytes * 9e6f / clock;
+    result.transactionMicros = ((float)result.micros - commandMicros - payloadMicros) / result.transactions;
+}; // end i2cBenchRun function
+
+// runs every clock and chunk size, results holds i2cBenchClockCount * i2cBenchChunkCount entries
+static uint32_t i2cBenchSweep(Adafruit_SSD1306 &oled, TwoWire &wire, uint8_t address, uint32_t flushes,
+                              I2cBenchResult *results)
+{
+    uint32_t maxStable = 0;
+    bool stable = true;
+
+    logReport("I2C transport benchmark: full buffer flushes");
+    logReport("    SCL  chunk  transactions     bytes/s  us/transaction  failed");
+    for (uint8_t c = 0; c < i2cBenchClockCount; c++)
+    {
+        bool clockStable = true;
+        for (uint8_t k = 0; k < i2cBenchChunkCount; k++)
+        {
+            I2cBenchResult &r = results[c * i2cBenchChunkCount + k];
+            i2cBenchRun(oled, wire, address, i2cBenchClocks[c], i2cBenchChunks[k], flushes, r);
+            clockStable &= r.failed == 0;
+            logReport("%7u  %5u  %12u  %10.0f  %14.1f  %6u", r.clock, r.chunk, r.transactions, r.bytesPerSecond,
+                      r.transactionMicros, r.failed);
+        }
+        // a clock only counts when every lower one worked too
+        stable &= clockStable;
+        if (stable)
+        {
+            maxStable = i2cBenchClocks[c];
+        }
+    }
+
+    // leave the panel showing the buffer at the clock in use
+    oledFlushRegion(oled, wire, address, {0, 0, oled.width(), oled.height()});
+    logReport("Highest stable SCL: %u Hz", maxStable);
+    return maxStable;
+}; // end i2cBenchSweep function
+
+#endif // I2CBENCH_H
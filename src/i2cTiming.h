@@ -0,0 +1,64 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: i2cTiming.h
+//
+// Description:
+//
+// cost model of the I2C writes to the panel and the chunking policy of
+// oledFlush.h, shared by the firmware benchmark (i2cBench.h), the host
+// bus mock and its tests.
+//
+// A write transaction is a start condition, the address byte and the
+// data bytes (8 bits plus ACK each) and a stop condition. Every data
+// transaction of the SSD1306 repeats the 0x40 control byte, and the
+// ESP32 driver adds a fixed software cost per transaction, so large
+// chunks are cheaper: the Wire buffer (128 bytes) is the upper bound.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef I2CTIMING_H
+#define I2CTIMING_H
+
+#include <stdint.h>
+
+// SCL cycles of one write transaction carrying the given bytes (address not included)
+inline uint32_t i2cTransactionClocks(uint32_t bytes)
+{
+    return 1 + 9 * (1 + bytes) + 1;
+}
+
+inline double i2cTransactionMicros(uint32_t bytes, uint32_t clock, double overheadMicros = 0)
+{
+    return i2cTransactionClocks(bytes) * 1e6 / clock + overheadMicros;
+}
+
+// panel bytes per data transaction, the control byte takes one of the chunk
+inline uint16_t i2cChunkPayload(uint16_t chunk)
+{
+    return chunk > 1 ? chunk - 1 : 1;
+}
+
+// data transactions needed for payload bytes, chunks run on across pages
+inline uint32_t i2cChunkTransactions(uint32_t payload, uint16_t chunk)
+{
+    uint16_t perChunk = i2cChunkPayload(chunk);
+    return (payload + perChunk - 1) / perChunk;
+}
+
+// bus time of the data transactions of a flush of payload bytes
+inline double i2cFlushMicros(uint32_t payload, uint16_t chunk, uint32_t clock, double overheadMicros = 0)
+{
+    uint32_t transactions = i2cChunkTransactions(payload, chunk);
+    // every transaction carries a control byte on top of its payload
+    return (transactions * i2cTransactionClocks(0) + 9.0 * (payload + transactions)) * 1e6 / clock +
+           transactions * overheadMicros;
+}
+
+#endif // I2CTIMING_H
@@ -0,0 +1,119 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32
+//
+// File: logRing.h
+//
+// Description:
+//
+// the ring buffer behind the logger of asyncLog.h: one task pushes
+// formatted lines, another pops them and writes them out. Single
+// producer, single consumer and lock free: the producer alone moves
+// head, the consumer alone moves tail, each publishing its index with
+// a release store once the bytes are in place. A full ring never
+// blocks the producer, the line is dropped and counted instead.
+//
+// Record: uint8 level, uint8 length, then length bytes of text (no
+// terminating zero), stored across the end of the ring when needed.
+// head and tail run freely and are only wrapped when indexing, the
+// ring size being a power of two.
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <atomic>
+
+static const uint32_t logRingBytes = 2048; // power of two
+static const uint8_t logRecordHeader = 2;
+static const uint8_t logLineMax = 255; // longer lines are cut
+
+struct LogRing
+{
+    uint8_t bytes[logRingBytes];
+    std::atomic<uint32_t> head{0};    // next byte to write, producer only
+    std::atomic<uint32_t> tail{0};    // next byte to read, consumer only
+    std::atomic<uint32_t> dropped{0}; // lines refused because the ring was full
+};
+
+struct LogRecord
+{
+    uint8_t level;
+    uint8_t length;
+    char text[logLineMax + 1]; // zero terminated
+};
+
+inline void logRingCopyIn(LogRing &ring, uint32_t at, const void *src, uint32_t size)
+{
+    uint32_t offset = at & (logRingBytes - 1);
+    uint32_t first = size < logRingBytes - offset ? size : logRingBytes - offset;
+    memcpy(&ring.bytes[offset], src, first);
+    memcpy(ring.bytes, (const uint8_t *)src + first, size - first);
+}
+
+inline void logRingCopyOut(const LogRing &ring, uint32_t at, void *dst, uint32_t size)
+{
+    uint32_t offset = at & (logRingBytes - 1);
+    uint32_t first = size < logRingBytes - offset ? size : logRingBytes - offset;
+    memcpy(dst, &ring.bytes[offset], first);
+    memcpy((uint8_t *)dst + first, ring.bytes, size - first);
+}
+
+// producer side, whether a line of length bytes fits right now
+inline bool logRingFits(const LogRing &ring, size_t length)
+{
+    length = length < logLineMax ? length : logLineMax;
+    uint32_t used = ring.head.load(std::memory_order_relaxed) - ring.tail.load(std::memory_order_acquire);
+    return logRingBytes - used >= logRecordHeader + length;
+}
+
+// producer side, false when the line was dropped
+inline bool logRingPush(LogRing &ring, uint8_t level, const char *text, size_t length)
+{
+    length = length < logLineMax ? length : logLineMax;
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    uint32_t tail = ring.tail.load(std::memory_order_acquire);
+    if (logRingBytes - (head - tail) < logRecordHeader + length)
+    {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint8_t header[logRecordHeader] = {level, (uint8_t)length};
+    logRingCopyIn(ring, head, header, logRecordHeader);
+    logRingCopyIn(ring, head + logRecordHeader, text, length);
+    ring.head.store(head + logRecordHeader + length, std::memory_order_release);
+    return true;
+}
+
+// consumer side, false when the ring is empty
+inline bool logRingPop(LogRing &ring, LogRecord &record)
+{
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+    if (head == tail)
+    {
+        return false;
+    }
+
+    uint8_t header[logRecordHeader];
+    logRingCopyOut(ring, tail, header, logRecordHeader);
+    record.level = header[0];
+    record.length = header[1];
+    logRingCopyOut(ring, tail + logRecordHeader, record.text, record.length);
+    record.text[record.length] = 0;
+    ring.tail.store(tail + logRecordHeader + record.length, std::memory_order_release);
+    return true;
+}
+
+#endif // LOGRING_H
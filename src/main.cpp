@@ -52,6 +52,15 @@ U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, OLED_CLOCK, OLED_DATA, U8X8_PI
 
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RST_PIN);
 
+#ifdef MULTI_DISPLAY
+// more panels: one next to the main display with its address jumper moved, one on the second I2C controller
+#define SCREEN_I2C_ADDR_2 0x3D
+#define OLED1_CLOCK 33 // SCL of Wire1 = GPIO 33
+#define OLED1_DATA 32  // SDA of Wire1 = GPIO 32
+Adafruit_SSD1306 displaySystem(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RST_PIN);
+Adafruit_SSD1306 displayBattery(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire1, OLED_RST_PIN);
+#endif
+
 // adding the SD card reader
 #define SCK 18  // GPIO 18 = VSPI_CLK
 #define MISO 19 // GPIO 19 = VSPI_MISO
@@ -63,12 +72,20 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RST_PIN);
 #include <SPI.h>
 
 #include "animations.h" // this is the header file for the animations
+#include "asyncLog.h"   // Serial output written by a low priority task
+#include "assetIndex.h" // finds the animation files on the SD card
+#include "sdStorage.h"  // SPI or SDMMC, the fastest mode the card reads reliably
 
 SPIClass spi = SPIClass(VSPI);
 File file;
 
-// variables for calling specific files
-const char* file0 = "/";
+// animation files found on the SD card, see assetIndex.h
+AssetIndex assetIndex;
+
+// deduplicated frames of every animation, see framePack.h
+const char *framePackPath = "/anims.pak";
+FramePack framePack;
+
 // const char* file1 = "/byteArrayAnim_Meteo.cpp";
 // const char* file2 = "/byteArrayAnim_Position.cpp";
 // const char* file3 = "/byteArrayAnim_Battery.cpp";
@@ -76,146 +93,140 @@ const char* file0 = "/";
 // const char* file5 = "/byteArrayAnim_Icons.cpp";
 // const char* path6 = "/byteArrayAnim.h";
 
-void loadAnimation(const char *fileName, uint8_t **data, uint8_t *dataSize)
-{
-    if (!SD.begin(5))
-    {
-        Serial.println("SD card initialization failed!");
-        return;
-    }
-
-    // Open the file
-    File file = SD.open(fileName);
-    if (!file)
-    {
-        Serial.println("Failed to open file");
-        return;
-    }
-
-    // Get the size of the file
-    *dataSize = file.size() / 288;
+#include "animLoader.h" // reads the animation files from the SD card
+#include "animPlayer.h" // plays the animations listed in animRegistry.h
+#include "planePlayer.h" // shaded icons, bit-planes cycled on a fixed period timer
 
-    // Allocate memory for the data
-    *data = new uint8_t [*dataSize * 288];
-    // for (int i = 0; i < *dataSize; i++)
-    // {
-    //     (*data)[i] = new uint8_t[288]; // Assuming each frame is 288 bytes
-    // }
+#ifdef MULTI_DISPLAY
+#include "displayManager.h" // one player per panel, both I2C buses flushed side by side
 
-    // Read the data from the file
-    for (int i = 0; i < *dataSize; i++)
-    {
-        file.read(&(*data)[i * 288], 288);
-    }
+DisplayManager displays;
+static const uint16_t displayStepsPerLoop = 360; // 12 weather animations of 30 frames
+#endif
 
-    // Close the file
-    file.close();
-};
+#ifdef I2C_BENCH
+#include "i2cBench.h" // SCL clock and chunk size sweep, run once from setup()
+#endif
 
-#include "byteArrayAnim_Battery.h"
-#include "byteArrayAnim_Icons.h"
-#include "byteArrayAnim_Meteo.h"
-#include "byteArrayAnim_Position.h"
-#include "byteArrayAnim_System.h"
+#ifdef SD_BENCH
+#include "sdBench.h" // card open, read and load times, run once from setup()
+#endif
 
-// including functions for SD card reader
-void listDir(fs::FS & fs, const char *dirname, uint8_t levels)
+// card fingerprint stored in the asset index, changes whenever files are added, removed or resized
+uint64_t cardFingerprint()
 {
-    Serial.printf("Listing directory: %s\n", dirname);
-
-    File root = fs.open(dirname);
-    if (!root)
-    {
-        Serial.println("Failed to open directory");
-        return;
-    }
-    if (!root.isDirectory())
-    {
-        Serial.println("Not a directory");
-        return;
-    }
-
-    File file = root.openNextFile();
-    while (file)
-    {
-        if (file.isDirectory())
-        {
-            Serial.print("  DIR : ");
-            Serial.println(file.name());
-            if (levels)
-            {
-                listDir(fs, file.name(), levels - 1);
-            }
-        }
-        else
-        {
-            Serial.print("  FILE: ");
-            Serial.print(file.name());
-            Serial.print("  SIZE: ");
-            Serial.println(file.size());
-        }
-        file = root.openNextFile();
-    }
-}; // end listDir function
+    return storageUsedBytes();
+}; // end cardFingerprint function
 
 // ==================================
 // ONE TIME MANDATORY FUNCTION - DO NOT REMOVE
 // ==================================
 void setup(void)
 {
+    // time and heap spent before setup(): bootloader, static initialisation of globals
+    uint32_t bootMicros = micros();
+    uint32_t bootHeapUsed = ESP.getHeapSize() - ESP.getFreeHeap();
+
     delay(1000); // adding delay for powering up the ESP32
     pinMode(LED_BUILTIN, OUTPUT); // relying on GPIO2 LED to light up on MB
 
     Serial.begin(115200);
-    Serial.println("Starting setup");
+    // log lines written out by the drain task from now on, its stack watched with the loop task's
+    memWatchTask(nullptr);
+    if (logBegin())
+    {
+        memWatchTask(logTask);
+    }
+    LOG_INFO("Starting setup");
+    LOG_INFO("Reached setup after %u us, %u bytes of heap already in use", bootMicros, bootHeapUsed);
 
-    // for U8G2 library setup
-    u8g2.begin();
+    // for U8G2 library setup, only used for the captions
+    {
+        MEM_SCOPE("caption");
+        u8g2.begin();
+    }
     u8g2.clear();
     u8g2.setFont(u8g2_font_profont10_tf);
     oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin(); // caption glyphs decoded once, drawn from the atlas
 
-    // for Adafruit library setup
-    display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+    // for Adafruit library setup, allocates the 1 KB frame buffer
+    {
+        MEM_SCOPE("display");
+        display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+    }
     display.clearDisplay();
 
-    // for SD card setup
-    if (!SD.begin(5))
+#ifdef I2C_BENCH
+    static I2cBenchResult i2cResults[i2cBenchClockCount * i2cBenchChunkCount];
+    i2cBenchSweep(display, Wire, SCREEN_I2C_ADDR, 50, i2cResults);
+#endif
+
+#ifdef MULTI_DISPLAY
+    // weather on the main display, system status next to it, battery on the second bus
+    Wire1.begin(OLED1_DATA, OLED1_CLOCK);
+    displayAdd(displays, display, Wire, SCREEN_I2C_ADDR, AnimCategory::Meteo);
+    displayAdd(displays, displaySystem, Wire, SCREEN_I2C_ADDR_2, AnimCategory::System);
+    displayAdd(displays, displayBattery, Wire1, SCREEN_I2C_ADDR, AnimCategory::Battery);
+    displayBegin(displays);
+#endif
+
+    // for SD card setup: the reader's own bus and pins, then the fastest mode the card reads reliably
+    storageUseSpi(spi, {SCK, MISO, MOSI, CS});
+    StorageReport storage;
+    if (!storageProbe(storageCandidates, storageCandidateCount, storage))
     {
-        Serial.println("Card Mount Failed");
+        LOG_ERROR("Card Mount Failed");
         return;
     }
-    spi.begin(SCK, MISO, MOSI, CS);
-    uint8_t cardType = SD.cardType();
+    uint8_t cardType = storageCardType();
 
     if (cardType == CARD_NONE)
     {
-        Serial.println("No SD card attached");
+        LOG_ERROR("No SD card attached");
         return;
     }
 
-    Serial.print("SD Card Type: ");
+    const char *cardTypeName = "UNKNOWN";
     if (cardType == CARD_MMC)
     {
-        Serial.println("MMC");
+        cardTypeName = "MMC";
     }
     else if (cardType == CARD_SD)
     {
-        Serial.println("SDSC");
+        cardTypeName = "SDSC";
     }
     else if (cardType == CARD_SDHC)
     {
-        Serial.println("SDHC");
+        cardTypeName = "SDHC";
     }
-    else
+    LOG_INFO("SD Card Type: %s", cardTypeName);
+
+    uint64_t cardSize = storageCardSize() / (1024 * 1024);
+    LOG_INFO("SD Card Size: %lluMB", (unsigned long long)cardSize);
+
+#ifdef SD_BENCH
+    // before the index and the pack, so every load reads its own file
+    sdBenchRun();
+#endif
+
+    // one card scan at most, later boots read the index written by the first one
+    uint32_t indexStart = millis();
+    bool indexUsed;
     {
-        Serial.println("UNKNOWN");
+        MEM_SCOPE("index");
+        indexUsed = assetIndexBegin(storageFS(), cardFingerprint, assetIndex);
     }
+    LOG_INFO("Asset index %s in %u ms", indexUsed ? "loaded" : "rebuilt", (unsigned)(millis() - indexStart));
 
-    uint64_t cardSize = SD.cardSize() / (1024 * 1024);
-    Serial.printf("SD Card Size: %lluMB\n", cardSize);
+    // optional, animations missing from the pack are read from their own file
+    {
+        MEM_SCOPE("pack");
+        framePackOpen(storageFS(), framePackPath, framePack);
+    }
 
-    Serial.println("Setup complete");
+    memSample("setup");
+    LOG_INFO("Setup complete");
 }; // end setup function
 
 // ==================================
@@ -223,7 +234,6 @@ void setup(void)
 // ==================================
 void loop(void)
 {
-    Serial.println("looking for animation files");
     // Commands for SD card reader
     // listDir(SD, "/", 0);
     // createDir(SD, "/mydir");
@@ -234,10 +244,8 @@ void loop(void)
     // deleteFile(SD, "/foo.txt");
     // renameFile(SD, "/hello.txt", "/foo.txt");
     // readFile(SD, "/foo.txt");
-    // testFileIO(SD, "/test.txt");
-    listDir(SD, file0, 0);
-
-    Serial.println("Starting Byte Array Animation loop");
+    // storage benchmark: build with -DSD_BENCH, see sdBench.h
+    LOG_INFO("Starting Byte Array Animation loop");
 
     // byteArray_Anim(); // call the function to run the animation not in class
     // Calling individual functions when dealing with separated .h files
@@ -248,47 +256,69 @@ void loop(void)
     // byteArrayAnimation_Icons.byteArrayIcons_Anim(); // call the function to run the animation in class
     // byteArrayAnimation_Battery.byteArrayBattery_Anim(); // call the function to run the animation in class
 
+#ifdef MULTI_DISPLAY
+    // every panel plays its own category, a frame each per step
+    bLED = !bLED; // toggle LED State
+    digitalWrite(LED_BUILTIN, bLED);
+    uint32_t displayStart = millis();
+    uint32_t displayFrames = 0;
+    for (uint16_t step = 0; step < displayStepsPerLoop; step++)
+    {
+        displayFrames += displayStep(displays);
+    }
+    uint32_t displayMs = millis() - displayStart;
+    LOG_INFO("Displays: %u frames in %u ms, %u frames/s", (unsigned)displayFrames, (unsigned)displayMs,
+             displayMs ? (unsigned)(displayFrames * 1000 / displayMs) : 0);
+#else
     // Calling functions to display all byte array animatyions of each groupings
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("Meteo Animation starting");
-    byteArrayMeteo_Anim(); // call the function to run the animation
+    LOG_INFO("Meteo Animation starting");
+    byteArray_Anim(AnimCategory::Meteo); // call the function to run the animation
 
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("Position Animation starting");
-    byteArrayPosition_Anim(); // call the function to run the animation
+    LOG_INFO("Position Animation starting");
+    byteArray_Anim(AnimCategory::Position); // call the function to run the animation
 
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("Battery Animation starting");
-    byteArrayBattery_Anim(); // call the function to run the animation
+    LOG_INFO("Battery Animation starting");
+    byteArray_Anim(AnimCategory::Battery); // call the function to run the animation
 
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("System Animation starting");
-    byteArraySystem_Anim(); // call the function to run the animation
+    LOG_INFO("System Animation starting");
+    byteArray_Anim(AnimCategory::System); // call the function to run the animation
 
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("Icons Animation starting");
-    byteArrayIcons_Anim(); // call the function to run the animation
+    LOG_INFO("Icons Animation starting");
+    byteArray_Anim(AnimCategory::Icons); // call the function to run the animation
 
     // calling an individual animation from each groupings
     bLED = !bLED; // toggle LED State
     digitalWrite(LED_BUILTIN, bLED);
-    Serial.println("Meteo Lightning Bolt Weather Animation starting");
-    Meteo_lightningboltWeather(); // call the function to run the lightning bolt weather animation
-    Serial.println("Position Down Arrow Animation starting");
-    Position_Down(); // call the function to run the down arrow animation
-    Serial.println("Battery Low Level Animation starting");
-    Battery_isLow(); // call the function to run the low battery level animation
-    Serial.println("System Sound Animation starting");
-    System_sound(); // call the function to run the sound animation
-    Serial.println("Icons Heartbeat Animation starting");
-    Icons_heartbeat(); // call the function to run the heartbeat animation
-
-    Serial.println("ending loop");
+    LOG_INFO("Meteo Lightning Bolt Weather Animation starting");
+    byteArray_Display(ANIM("lightningboltWeather")); // run the lightning bolt weather animation
+    LOG_INFO("Position Down Arrow Animation starting");
+    byteArray_Display(ANIM("downArrow")); // run the down arrow animation
+    LOG_INFO("Battery Low Level Animation starting");
+    byteArray_Display(ANIM("lowBattery")); // run the low battery level animation
+    LOG_INFO("System Sound Animation starting");
+    byteArray_Display(ANIM("sound")); // run the sound animation
+    LOG_INFO("Icons Heartbeat Animation starting");
+    byteArray_Display(ANIM("heartbeat")); // run the heartbeat animation
+
+    LOG_INFO("Unlisted Animations starting");
+    byteArray_Unlisted(); // animations copied to the card but not in animRegistry.h
+    byteArray_Planes();   // shaded icons copied to the card, plane by plane
+#endif
+
+    ANIM_PROFILE_POLL(); // stage histograms, when asked for over Serial
+    memCycleEnd();       // lowest free heap and stack of this pass
+
+    LOG_INFO("ending loop");
 }; // end loop function
 
 // creating objects for individual .h files
@@ -604,55 +634,7 @@ void loop(void)
 //     }
 // }; // end deleteFile function
 
-// shows how long it takes to read the content of a file
-// void testFileIO(fs::FS &fs, const char *path)
-// {
-//     File file = fs.open(path);
-//     static uint8_t buf[512];
-//     size_t len = 0;
-//     uint32_t start = millis();
-//     uint32_t end = start;
-//     if (file)
-//     {
-//         len = file.size();
-//         size_t flen = len;
-//         start = millis();
-//         while (len)
-//         {
-//             size_t toRead = len;
-//             if (toRead > 512)
-//             {
-//                 toRead = 512;
-//             }
-//             file.read(buf, toRead);
-//             len -= toRead;
-//         }
-//         end = millis() - start;
-//         Serial.printf("%u bytes read for %u ms\n", flen, end);
-//         file.close();
-//     }
-//     else
-//     {
-//         Serial.println("Failed to open file for reading");
-//     }
-// 
-//     file = fs.open(path, FILE_WRITE);
-//     if (!file)
-//     {
-//         Serial.println("Failed to open file for writing");
-//         return;
-//     }
-// 
-//     size_t i;
-//     start = millis();
-//     for (i = 0; i < 2048; i++)
-//     {
-//         file.write(buf, 512);
-//     }
-//     end = millis() - start;
-//     Serial.printf("%u bytes written for %u ms\n", 2048 * 512, end);
-//     file.close();
-// }; // end testFileIO function
+// testFileIO() grew into the storage benchmark of sdBench.h, build with -DSD_BENCH
 
     // LOOP USED TO VIEW ALL BYTE ARRAY ANIMATIONS BEFORE WE TRANSFERED THEM TO INDIVIDUAL .h FILES
     // for (int i = 0; i < totalarrays; i++)
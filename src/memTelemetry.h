@@ -0,0 +1,191 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: memTelemetry.h
+//
+// Description:
+//
+// memory telemetry of the sketch: memSample() is called at animation
+// boundaries and records free heap, largest free block, the minimum
+// free heap ever and the stack left of every watched task (loopTask
+// by default). The lowest values of each playlist cycle are printed
+// by memCycleEnd() at the end of loop().
+//
+// When a sample falls below one of memThresholds the handler set with
+// memOnAlarm() is called once, and again only after the value went
+// back above the threshold. The default handler prints the sample.
+//
+// In the host build the counting allocator (host/hostHeap.h) also
+// attributes every allocation to the subsystem entered with
+// MEM_SCOPE(name): "load", "caption", "display", "index", "pack".
+// On the ESP32 the macro is empty.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef MEMTELEMETRY_H
+#define MEMTELEMETRY_H
+
+#include <Arduino.h>
+
+#include "asyncLog.h"
+
+#ifdef ANIM_HOST_HEAP
+#include "hostHeap.h"
+
+struct MemScope
+{
+    uint8_t previous;
+
+    MemScope(const char *name) : previous(hostHeapEnter(hostHeapTag(name))) {}
+    ~MemScope() { hostHeapEnter(previous); }
+};
+
+#define MEM_SCOPE_JOIN2(a, b) a##b
+#define MEM_SCOPE_JOIN(a, b) MEM_SCOPE_JOIN2(a, b)
+#define MEM_SCOPE(name) MemScope MEM_SCOPE_JOIN(memScope, __LINE__)(name)
+#else
+#define MEM_SCOPE(name)
+#endif // ANIM_HOST_HEAP
+
+static const uint8_t memMaxTasks = 4;
+
+struct MemSample
+{
+    const char *where;      // animation boundary the sample was taken at
+    uint32_t freeHeap;
+    uint32_t largestBlock;  // biggest allocation that can still succeed
+    uint32_t minFreeHeap;   // lowest free heap since boot
+    uint32_t stackFree[memMaxTasks]; // bytes never used, per watched task
+};
+
+struct MemThresholds
+{
+    uint32_t freeHeap;
+    uint32_t largestBlock;
+    uint32_t stackFree;
+};
+
+enum MemAlarm : uint8_t
+{
+    MEM_LOW_HEAP = 1,
+    MEM_FRAGMENTED = 2, // enough heap in total but no block large enough
+    MEM_LOW_STACK = 4,
+};
+
+typedef void (*MemAlarmHandler)(uint8_t alarms, const MemSample &sample);
+
+// alarm levels: room to load a full screen animation, a block for its frames, stack for the libraries
+static MemThresholds memThresholds = {24 * 1024, 8 * 1024, 1024};
+
+static TaskHandle_t memTasks[memMaxTasks];
+static uint8_t memTaskCount = 0;
+static uint8_t memAlarms = 0; // alarms raised and not yet cleared
+static MemAlarmHandler memAlarmHandler = nullptr;
+static MemSample memCycleLow; // lowest values of the current cycle
+static uint32_t memSamples = 0;
+static uint32_t memCycles = 0;
+
+static uint32_t memLower(uint32_t a, uint32_t b)
+{
+    return a < b ? a : b;
+}; // end memLower function
+
+// one line of text per sample, cut at size
+static void memFormatSample(const MemSample &sample, char *text, size_t size)
+{
+    int used = snprintf(text, size, "Memory at %s: %u free, %u largest block, %u min free", sample.where,
+                        sample.freeHeap, sample.largestBlock, sample.minFreeHeap);
+    for (uint8_t i = 0; i < memTaskCount && used >= 0 && (size_t)used < size; i++)
+    {
+        used += snprintf(text + used, size - used, ", %s stack %u left", pcTaskGetName(memTasks[i]),
+                         sample.stackFree[i]);
+    }
+}; // end memFormatSample function
+
+static void memAlarmPrint(uint8_t alarms, const MemSample &sample)
+{
+    char text[160];
+    memFormatSample(sample, text, sizeof(text));
+    LOG_WARN("Memory alarm:%s%s%s", alarms & MEM_LOW_HEAP ? " low heap" : "",
+             alarms & MEM_FRAGMENTED ? " fragmented" : "", alarms & MEM_LOW_STACK ? " low stack" : "");
+    LOG_WARN("%s", text);
+}; // end memAlarmPrint function
+
+// handler called when a threshold is crossed, nullptr restores the printing one
+static void memOnAlarm(MemAlarmHandler handler)
+{
+    memAlarmHandler = handler;
+}; // end memOnAlarm function
+
+// adds a task whose stack watermark is sampled, the calling task when task is nullptr
+static bool memWatchTask(TaskHandle_t task)
+{
+    if (memTaskCount == memMaxTasks)
+    {
+        return false;
+    }
+    memTasks[memTaskCount++] = task ? task : xTaskGetCurrentTaskHandle();
+    return true;
+}; // end memWatchTask function
+
+static void memSample(const char *where)
+{
+    if (memTaskCount == 0)
+    {
+        memWatchTask(nullptr);
+    }
+
+    MemSample sample = {where, ESP.getFreeHeap(), ESP.getMaxAllocHeap(), ESP.getMinFreeHeap(), {}};
+    uint32_t stackLow = 0xFFFFFFFF;
+    for (uint8_t i = 0; i < memTaskCount; i++)
+    {
+        sample.stackFree[i] = uxTaskGetStackHighWaterMark(memTasks[i]);
+        stackLow = sample.stackFree[i] < stackLow ? sample.stackFree[i] : stackLow;
+    }
+
+    // lowest of the cycle, field by field
+    if (memSamples++ == 0)
+    {
+        memCycleLow = sample;
+    }
+    else
+    {
+        memCycleLow.freeHeap = memLower(memCycleLow.freeHeap, sample.freeHeap);
+        memCycleLow.largestBlock = memLower(memCycleLow.largestBlock, sample.largestBlock);
+        memCycleLow.minFreeHeap = memLower(memCycleLow.minFreeHeap, sample.minFreeHeap);
+        for (uint8_t i = 0; i < memTaskCount; i++)
+        {
+            memCycleLow.stackFree[i] = memLower(memCycleLow.stackFree[i], sample.stackFree[i]);
+        }
+    }
+
+    uint8_t alarms = (sample.freeHeap < memThresholds.freeHeap ? MEM_LOW_HEAP : 0) |
+                     (sample.largestBlock < memThresholds.largestBlock ? MEM_FRAGMENTED : 0) |
+                     (stackLow < memThresholds.stackFree ? MEM_LOW_STACK : 0);
+    uint8_t raised = alarms & ~memAlarms;
+    memAlarms = alarms;
+    if (raised)
+    {
+        (memAlarmHandler ? memAlarmHandler : memAlarmPrint)(raised, sample);
+    }
+}; // end memSample function
+
+// prints the lowest values of the playlist cycle and starts the next one
+static void memCycleEnd(void)
+{
+    memCycles++;
+    if (memSamples)
+    {
+        memCycleLow.where = "cycle low";
+        char text[160];
+        memFormatSample(memCycleLow, text, sizeof(text));
+        LOG_INFO("Memory cycle %u, %u samples. %s", memCycles, memSamples, text);
+    }
+    memSamples = 0;
+}; // end memCycleEnd function
+
+#endif // MEMTELEMETRY_H
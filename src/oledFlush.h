@@ -0,0 +1,98 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: oledFlush.h
+//
+// Description:
+//
+// partial display update: sends only the pages and columns of the
+// Adafruit_SSD1306 buffer covering a rectangle, instead of the whole
+// 1 KB buffer sent by display.display().
+//
+// The data goes out at oledWireClock, the bus clock in use before is
+// restored afterwards (the library leaves Wire at 100 kHz). The panel
+// walks its column window page after page, so transactions are filled
+// up to the chunk size across page ends, see i2cTiming.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef OLEDFLUSH_H
+#define OLEDFLUSH_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+
+#include "frameRegion.h"
+#include "i2cTiming.h"
+
+// bytes per I2C transaction, including the 0x40 data prefix (Wire buffer is 128 on the ESP32)
+static const uint8_t oledWireChunk = 128;
+
+// SCL of the data transfer: the SSD1306 is rated for 400 kHz, i2cBench.h finds what a panel takes
+static uint32_t oledWireClock = 400000;
+
+// returns false when the panel did not acknowledge every transaction
+bool oledFlushRegion(Adafruit_SSD1306 &oled, TwoWire &wire, uint8_t address, const FrameRect &region,
+                     uint16_t chunk = oledWireChunk)
+{
+    FrameRect r = frameRectClip(region, oled.width(), oled.height());
+    if (frameRectIsEmpty(r))
+    {
+        return true;
+    }
+
+    uint8_t page0 = r.y0 / 8;
+    uint8_t page1 = (r.y1 - 1) / 8;
+
+    oled.ssd1306_command(SSD1306_PAGEADDR);
+    oled.ssd1306_command(page0);
+    oled.ssd1306_command(page1);
+    oled.ssd1306_command(SSD1306_COLUMNADDR);
+    oled.ssd1306_command(r.x0);
+    oled.ssd1306_command(r.x1 - 1);
+
+    uint32_t restoreClock = wire.getClock();
+    wire.setClock(oledWireClock);
+
+    const uint8_t *buffer = oled.getBuffer();
+    uint16_t payload = i2cChunkPayload(chunk);
+    uint16_t inChunk = 0;
+    bool acked = true;
+    for (uint8_t page = page0; page <= page1; page++)
+    {
+        const uint8_t *src = buffer + page * oled.width() + r.x0;
+        int16_t left = r.x1 - r.x0;
+        while (left > 0)
+        {
+            if (inChunk == 0)
+            {
+                wire.beginTransmission(address);
+                wire.write((uint8_t)0x40);
+            }
+            int16_t n = left < payload - inChunk ? left : payload - inChunk;
+            wire.write(src, n);
+            src += n;
+            left -= n;
+            inChunk += n;
+            if (inChunk == payload)
+            {
+                acked &= wire.endTransmission() == 0;
+                inChunk = 0;
+            }
+        }
+    }
+    if (inChunk)
+    {
+        acked &= wire.endTransmission() == 0;
+    }
+
+    wire.setClock(restoreClock);
+    return acked;
+}; // end oledFlushRegion function
+
+#endif // OLEDFLUSH_H
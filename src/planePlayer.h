@@ -0,0 +1,336 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: planePlayer.h
+//
+// Description:
+//
+// shaded icons on the monochrome panel by temporal dithering. A plane
+// asset (ASSET_PLANES2 and 3 of assetFormat.h) holds 2 or 3 bit-planes
+// per frame, the least significant first. The planes are shown one
+// after the other, each for a number of slots matching its weight (1,
+// 2, 4), so over the cycle of 2^n - 1 slots a pixel looks as bright as
+// the sum of the weights of its planes: 4 or 8 levels.
+//
+// The slots are the ticks of a periodic esp_timer notifying the
+// playing task, the period fixed for the whole animation: the flush of
+// the window measured before the start plus a quarter, never shorter
+// than asked. The slot order spreads the heavy planes over the cycle
+// (2 1 2 0 2 1 2 for three planes) so the flicker is at the slot rate
+// more than at the cycle rate.
+//
+// The animation area is moved down to whole pages (y 16 instead of 15)
+// and each plane of the frame is drawn once into a cache of that
+// window in the page layout. A slot then only copies the cached plane
+// into the buffer and flushes the window, a slot showing the same plane
+// as the previous one sends nothing. The planes of the next frame are
+// drawn right after the last flush of a frame, in the slack before
+// the next tick.
+//
+// PlaneStats keeps the time between slot starts, the plane period
+// jitter (mean, spread, worst deviation from the period), the ticks
+// missed while a slot overran and the longest flush; planePlay() logs
+// them. The host build runs the timer on its clock (host/esp_timer.h)
+// and integrates what the panel shows into the level each pixel is
+// perceived at, see host/panelIntensity.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef PLANEPLAYER_H
+#define PLANEPLAYER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include <new>
+
+#include "animPlayer.h"
+
+static const uint8_t planeMax = 3;
+// shortest slot; a 48x48 window is about 2.9 ms on the bus at 1 MHz, 7 ms at 400 kHz
+static const uint32_t planePeriodMicros = 3000;
+// each frame of the animation is held for whole cycles lasting about this long
+static const uint32_t planeFrameMicros = 100000;
+
+struct PlaneStats
+{
+    uint32_t period;  // slot period in use, microseconds
+    uint32_t slots;   // ticks waited for
+    uint32_t missed;  // ticks that came while a slot was still busy
+    uint32_t flushes; // slots that sent their plane
+    uint32_t flushMax;
+    uint32_t intervals; // time between slot starts
+    uint32_t intervalMin;
+    uint32_t intervalMax;
+    double intervalSum;
+    double intervalSquares;
+};
+
+struct PlanePlayer
+{
+    AnimPanel *panel;
+    esp_timer_handle_t timer;
+    TaskHandle_t task;
+    uint8_t planes;
+    FrameRect window;  // whole pages
+    uint8_t *cache;    // the window of every plane, in the page layout
+    uint16_t planeBytes;
+    int8_t shownPlane; // on the panel, -1 after a new frame was cached
+    PlaneStats stats;
+};
+
+// slots of one cycle, the plane of weight 2^p shown in 2^p of them
+static uint8_t planeSlots(uint8_t planes)
+{
+    return (1 << planes) - 1;
+}; // end planeSlots function
+
+// plane shown in a slot of the cycle, the most significant one every other slot
+static uint8_t planeOfSlot(uint8_t slot, uint8_t planes)
+{
+    return planes - 1 - __builtin_ctz(slot + 1);
+}; // end planeOfSlot function
+
+static double planeJitterMean(const PlaneStats &stats)
+{
+    return stats.intervals ? stats.intervalSum / stats.intervals : 0;
+}; // end planeJitterMean function
+
+// standard deviation of the time between slot starts
+static double planeJitterSpread(const PlaneStats &stats)
+{
+    if (!stats.intervals)
+    {
+        return 0;
+    }
+    double mean = planeJitterMean(stats);
+    double variance = stats.intervalSquares / stats.intervals - mean * mean;
+    return variance > 0 ? sqrt(variance) : 0;
+}; // end planeJitterSpread function
+
+// largest distance of a slot interval from the period
+static uint32_t planeJitterWorst(const PlaneStats &stats)
+{
+    if (!stats.intervals)
+    {
+        return 0;
+    }
+    uint32_t early = stats.period > stats.intervalMin ? stats.period - stats.intervalMin : 0;
+    uint32_t late = stats.intervalMax > stats.period ? stats.intervalMax - stats.period : 0;
+    return early > late ? early : late;
+}; // end planeJitterWorst function
+
+static void planeStatsInterval(PlaneStats &stats, uint32_t interval)
+{
+    stats.intervalMin = stats.intervals && stats.intervalMin < interval ? stats.intervalMin : interval;
+    stats.intervalMax = stats.intervals && stats.intervalMax > interval ? stats.intervalMax : interval;
+    stats.intervals++;
+    stats.intervalSum += interval;
+    stats.intervalSquares += (double)interval * interval;
+}; // end planeStatsInterval function
+
+// draws every plane of the frame and keeps the window of each in the cache
+static void planeCache(PlanePlayer &player, AnimAsset &asset, uint32_t frame, int16_t x, int16_t y, bool caption)
+{
+    AnimPanel &panel = *player.panel;
+    Adafruit_SSD1306 &oled = *panel.oled;
+    const FrameRect &w = player.window;
+    uint16_t columns = w.x1 - w.x0;
+    uint8_t *buffer = oled.getBuffer();
+    for (uint8_t p = 0; p < player.planes; p++)
+    {
+        const uint8_t *bits;
+        {
+            ANIM_PROFILE_SCOPE(PROFILE_DECODE);
+            bits = animFrame(asset, frame * player.planes + p);
+        }
+        ANIM_PROFILE_SCOPE(PROFILE_COMPOSE);
+        oled.fillRect(w.x0, w.y0, columns, w.y1 - w.y0, 0);
+        animBlit(oled, x, y, bits, asset.header.width, asset.header.height, asset.header.stride);
+        if (caption)
+        {
+            animComposeCaption(panel, w);
+        }
+        uint8_t *plane = player.cache + p * player.planeBytes;
+        for (int16_t page = w.y0 / 8; page < w.y1 / 8; page++)
+        {
+            memcpy(plane + (page - w.y0 / 8) * columns, buffer + page * oled.width() + w.x0, columns);
+        }
+    }
+    player.shownPlane = -1;
+}; // end planeCache function
+
+// puts the cached plane in the buffer and sends the window, unless it is on the panel already
+static void planeShow(PlanePlayer &player, uint8_t plane)
+{
+    if (plane == player.shownPlane)
+    {
+        return;
+    }
+    AnimPanel &panel = *player.panel;
+    Adafruit_SSD1306 &oled = *panel.oled;
+    const FrameRect &w = player.window;
+    uint16_t columns = w.x1 - w.x0;
+    const uint8_t *src = player.cache + plane * player.planeBytes;
+    uint8_t *buffer = oled.getBuffer();
+    for (int16_t page = w.y0 / 8; page < w.y1 / 8; page++)
+    {
+        memcpy(buffer + page * oled.width() + w.x0, src + (page - w.y0 / 8) * columns, columns);
+    }
+
+    uint32_t start = micros();
+    {
+        ANIM_PROFILE_SCOPE(PROFILE_FLUSH);
+        oledFlushRegion(oled, *panel.wire, panel.address, w);
+    }
+    uint32_t spent = micros() - start;
+    player.stats.flushMax = spent > player.stats.flushMax ? spent : player.stats.flushMax;
+    player.stats.flushes++;
+    player.shownPlane = plane;
+}; // end planeShow function
+
+// esp_timer callback, run by the esp_timer task: the next slot is due
+static void planeTick(void *arg)
+{
+    xTaskNotifyGive(((PlanePlayer *)arg)->task);
+}; // end planeTick function
+
+// plays frames of a plane asset with its caption, slots of at least periodMicros; returns the frames shown
+static uint32_t planePlay(const AnimDesc &anim, uint32_t frames, PlaneStats *statsOut = nullptr,
+                          uint32_t periodMicros = planePeriodMicros, AnimPanel &panel = animMainPanel)
+{
+    ANIM_TRACE_SCOPE(anim.id);
+    AnimAsset asset;
+    if (!animOpen(anim, asset, animAcceptPlanes))
+    {
+        return 0;
+    }
+    PlanePlayer player = {};
+    player.panel = &panel;
+    player.planes = assetPlaneCount(asset.header);
+    uint32_t frameCount = asset.header.frameCount / player.planes;
+    if (player.planes == 1 || frameCount == 0)
+    {
+        LOG_WARN("%s has no bit-planes to cycle", anim.path);
+        unloadAnimation(asset);
+        return 0;
+    }
+
+    AnimScreen screen;
+    animBeginScreen(anim, asset.header, true, screen, panel);
+    Adafruit_SSD1306 &oled = *panel.oled;
+    int16_t x = screen.x;
+    int16_t y = screen.y;
+    int16_t aligned = (y + 7) & ~7;
+    y = aligned + (int16_t)asset.header.height <= oled.height() ? aligned : y;
+    player.window = frameRectClip({x, (int16_t)(y & ~7), (int16_t)(x + asset.header.width),
+                                   (int16_t)((y + asset.header.height + 7) & ~7)},
+                                  oled.width(), oled.height());
+    player.planeBytes = (player.window.x1 - player.window.x0) * (player.window.y1 - player.window.y0) / 8;
+    {
+        MEM_SCOPE("planes");
+        player.cache = new (std::nothrow) uint8_t[(size_t)player.planes * player.planeBytes];
+    }
+    if (!player.cache || frameRectIsEmpty(player.window))
+    {
+        LOG_WARN("%s: no room for %u planes", anim.path, player.planes);
+        delete[] player.cache;
+        unloadAnimation(asset);
+        return 0;
+    }
+    memSample(anim.id);
+
+    // the period: one flush of the window and a margin, measured on the planes of the first frame
+    planeCache(player, asset, 0, x, y, screen.caption);
+    uint32_t start = micros();
+    planeShow(player, player.planes - 1);
+    uint32_t flush = micros() - start;
+    uint32_t period = flush + flush / 4;
+    period = (period + 99) / 100 * 100;
+    player.stats = {};
+    player.stats.period = period > periodMicros ? period : periodMicros;
+
+    uint8_t slots = planeSlots(player.planes);
+    uint32_t cyclesPerFrame = planeFrameMicros / (player.stats.period * slots);
+    cyclesPerFrame = cyclesPerFrame ? cyclesPerFrame : 1;
+    LOG_INFO("%s: %u planes, %u us slots (flush %u us), %u Hz cycle", anim.path, player.planes, player.stats.period,
+             flush, 1000000 / (player.stats.period * slots));
+
+    esp_timer_create_args_t args = {};
+    args.callback = planeTick;
+    args.arg = &player;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "planes";
+    player.task = xTaskGetCurrentTaskHandle();
+    if (esp_timer_create(&args, &player.timer) != ESP_OK)
+    {
+        LOG_ERROR("%s: no plane timer", anim.path);
+        delete[] player.cache;
+        unloadAnimation(asset);
+        return 0;
+    }
+    ulTaskNotifyTake(pdTRUE, 0); // nothing stale counts as a tick
+    esp_timer_start_periodic(player.timer, player.stats.period);
+
+    uint32_t previous = 0;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        for (uint32_t cycle = 0; cycle < cyclesPerFrame; cycle++)
+        {
+            for (uint8_t slot = 0; slot < slots; slot++)
+            {
+                uint32_t ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                uint32_t now = micros();
+                if (player.stats.slots)
+                {
+                    planeStatsInterval(player.stats, now - previous);
+                }
+                previous = now;
+                player.stats.slots++;
+                player.stats.missed += ticks > 1 ? ticks - 1 : 0;
+                planeShow(player, planeOfSlot(slot, player.planes));
+            }
+        }
+        if (f + 1 < frames)
+        {
+            planeCache(player, asset, (f + 1) % frameCount, x, y, screen.caption);
+        }
+    }
+    esp_timer_stop(player.timer);
+    esp_timer_delete(player.timer);
+
+    const PlaneStats &stats = player.stats;
+    LOG_INFO("%s: %u slots, interval %.1f us +- %.1f, worst %u us off, %u missed, flush max %u us", anim.path,
+             stats.slots, planeJitterMean(stats), planeJitterSpread(stats), planeJitterWorst(stats), stats.missed,
+             stats.flushMax);
+    if (statsOut)
+    {
+        *statsOut = stats;
+    }
+    delete[] player.cache;
+    unloadAnimation(asset);
+    return frames;
+}; // end planePlay function
+
+// plays the plane assets copied to the card, they are left out of byteArray_Unlisted()
+void byteArray_Planes(void)
+{
+    for (uint16_t i = 0; i < assetIndex.count; i++)
+    {
+        const AssetIndexEntry &entry = assetIndex.entries[i];
+        if (entry.encoding != ASSET_PLANES2 && entry.encoding != ASSET_PLANES3)
+        {
+            continue;
+        }
+        uint8_t planes = entry.encoding == ASSET_PLANES2 ? 2 : 3;
+        const AnimDesc anim = {AnimCategory::Icons, entry.path + 1, entry.path, entry.path + 1,
+                               entry.width, entry.height, entry.frameCount / planes};
+        planePlay(anim, anim.frameCounts);
+    }
+}; // end byte Array Planes function
+
+#endif // PLANEPLAYER_H
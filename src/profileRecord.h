@@ -0,0 +1,255 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: profileRecord.h
+//
+// Description:
+//
+// per stage timing histograms of the player (see animProfile.h) and
+// the binary record they are sent in over Serial.
+//
+// A histogram has log-linear buckets: exact below 4 cycles, then 4
+// buckets per power of two, so any 32 bit cycle count lands in one of
+// 124 buckets with at most 25% relative error. Count, min, max and
+// the cycle sum are kept exactly.
+//
+// Record (little endian), found in the Serial stream by its magic:
+//   0  char[4]  magic "APR1"
+//   4  uint16   payload length
+//   6           payload
+//               uint8   stage count
+//               uint8   bucket count
+//               uint16  CPU clock in MHz (cycles per microsecond)
+//               per stage:
+//                 uint32 count, uint32 min, uint32 max, uint64 sum
+//                 uint8  non empty buckets, then per bucket
+//                        uint8 index, uint32 count
+//   6+length    uint16  Fletcher-16 of the payload
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef PROFILERECORD_H
+#define PROFILERECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+enum ProfileStage : uint8_t
+{
+    PROFILE_LOAD,    // animation opened: file read or pack lookup
+    PROFILE_DECODE,  // frame fetched: delta decode, streamed read
+    PROFILE_COMPOSE, // dirty box cleared and the frame drawn into the buffer
+    PROFILE_CAPTION, // caption rendered and merged
+    PROFILE_FLUSH,   // buffer sent to the panel
+    profileStageCount
+};
+
+static const char *const profileStageNames[profileStageCount] = {"load", "decode", "compose", "caption", "flush"};
+
+static const uint8_t profileMagic[4] = {'A', 'P', 'R', '1'};
+static const uint8_t profileBucketCount = 124;
+static const uint16_t profileStageMaxBytes = 21 + profileBucketCount * 5;
+static const uint16_t profileRecordMaxBytes = 6 + 4 + profileStageCount * profileStageMaxBytes + 2;
+
+struct ProfileHistogram
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[profileBucketCount];
+};
+
+inline uint8_t profileBucket(uint32_t cycles)
+{
+    if (cycles < 4)
+    {
+        return cycles;
+    }
+    uint8_t octave = 31 - __builtin_clz(cycles);
+    return (octave - 1) * 4 + ((cycles >> (octave - 2)) & 3);
+}
+
+// smallest cycle count falling into the bucket
+inline uint32_t profileBucketLow(uint8_t index)
+{
+    if (index < 4)
+    {
+        return index;
+    }
+    return (uint32_t)(4 + index % 4) << (index / 4 - 1);
+}
+
+inline void profileClear(ProfileHistogram &h)
+{
+    memset(&h, 0, sizeof(h));
+}
+
+inline void profileAdd(ProfileHistogram &h, uint32_t cycles)
+{
+    if (h.count == 0 || cycles < h.min)
+    {
+        h.min = cycles;
+    }
+    if (cycles > h.max)
+    {
+        h.max = cycles;
+    }
+    h.count++;
+    h.sum += cycles;
+    h.buckets[profileBucket(cycles)]++;
+}
+
+// cycle count below which the fraction q of the samples lies, middle of its bucket
+inline uint32_t profileQuantile(const ProfileHistogram &h, float q)
+{
+    if (h.count == 0)
+    {
+        return 0;
+    }
+    uint32_t rank = (uint32_t)(q * (h.count - 1)) + 1;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < profileBucketCount; i++)
+    {
+        seen += h.buckets[i];
+        if (seen >= rank)
+        {
+            uint32_t low = profileBucketLow(i);
+            uint32_t high = i + 1 < profileBucketCount ? profileBucketLow(i + 1) - 1 : 0xFFFFFFFF;
+            uint32_t mid = low + (high - low) / 2;
+            return mid < h.min ? h.min : mid > h.max ? h.max : mid;
+        }
+    }
+    return h.max;
+}
+
+inline uint16_t profileChecksum(const uint8_t *data, size_t len)
+{
+    uint16_t a = 0, b = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        a = (a + data[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (b << 8) | a;
+}
+
+inline uint8_t *profilePut(uint8_t *p, uint64_t v, uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        *p++ = v >> (8 * i);
+    }
+    return p;
+}
+
+inline uint64_t profileGet(const uint8_t *&p, uint8_t bytes)
+{
+    uint64_t v = 0;
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        v |= (uint64_t)*p++ << (8 * i);
+    }
+    return v;
+}
+
+// writes the record of all stages, out holds profileRecordMaxBytes, returns its size
+inline size_t profileEncode(const ProfileHistogram *stages, uint16_t cpuMHz, uint8_t *out)
+{
+    uint8_t *p = out + 6;
+    *p++ = profileStageCount;
+    *p++ = profileBucketCount;
+    p = profilePut(p, cpuMHz, 2);
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        const ProfileHistogram &h = stages[s];
+        p = profilePut(p, h.count, 4);
+        p = profilePut(p, h.min, 4);
+        p = profilePut(p, h.max, 4);
+        p = profilePut(p, h.sum, 8);
+        uint8_t *used = p++;
+        *used = 0;
+        for (uint8_t i = 0; i < profileBucketCount; i++)
+        {
+            if (h.buckets[i])
+            {
+                *p++ = i;
+                p = profilePut(p, h.buckets[i], 4);
+                (*used)++;
+            }
+        }
+    }
+
+    uint16_t length = p - out - 6;
+    memcpy(out, profileMagic, 4);
+    profilePut(out + 4, length, 2);
+    p = profilePut(p, profileChecksum(out + 6, length), 2);
+    return p - out;
+}
+
+// parses a record starting at its magic, returns its size or 0 when it is incomplete or damaged
+inline size_t profileDecode(const uint8_t *in, size_t len, ProfileHistogram *stages, uint16_t &cpuMHz)
+{
+    if (len < 6 + 4 + 2 || memcmp(in, profileMagic, 4) != 0)
+    {
+        return 0;
+    }
+    const uint8_t *p = in + 4;
+    uint16_t length = profileGet(p, 2);
+    if (len < 6 + (size_t)length + 2 || length < 4)
+    {
+        return 0;
+    }
+    const uint8_t *end = in + 6 + length;
+    const uint8_t *sum = end;
+    if (profileGet(sum, 2) != profileChecksum(in + 6, length))
+    {
+        return 0;
+    }
+    uint8_t stageCount = *p++;
+    uint8_t bucketCount = *p++;
+    cpuMHz = profileGet(p, 2);
+    if (stageCount != profileStageCount || bucketCount != profileBucketCount)
+    {
+        return 0;
+    }
+
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        ProfileHistogram &h = stages[s];
+        profileClear(h);
+        if (end - p < 21)
+        {
+            return 0;
+        }
+        h.count = profileGet(p, 4);
+        h.min = profileGet(p, 4);
+        h.max = profileGet(p, 4);
+        h.sum = profileGet(p, 8);
+        uint8_t used = *p++;
+        if (end - p < used * 5)
+        {
+            return 0;
+        }
+        for (uint8_t i = 0; i < used; i++)
+        {
+            uint8_t index = *p++;
+            uint32_t count = profileGet(p, 4);
+            if (index >= profileBucketCount)
+            {
+                return 0;
+            }
+            h.buckets[index] = count;
+        }
+    }
+    return p == end ? 6 + length + 2 : 0;
+}
+
+#endif // PROFILERECORD_H
@@ -0,0 +1,278 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: sdBench.h
+//
+// Description:
+//
+// storage benchmark of the SD card, grown out of the old testFileIO()
+// of main.cpp. Built in with -DSD_BENCH (see platformio.ini) and run
+// once from setup(), before the asset index and the animation pack
+// are opened so every load really reads its file. Measures:
+//
+//   open     open and close of a file
+//   seq      whole file read front to back, per chunk size
+//   random   chunk sized reads at random offsets, per chunk size
+//   load     loadAnimation() of every animation of animRegistry.h
+//   boot     assetIndexBegin() then the first frame of the first
+//            animation, as setup() and the player do: once scanning
+//            the card (no index), once reading the index back
+//
+// each cold (card remounted first, nothing cached) and warm (right
+// after the same work, directory and sectors cached where the card
+// and the FAT layer keep them), in the bus mode storageProbe() chose
+// (sdStorage.h). Results are machine readable lines:
+//
+//   sdbench,<test>,<path>,<chunk>,<cold|warm>,<ops>,<bytes>,<us>,<bytes/s>
+//
+// grep ^sdbench from the serial log to get a CSV. The same harness runs
+// on the host against the card model of the FS mock (tools/bench_sd.cpp).
+//
+// NOTE: writes and removes /sdbench.bin on the card, rewrites /anim.idx
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SDBENCH_H
+#define SDBENCH_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <new>
+
+#include "animations.h"
+#include "animRegistry.h"
+#include "assetIndex.h"
+#include "asyncLog.h"
+#include "sdStorage.h"
+
+static const char *sdBenchPath = "/sdbench.bin";
+static const uint32_t sdBenchFileBytes = 64 * 1024;
+// a few bytes, one 48x48 frame, one sector, a FAT cluster
+static const uint16_t sdBenchChunks[] = {64, 288, 512, 4096};
+static const uint8_t sdBenchChunkCount = sizeof(sdBenchChunks) / sizeof(sdBenchChunks[0]);
+static const uint16_t sdBenchOpens = 16;
+static const uint16_t sdBenchRandomReads = 64;
+
+static void sdBenchLine(const char *test, const char *path, uint32_t chunk, bool warm, uint32_t ops, uint32_t bytes,
+                        uint32_t micros)
+{
+    logReport("sdbench,%s,%s,%u,%s,%u,%u,%u,%.0f", test, path, chunk, warm ? "warm" : "cold", ops, bytes, micros,
+              micros ? bytes * 1e6 / micros : 0.0);
+}; // end sdBenchLine function
+
+// unmounts and mounts the card again, so nothing of the previous reads is cached
+static bool sdBenchRemount(void)
+{
+    return storageBegin(storageActive);
+}; // end sdBenchRemount function
+
+// remounts before a cold test, false when the card did not come back and the test has to be skipped
+static bool sdBenchCold(bool warm)
+{
+    if (warm || sdBenchRemount())
+    {
+        return true;
+    }
+    LOG_ERROR("sdbench: remount failed, cold test skipped");
+    return false;
+}; // end sdBenchCold function
+
+static bool sdBenchCreateFile(uint8_t *buf)
+{
+    File file = storageFS().open(sdBenchPath, FILE_WRITE);
+    if (!file)
+    {
+        LOG_ERROR("sdbench: failed to open %s for writing", sdBenchPath);
+        return false;
+    }
+    for (uint32_t i = 0; i < 4096; i++)
+    {
+        buf[i] = i * 7 + (i >> 8);
+    }
+    bool written = true;
+    for (uint32_t left = sdBenchFileBytes; left > 0 && written; left -= 4096)
+    {
+        written = file.write(buf, 4096) == 4096;
+    }
+    file.close();
+    return written;
+}; // end sdBenchCreateFile function
+
+// returns false when the card could not be remounted
+static bool sdBenchOpen(bool warm)
+{
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < sdBenchOpens; i++)
+    {
+        if (!sdBenchCold(warm))
+        {
+            return false;
+        }
+        uint32_t start = micros();
+        File file = storageFS().open(sdBenchPath);
+        file.close();
+        total += micros() - start;
+    }
+    sdBenchLine("open", sdBenchPath, 0, warm, sdBenchOpens, 0, total);
+    return true;
+}; // end sdBenchOpen function
+
+static bool sdBenchSequential(uint8_t *buf, uint16_t chunk, bool warm)
+{
+    if (!sdBenchCold(warm))
+    {
+        return false;
+    }
+    uint32_t start = micros();
+    File file = storageFS().open(sdBenchPath);
+    uint32_t bytes = 0, reads = 0;
+    size_t n;
+    while ((n = file.read(buf, chunk)) > 0)
+    {
+        bytes += n;
+        reads++;
+    }
+    file.close();
+    sdBenchLine("seq", sdBenchPath, chunk, warm, reads, bytes, micros() - start);
+    return true;
+}; // end sdBenchSequential function
+
+static bool sdBenchRandom(uint8_t *buf, uint16_t chunk, bool warm)
+{
+    if (!sdBenchCold(warm))
+    {
+        return false;
+    }
+    File file = storageFS().open(sdBenchPath);
+    // the same offsets cold and warm, from a fixed LCG sequence
+    uint32_t seed = 0x5DB5EED;
+    uint32_t bytes = 0;
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < sdBenchRandomReads; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        file.seek((seed >> 8) % (sdBenchFileBytes - chunk));
+        bytes += file.read(buf, chunk);
+    }
+    uint32_t elapsed = micros() - start;
+    file.close();
+    sdBenchLine("random", sdBenchPath, chunk, warm, sdBenchRandomReads, bytes, elapsed);
+    return true;
+}; // end sdBenchRandom function
+
+// returns false when the card could not be remounted or the animation could not be loaded
+static bool sdBenchLoad(const AnimDesc &anim, bool warm)
+{
+    if (!sdBenchCold(warm))
+    {
+        return false;
+    }
+    AnimAsset asset;
+    uint32_t start = micros();
+    bool loaded = loadAnimation(anim.path, anim, asset);
+    uint32_t elapsed = micros() - start;
+    uint32_t bytes = loaded ? asset.fileSize : 0;
+    if (loaded)
+    {
+        unloadAnimation(asset);
+    }
+    sdBenchLine("load", anim.path, 0, warm, 1, bytes, elapsed);
+    return loaded;
+}; // end sdBenchLoad function
+
+// boot to the first frame, with the card scanned (path "scan") then with the index (path "index")
+// ops is the number of animations indexed, bytes the size of the frame; returns the number of failures
+static uint16_t sdBenchBoot(void)
+{
+    AssetIndex *index = new (std::nothrow) AssetIndex;
+    if (!index)
+    {
+        LOG_ERROR("sdbench: no memory for the asset index");
+        return 1;
+    }
+
+    uint16_t failed = 0;
+    for (uint8_t indexed = 0; indexed < 2; indexed++)
+    {
+        if (!indexed)
+        {
+            assetIndexInvalidate(storageFS());
+        }
+        if (!sdBenchCold(false))
+        {
+            failed++;
+            continue;
+        }
+        AnimAsset asset;
+        uint32_t start = micros();
+        bool used = assetIndexBegin(storageFS(), storageUsedBytes, *index);
+        bool loaded = loadAnimation(animRegistry[0].path, animRegistry[0], asset);
+        bool shown = loaded && animFrame(asset, 0) != nullptr;
+        uint32_t elapsed = micros() - start;
+        uint32_t bytes = loaded ? asset.frameBytes : 0;
+        if (loaded)
+        {
+            unloadAnimation(asset);
+        }
+        failed += !shown || used != (bool)indexed;
+        sdBenchLine("boot", indexed ? "index" : "scan", 0, false, index->count, bytes, elapsed);
+    }
+    delete index;
+    return failed;
+}; // end sdBenchBoot function
+
+// runs every test cold then warm, returns the number of failures
+static uint16_t sdBenchRun(void)
+{
+    logReport("sdbench,test,path,chunk,state,ops,bytes,us,bytes_per_s");
+
+    uint16_t failed = 0;
+    uint8_t *buf = new (std::nothrow) uint8_t[4096];
+    if (!buf)
+    {
+        LOG_ERROR("sdbench: no memory for the read buffer, file tests skipped");
+        failed++;
+    }
+    else if (sdBenchCreateFile(buf))
+    {
+        for (uint8_t warm = 0; warm < 2; warm++)
+        {
+            failed += !sdBenchOpen(warm);
+        }
+        for (uint8_t k = 0; k < sdBenchChunkCount; k++)
+        {
+            for (uint8_t warm = 0; warm < 2; warm++)
+            {
+                failed += !sdBenchSequential(buf, sdBenchChunks[k], warm);
+            }
+            for (uint8_t warm = 0; warm < 2; warm++)
+            {
+                failed += !sdBenchRandom(buf, sdBenchChunks[k], warm);
+            }
+        }
+        storageFS().remove(sdBenchPath);
+    }
+    else
+    {
+        failed++;
+    }
+    delete[] buf;
+
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        for (uint8_t warm = 0; warm < 2; warm++)
+        {
+            failed += !sdBenchLoad(animRegistry[i], warm);
+        }
+    }
+    failed += sdBenchBoot();
+    logReport("sdbench done, %u failures", failed);
+    return failed;
+}; // end sdBenchRun function
+
+#endif // SDBENCH_H
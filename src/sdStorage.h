@@ -0,0 +1,265 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, SD card reader
+//
+// File: sdStorage.h
+//
+// Description:
+//
+// the SD card behind one fs::FS: on an SPI bus with explicit pins and
+// clock (up to 40 MHz), or on the SDMMC host with 1 or 4 data lines.
+// setup() hands storageProbe() a list of configurations, fastest
+// first. Each one is mounted in turn and must read the probe file back
+// intact storageProbePasses times; the first that does is kept and
+// reported with the throughput measured while reading.
+//
+// The probe file (/storage.probe, 16 KB of a fixed pattern) is written
+// once, with the slowest configuration of the list that mounts: the
+// list goes over both buses and the card is wired to one of them only.
+//
+// SDMMC has fixed pins on the ESP32 (CLK 14, CMD 15, D0 2, D1 4,
+// D2 12, D3 13). The default list only tries it when built with
+// -DSTORAGE_SDMMC (see platformio.ini): the reader of this board sits
+// on the VSPI pins and GPIO2 drives the LED.
+//
+// Everything reading the card goes through storageFS() and mounts with
+// storageMount(), which keeps an existing mount like SD.begin() does.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef SDSTORAGE_H
+#define SDSTORAGE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <SD_MMC.h>
+#include <SPI.h>
+#include <new>
+
+#include "asyncLog.h"
+
+enum StorageMode : uint8_t
+{
+    STORAGE_SPI,
+    STORAGE_SDMMC_1BIT,
+    STORAGE_SDMMC_4BIT,
+};
+
+struct StorageConfig
+{
+    StorageMode mode;
+    uint32_t clock; // Hz
+};
+
+struct StoragePins
+{
+    int8_t sck;
+    int8_t miso;
+    int8_t mosi;
+    int8_t cs;
+};
+
+struct StorageReport
+{
+    StorageConfig config;    // the configuration kept
+    uint32_t bytesPerSecond; // reading the probe file, 0 when nothing worked
+    uint8_t tried;           // configurations mounted, the kept one included
+};
+
+static const char *storageProbePath = "/storage.probe";
+static const uint32_t storageProbeBytes = 16 * 1024;
+static const uint16_t storageProbeChunk = 4096;
+static const uint8_t storageProbePasses = 3;
+
+// fastest first on each bus, the slowest SPI mode works with any card wired to the VSPI pins
+static const StorageConfig storageCandidates[] = {
+#ifdef STORAGE_SDMMC
+    {STORAGE_SDMMC_4BIT, 40000000},
+    {STORAGE_SDMMC_4BIT, 20000000},
+    {STORAGE_SDMMC_1BIT, 40000000},
+    {STORAGE_SDMMC_1BIT, 20000000},
+#endif
+    {STORAGE_SPI, 40000000},
+    {STORAGE_SPI, 20000000},
+    {STORAGE_SPI, 10000000},
+    {STORAGE_SPI, 4000000},
+};
+static const uint8_t storageCandidateCount = sizeof(storageCandidates) / sizeof(storageCandidates[0]);
+
+// until storageBegin(): what SD.begin(5) uses
+static SPIClass *storageSpi = &SPI;
+static StoragePins storagePins = {-1, -1, -1, 5};
+static StorageConfig storageActive = {STORAGE_SPI, 4000000};
+static fs::FS *storageFs = &SD;
+
+static const char *storageModeName(StorageMode mode)
+{
+    return mode == STORAGE_SDMMC_4BIT ? "SDMMC 4-bit" : (mode == STORAGE_SDMMC_1BIT ? "SDMMC 1-bit" : "SPI");
+}; // end storageModeName function
+
+// bus and pins of the SPI configurations
+static void storageUseSpi(SPIClass &spi, const StoragePins &pins)
+{
+    storageSpi = &spi;
+    storagePins = pins;
+}; // end storageUseSpi function
+
+static fs::FS &storageFS(void)
+{
+    return *storageFs;
+}; // end storageFS function
+
+// mounts the card in the active configuration, keeps an existing mount
+static bool storageMount(void)
+{
+    if (storageActive.mode == STORAGE_SPI)
+    {
+        storageFs = &SD;
+        return SD.begin(storagePins.cs, *storageSpi, storageActive.clock);
+    }
+    storageFs = &SD_MMC;
+    return SD_MMC.begin("/sdcard", storageActive.mode == STORAGE_SDMMC_1BIT, false, storageActive.clock / 1000);
+}; // end storageMount function
+
+// unmounts the card and mounts it again with config
+static bool storageBegin(const StorageConfig &config)
+{
+    SD.end();
+    SD_MMC.end();
+    storageActive = config;
+    if (config.mode == STORAGE_SPI)
+    {
+        storageSpi->begin(storagePins.sck, storagePins.miso, storagePins.mosi, storagePins.cs);
+    }
+    return storageMount();
+}; // end storageBegin function
+
+static uint8_t storageCardType(void)
+{
+    return storageActive.mode == STORAGE_SPI ? SD.cardType() : SD_MMC.cardType();
+}; // end storageCardType function
+
+static uint64_t storageCardSize(void)
+{
+    return storageActive.mode == STORAGE_SPI ? SD.cardSize() : SD_MMC.cardSize();
+}; // end storageCardSize function
+
+static uint64_t storageUsedBytes(void)
+{
+    return storageActive.mode == STORAGE_SPI ? SD.usedBytes() : SD_MMC.usedBytes();
+}; // end storageUsedBytes function
+
+// every sector of the probe file differs from its neighbours
+static uint8_t storageProbeByte(uint32_t i)
+{
+    return i * 131 + (i >> 9);
+}; // end storageProbeByte function
+
+// writes the probe file unless the card holds it already
+static bool storageWriteProbe(uint8_t *buf)
+{
+    File file = storageFs->open(storageProbePath);
+    bool present = file && file.size() == storageProbeBytes;
+    file.close();
+    if (present)
+    {
+        return true;
+    }
+
+    file = storageFs->open(storageProbePath, FILE_WRITE);
+    bool written = (bool)file;
+    for (uint32_t pos = 0; pos < storageProbeBytes && written; pos += storageProbeChunk)
+    {
+        for (uint16_t k = 0; k < storageProbeChunk; k++)
+        {
+            buf[k] = storageProbeByte(pos + k);
+        }
+        written = file.write(buf, storageProbeChunk) == storageProbeChunk;
+    }
+    file.close();
+    return written;
+}; // end storageWriteProbe function
+
+// reads the probe file storageProbePasses times, returns bytes per second or 0 on a read error or a wrong byte
+static uint32_t storageReadProbe(uint8_t *buf)
+{
+    uint32_t bytes = 0;
+    uint32_t start = micros();
+    for (uint8_t pass = 0; pass < storageProbePasses; pass++)
+    {
+        File file = storageFs->open(storageProbePath);
+        if (!file)
+        {
+            return 0;
+        }
+        for (uint32_t pos = 0; pos < storageProbeBytes; pos += storageProbeChunk)
+        {
+            bool intact = file.read(buf, storageProbeChunk) == storageProbeChunk;
+            for (uint16_t k = 0; k < storageProbeChunk && intact; k++)
+            {
+                intact = buf[k] == storageProbeByte(pos + k);
+            }
+            if (!intact)
+            {
+                file.close();
+                return 0;
+            }
+            bytes += storageProbeChunk;
+        }
+        file.close();
+    }
+    uint32_t elapsed = micros() - start;
+    return elapsed ? (uint64_t)bytes * 1000000 / elapsed : bytes;
+}; // end storageReadProbe function
+
+// mounts the first configuration that reads the probe file back intact, candidates fastest first
+static bool storageProbe(const StorageConfig *candidates, uint8_t count, StorageReport &report)
+{
+    report.bytesPerSecond = 0;
+    report.tried = 0;
+    uint8_t *buf = new (std::nothrow) uint8_t[storageProbeChunk];
+    if (!buf || count == 0)
+    {
+        delete[] buf;
+        return false;
+    }
+
+    // written at the slowest configuration that mounts, the one least likely to corrupt it
+    bool ready = false;
+    for (uint8_t i = count; i > 0 && !ready; i--)
+    {
+        ready = storageBegin(candidates[i - 1]) && storageWriteProbe(buf);
+    }
+    for (uint8_t i = 0; ready && i < count && report.bytesPerSecond == 0; i++)
+    {
+        report.tried++;
+        uint32_t rate = storageBegin(candidates[i]) ? storageReadProbe(buf) : 0;
+        if (rate)
+        {
+            report.config = candidates[i];
+            report.bytesPerSecond = rate;
+        }
+        else
+        {
+            LOG_WARN("Storage: %s at %u kHz failed", storageModeName(candidates[i].mode),
+                     candidates[i].clock / 1000);
+        }
+    }
+    delete[] buf;
+
+    if (report.bytesPerSecond == 0)
+    {
+        SD.end();
+        SD_MMC.end();
+        return false;
+    }
+    LOG_INFO("Storage: %s at %u kHz, %u KB/s reading", storageModeName(report.config.mode),
+             report.config.clock / 1000, report.bytesPerSecond / 1024);
+    return true;
+}; // end storageProbe function
+
+#endif // SDSTORAGE_H
@@ -0,0 +1,184 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// ESP32, OLED SSD1306
+//
+// File: tileCodec.h
+//
+// Description:
+//
+// tile dictionary encoding for animation files (encoding ASSET_TILES).
+// The 1bpp icons are built from few distinct 8x8 tiles (empty, solid,
+// edges), so every frame is stored as a grid of tile indices (6x6 for
+// 48x48) into one dictionary shared by all frames of the asset.
+//
+// Tiles are kept in the SSD1306 page layout: 8 bytes, one per column,
+// bit 0 is the top row. A tile landing on a page boundary is ORed into
+// the display buffer as one 64 bit word; anything else (the 48x48 area
+// starts at y = 15) is split over two pages with a shift.
+//
+// File layout after the 16 byte asset header (little endian):
+//   uint16  tile count
+//   uint8   bytes per tile index, 1 or 2
+//   uint8   grid columns (width + 7) / 8
+//   uint8   grid rows (height + 7) / 8
+//   uint8   0, 0, 0
+//   tiles   8 bytes each
+//   frames  columns * rows indices each, row by row
+//
+// NOTE: no Arduino dependencies here, the host tools include it too
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef TILECODEC_H
+#define TILECODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "assetFormat.h"
+
+static const uint8_t tileInfoSize = 8;
+static const uint8_t tileBytes = 8;
+
+struct TileInfo
+{
+    uint16_t tileCount;
+    uint8_t indexBytes;
+    uint8_t cols;
+    uint8_t rows;
+    uint32_t dictOffset;   // file offset of the first tile
+    uint32_t framesOffset; // file offset of the indices of frame 0
+    uint32_t frameBytes;   // index bytes per frame
+};
+
+// reads the codec info found right after the asset header
+inline bool tileParseInfo(const AssetHeader &header, const uint8_t *buf, size_t len, TileInfo &info)
+{
+    if (len < tileInfoSize)
+    {
+        return false;
+    }
+    info.tileCount = buf[0] | (buf[1] << 8);
+    info.indexBytes = buf[2];
+    info.cols = buf[3];
+    info.rows = buf[4];
+    info.dictOffset = assetHeaderSize + tileInfoSize;
+    info.framesOffset = info.dictOffset + (uint32_t)info.tileCount * tileBytes;
+    info.frameBytes = (uint32_t)info.cols * info.rows * info.indexBytes;
+
+    return info.tileCount > 0 && (info.indexBytes == 2 || (info.indexBytes == 1 && info.tileCount <= 256)) &&
+           info.cols == (header.width + 7) / 8 && info.rows == (header.height + 7) / 8;
+}
+
+inline void tileWriteInfo(const TileInfo &info, uint8_t *buf)
+{
+    memset(buf, 0, tileInfoSize);
+    buf[0] = info.tileCount & 0xFF;
+    buf[1] = info.tileCount >> 8;
+    buf[2] = info.indexBytes;
+    buf[3] = info.cols;
+    buf[4] = info.rows;
+}
+
+// cuts the 8x8 tile at grid position (col, row) out of a row major frame, page layout
+inline void tileFromRows(const AssetHeader &header, const uint8_t *frame, uint8_t col, uint8_t row, uint8_t *tile)
+{
+    for (uint8_t i = 0; i < tileBytes; i++)
+    {
+        uint16_t x = col * 8 + i;
+        uint8_t bits = 0;
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            uint16_t y = row * 8 + k;
+            if (x < header.width && y < header.height && (frame[(uint32_t)y * header.stride + x / 8] & (0x80 >> (x & 7))))
+            {
+                bits |= 1 << k;
+            }
+        }
+        tile[i] = bits;
+    }
+}
+
+inline uint16_t tileIndex(const TileInfo &info, const uint8_t *indices, uint32_t i)
+{
+    return info.indexBytes == 1 ? indices[i] : indices[2 * i] | (indices[2 * i + 1] << 8);
+}
+
+// ORs one tile whose top is at row y into the page buffer, clipped to the buffer
+inline void tileDraw(const uint8_t *tile, uint8_t *buffer, int16_t bufWidth, int16_t bufHeight, int16_t x, int16_t y)
+{
+    if (x <= -8 || x >= bufWidth || y <= -8 || y >= bufHeight)
+    {
+        return;
+    }
+
+    int16_t page = y >= 0 ? y / 8 : -1;
+    uint8_t shift = y & 7;
+    int16_t pages = bufHeight / 8;
+    bool inside = x >= 0 && x + 8 <= bufWidth;
+
+    if (shift == 0 && inside)
+    {
+        // page aligned: the tile is the 8 bytes of the page, one 64 bit OR
+        uint64_t word, bits;
+        uint8_t *dst = buffer + page * bufWidth + x;
+        memcpy(&word, dst, 8);
+        memcpy(&bits, tile, 8);
+        word |= bits;
+        memcpy(dst, &word, 8);
+        return;
+    }
+    if (inside && page >= 0 && page + 1 < pages)
+    {
+        // straddles two pages: low bits end up in the page above, high bits in the one below
+        uint8_t *top = buffer + page * bufWidth + x;
+        uint8_t *bottom = top + bufWidth;
+        for (uint8_t i = 0; i < tileBytes; i++)
+        {
+            top[i] |= tile[i] << shift;
+            bottom[i] |= tile[i] >> (8 - shift);
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < tileBytes; i++)
+    {
+        int16_t col = x + i;
+        if (col < 0 || col >= bufWidth)
+        {
+            continue;
+        }
+        if (page >= 0)
+        {
+            buffer[page * bufWidth + col] |= tile[i] << shift;
+        }
+        if (shift && page + 1 < pages)
+        {
+            buffer[(page + 1) * bufWidth + col] |= tile[i] >> (8 - shift);
+        }
+    }
+}
+
+// ORs a whole frame with its top left corner at (x, y), indices outside the dictionary are skipped
+inline void tileBlit(const TileInfo &info, const uint8_t *dict, const uint8_t *indices, uint8_t *buffer,
+                     int16_t bufWidth, int16_t bufHeight, int16_t x, int16_t y)
+{
+    uint32_t i = 0;
+    for (uint8_t row = 0; row < info.rows; row++)
+    {
+        for (uint8_t col = 0; col < info.cols; col++, i++)
+        {
+            uint16_t id = tileIndex(info, indices, i);
+            if (id < info.tileCount)
+            {
+                tileDraw(dict + id * tileBytes, buffer, bufWidth, bufHeight, x + col * 8, y + row * 8);
+            }
+        }
+    }
+}
+
+#endif // TILECODEC_H
@@ -0,0 +1,642 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: fuzz_assets.cpp
+//
+// Description:
+//
+// fuzz harness of everything that parses bytes read from the SD card:
+// the asset header and sparse boxes (assetFormat.h), the delta and
+// tile codecs (frameCodec.h, tileCodec.h), the pack directory
+// (framePack.h), the asset index (assetIndex.h) and loadAnimation()
+// itself. The first input byte picks the target, the rest is the
+// file. Besides not crashing, every target checks its properties:
+//
+//   - a parsed header or box describes a frame that fits its buffer
+//   - a frame returned by animFrame() lies inside the buffer that
+//     loadAnimation() allocated (or the cache slot of the pack), for
+//     every frame below the frame count it reports
+//   - a load never allocates more than the ESP32 heap holds
+//
+// A broken property aborts, like a sanitizer report. Built with clang
+// the harness is fuzz_assets_libfuzzer, driven by libFuzzer:
+//
+//   fuzz_assets_libfuzzer -max_len=65536 corpus asset_compile
+//
+// Built without ANIM_LIBFUZZER it has its own deterministic driver,
+// run by ctest on the assets of "assetpack compile":
+//
+//   fuzz_assets [--runs N] [--seed S] <file or folder>...
+//
+// which runs every file against every target, plus the index the card
+// scan writes, then mutates them (bit flips, interesting values in the
+// headers, copies, truncation) for N runs. An input that breaks a
+// property is written to fuzz_crash.bin, replayed with
+// "fuzz_assets --replay fuzz_crash.bin".
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef __SANITIZE_ADDRESS__
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "hostCard.h"
+#include "hostHeap.h"
+
+AssetIndex assetIndex;
+FramePack framePack;
+
+static const char *fuzzCard = "fuzz_assets.card";
+static const char *fuzzPath = "/fuzz.bin";
+static const uint32_t fuzzMaxFrames = 96;    // frames walked per input, enough to wrap every loop
+static const int16_t fuzzScreenWidth = 128;
+static const int16_t fuzzScreenHeight = 64;
+
+enum FuzzTarget : uint8_t
+{
+    FUZZ_HEADER,
+    FUZZ_DELTA,
+    FUZZ_TILES,
+    FUZZ_PACK,
+    FUZZ_INDEX,
+    FUZZ_LOAD,
+    FUZZ_LOAD_STREAMED,
+    FUZZ_PACK_LOAD,
+    FUZZ_TARGETS
+};
+
+static const char *fuzzTargetNames[FUZZ_TARGETS] = {"header", "delta", "tiles", "pack",
+                                                    "index", "load", "load-streamed", "pack-load"};
+
+#define FUZZ_REQUIRE(cond)                                                       \
+    do                                                                           \
+    {                                                                            \
+        if (!(cond))                                                             \
+        {                                                                        \
+            fprintf(stderr, "%s:%d: %s violated\n", __FILE__, __LINE__, #cond); \
+            fuzzFailed();                                                        \
+        }                                                                        \
+    } while (0)
+
+static const uint8_t *fuzzInput = nullptr;
+static size_t fuzzInputLen = 0;
+
+static void fuzzSaveInput()
+{
+    FILE *out = fopen("fuzz_crash.bin", "wb");
+    if (out)
+    {
+        fwrite(fuzzInput, 1, fuzzInputLen, out);
+        fclose(out);
+    }
+}
+
+static void fuzzFailed()
+{
+    fuzzSaveInput();
+    abort();
+}
+
+static bool fuzzWrite(const char *path, const uint8_t *data, size_t len)
+{
+    File file = SD.open(path, FILE_WRITE);
+    bool ok = file && file.write(data, len) == len;
+    file.close();
+    return ok;
+}
+
+struct FuzzBuffer
+{
+    const uint8_t *data;
+    size_t len;
+};
+
+static const uint8_t *fuzzFetch(void *ctx, uint32_t offset, uint32_t len)
+{
+    const FuzzBuffer &buffer = *(const FuzzBuffer *)ctx;
+    return (uint64_t)offset + len <= buffer.len ? buffer.data + offset : nullptr;
+}
+
+static void fuzzHeader(const uint8_t *data, size_t len)
+{
+    AssetHeader header;
+    if (!assetParseHeader(data, len, header))
+    {
+        return;
+    }
+    FUZZ_REQUIRE(header.width > 0 && header.height > 0 && header.stride >= assetMinStride(header.width));
+    FUZZ_REQUIRE(assetMaxFrameBytes(header) >= assetFrameBytes(header));
+
+    uint8_t written[assetHeaderSize];
+    assetWriteHeader(header, written);
+    FUZZ_REQUIRE(memcmp(written, data, assetHeaderSize) == 0);
+
+    // the same geometry as a sparse frame of a pack
+    AssetHeader sparse = header;
+    sparse.encoding = ASSET_SPARSE;
+
+    // a box accepted by assetBoxValid() must fit the slot of one frame
+    if (len >= assetHeaderSize + assetBoxSize)
+    {
+        AssetBox box;
+        assetReadBox(data + assetHeaderSize, box);
+        if (assetBoxValid(sparse, box))
+        {
+            FUZZ_REQUIRE(assetBoxSize + assetBoxBytes(box) <= assetMaxFrameBytes(sparse));
+        }
+    }
+
+    // the sparse encoding of the frame following the header gives a valid box and fits its bound
+    uint32_t frameBytes = assetFrameBytes(header);
+    if (frameBytes <= animFrameLimit && len >= assetHeaderSize + frameBytes)
+    {
+        std::vector<uint8_t> out(assetMaxFrameBytes(sparse));
+        uint32_t size = assetSparseEncode(sparse, data + assetHeaderSize, out.data());
+        AssetBox box;
+        assetReadBox(out.data(), box);
+        FUZZ_REQUIRE(size <= out.size() && assetBoxValid(sparse, box) && size == assetBoxSize + assetBoxBytes(box));
+    }
+}
+
+static void fuzzDelta(const uint8_t *data, size_t len)
+{
+    AssetHeader header;
+    DeltaInfo info;
+    if (!assetParseHeader(data, len, header) ||
+        !deltaParseInfo(header, data + assetHeaderSize, len - assetHeaderSize, info) ||
+        !deltaFits(header, info, len) || assetFrameBytes(header) > animFrameLimit)
+    {
+        return;
+    }
+    FUZZ_REQUIRE(info.keyCount > 0 && (uint64_t)info.keyCount * info.keyInterval >= header.frameCount);
+
+    // the decoded frame gets exactly its size, the sanitizers catch a write past it
+    std::vector<uint8_t> frame(assetFrameBytes(header));
+    FuzzBuffer buffer = {data, len};
+    DeltaCursor cursor = {frame.data(), (uint32_t)frame.size(), 0, 0};
+    deltaReset(cursor);
+
+    // in order, then jumping around as a wrap and a seek would
+    uint32_t frames = header.frameCount < fuzzMaxFrames ? header.frameCount : fuzzMaxFrames;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        if (deltaSeek(header, info, cursor, f, fuzzFetch, &buffer))
+        {
+            FUZZ_REQUIRE(cursor.current == f && cursor.next <= len);
+        }
+    }
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        uint32_t target = (uint32_t)(((uint64_t)f * 2654435761u) % header.frameCount);
+        if (deltaSeek(header, info, cursor, target, fuzzFetch, &buffer))
+        {
+            FUZZ_REQUIRE(cursor.current == target);
+        }
+    }
+    FUZZ_REQUIRE(!deltaSeek(header, info, cursor, header.frameCount, fuzzFetch, &buffer));
+}
+
+static void fuzzTiles(const uint8_t *data, size_t len)
+{
+    AssetHeader header;
+    TileInfo info;
+    if (!assetParseHeader(data, len, header) ||
+        !tileParseInfo(header, data + assetHeaderSize, len - assetHeaderSize, info) || info.framesOffset > len)
+    {
+        return;
+    }
+    FUZZ_REQUIRE(info.frameBytes > 0 && info.dictOffset + (uint32_t)info.tileCount * tileBytes == info.framesOffset);
+
+    // copies of exactly the sizes the loader allocates
+    std::vector<uint8_t> dict(data + info.dictOffset, data + info.framesOffset);
+    std::vector<uint8_t> screen(fuzzScreenWidth * fuzzScreenHeight / 8);
+    uint32_t frames = (len - info.framesOffset) / info.frameBytes;
+    frames = frames < fuzzMaxFrames ? frames : fuzzMaxFrames;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        std::vector<uint8_t> indices(data + info.framesOffset + f * info.frameBytes,
+                                     data + info.framesOffset + (f + 1) * info.frameBytes);
+        // positions all around and across the screen edges
+        int16_t x = (int16_t)(f * 37 % 200) - 60;
+        int16_t y = (int16_t)(f * 23 % 120) - 40;
+        tileBlit(info, dict.data(), indices.data(), screen.data(), fuzzScreenWidth, fuzzScreenHeight, x, y);
+    }
+}
+
+static void fuzzPack(const uint8_t *data, size_t len)
+{
+    FramePackDir pack;
+    if (!packParseDir(data, len, pack))
+    {
+        return;
+    }
+    FUZZ_REQUIRE(pack.dirSize <= len && (uint64_t)pack.offsetTable + (uint64_t)pack.uniqueCount * 4 == pack.dirSize);
+
+    for (uint16_t a = 0; a < pack.animCount; a++)
+    {
+        PackEntry entry;
+        packEntry(pack, a, entry);
+        FUZZ_REQUIRE(memchr(entry.name, 0, packNameMax) != nullptr);
+        int16_t found = packFind(pack, entry.name);
+        FUZZ_REQUIRE(found >= 0 && found <= a);
+
+        uint32_t frames = entry.header.frameCount < fuzzMaxFrames ? entry.header.frameCount : fuzzMaxFrames;
+        for (uint32_t f = 0; f < frames; f++)
+        {
+            uint16_t id = packFrameId(pack, entry, f);
+            FUZZ_REQUIRE(id < pack.uniqueCount);
+            uint32_t offset = packFrameOffset(pack, id);
+            if (entry.header.encoding == ASSET_SPARSE && (uint64_t)offset + assetBoxSize <= len)
+            {
+                AssetBox box;
+                assetReadBox(data + offset, box);
+                if (assetBoxValid(entry.header, box))
+                {
+                    FUZZ_REQUIRE(assetBoxSize + assetBoxBytes(box) <= assetMaxFrameBytes(entry.header));
+                }
+            }
+        }
+    }
+}
+
+static void fuzzIndex(const uint8_t *data, size_t len)
+{
+    // the index file as read back on boot, with the fingerprint it claims so it gets parsed
+    AssetIndex index;
+    uint64_t fingerprint = 0;
+    if (len >= sizeof(AssetIndexFileHeader))
+    {
+        memcpy(&fingerprint, data + offsetof(AssetIndexFileHeader, fingerprint), sizeof(fingerprint));
+    }
+    if (fuzzWrite(assetIndexPath, data, len) && assetIndexLoad(SD, fingerprint, index))
+    {
+        FUZZ_REQUIRE(index.count <= assetIndexMax);
+        for (uint16_t i = 0; i < index.count; i++)
+        {
+            FUZZ_REQUIRE(memchr(index.entries[i].path, 0, assetPathMax) != nullptr);
+            FUZZ_REQUIRE(index.entries[i].width > 0 && index.entries[i].height > 0);
+        }
+        assetIndexFind(index, fuzzPath);
+    }
+    SD.remove(assetIndexPath);
+
+    // the same bytes as an animation file met by the card scan
+    AssetIndexEntry entry;
+    File file = fuzzWrite(fuzzPath, data, len) ? SD.open(fuzzPath) : File();
+    if (file && assetIndexValidate(file, fuzzPath, entry))
+    {
+        FUZZ_REQUIRE(entry.frameCount > 0 && entry.size == len);
+        if (entry.encoding == ASSET_RAW)
+        {
+            FUZZ_REQUIRE(entry.dataOffset + (uint64_t)entry.frameCount * entry.stride * entry.height <= len);
+        }
+    }
+    file.close();
+}
+
+// the buffer loadAnimation() set up for the frames of the asset
+static bool fuzzFrameInside(const AnimAsset &asset, const uint8_t *frame)
+{
+    const uint8_t *begin = asset.data;
+    size_t bytes = asset.frameBytes;
+    size_t size = asset.streaming ? asset.frameBytes : (size_t)asset.header.frameCount * asset.frameBytes;
+    if (asset.packed)
+    {
+        begin = framePack.cache.pool;
+        bytes = assetMaxFrameBytes(asset.header);
+        size = (size_t)framePack.cache.slots * framePack.cache.slotBytes;
+    }
+    else if (asset.decoded)
+    {
+        begin = asset.decoded;
+        size = asset.frameBytes;
+    }
+    return frame && begin && frame >= begin && frame + bytes <= begin + size;
+}
+
+// loads the animation and shows every frame, checking where they come from
+static void fuzzPlay(const AnimDesc &anim)
+{
+    size_t heapBefore = hostHeap().used;
+    hostHeapResetPeak();
+
+    AnimAsset asset;
+    bool loaded = loadAnimation(anim.path, anim, asset);
+    FUZZ_REQUIRE(hostHeap().peak - heapBefore <= hostHeapSize);
+    if (!loaded)
+    {
+        FUZZ_REQUIRE(asset.data == nullptr && asset.decoded == nullptr && asset.dict == nullptr);
+        return;
+    }
+    FUZZ_REQUIRE(asset.header.frameCount > 0 && asset.frameBytes > 0);
+
+    std::vector<uint8_t> screen(fuzzScreenWidth * fuzzScreenHeight / 8);
+    uint32_t frames = asset.header.frameCount < fuzzMaxFrames ? asset.header.frameCount : fuzzMaxFrames;
+    for (uint32_t step = 0; step < frames + 2; step++)
+    {
+        // in order with a wrap around, like the player
+        uint32_t frame = step % asset.header.frameCount;
+        const uint8_t *bits = animFrame(asset, frame);
+        FUZZ_REQUIRE(fuzzFrameInside(asset, bits));
+        if (asset.header.encoding == ASSET_TILES)
+        {
+            tileBlit(asset.tiles, asset.dict, bits, screen.data(), fuzzScreenWidth, fuzzScreenHeight, 0, 0);
+        }
+        else if (asset.header.encoding == ASSET_SPARSE)
+        {
+            AssetBox box;
+            assetReadBox(bits, box);
+            FUZZ_REQUIRE(assetBoxValid(asset.header, box));
+        }
+    }
+    unloadAnimation(asset);
+}
+
+static void fuzzLoad(const uint8_t *data, size_t len, bool streamed)
+{
+    if (!fuzzWrite(fuzzPath, data, len))
+    {
+        return;
+    }
+    uint32_t limit = animLoadLimit;
+    animLoadLimit = streamed ? 0 : limit;
+    // headerless files get the 48x48 geometry of the registry
+    const AnimDesc anim = {AnimCategory::Icons, "fuzz", fuzzPath, "fuzz", framewidth, frameheight, 0};
+    fuzzPlay(anim);
+    animLoadLimit = limit;
+}
+
+static void fuzzPackLoad(const uint8_t *data, size_t len)
+{
+    if (!fuzzWrite("/anims.pak", data, len) || !framePackOpen(SD, "/anims.pak", framePack))
+    {
+        return;
+    }
+    FUZZ_REQUIRE(framePack.cache.slotBytes <= animFrameLimit);
+
+    uint16_t anims = framePack.dir.animCount < 8 ? framePack.dir.animCount : 8;
+    for (uint16_t a = 0; a < anims; a++)
+    {
+        PackEntry entry;
+        packEntry(framePack.dir, a, entry);
+        const AnimDesc anim = {AnimCategory::Icons, entry.name, fuzzPath, entry.name, 0, 0, 0};
+        fuzzPlay(anim);
+    }
+    framePackClose(framePack);
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+#if defined(__SANITIZE_ADDRESS__) && !defined(ANIM_LIBFUZZER)
+    // libFuzzer keeps the crashing input itself
+    __sanitizer_set_death_callback(fuzzSaveInput);
+#endif
+    hostSerialOutput(nullptr);
+    if (!hostCardImage(ANIM_FILES_DIR, fuzzCard) || !SD.begin(5))
+    {
+        fprintf(stderr, "cannot prepare %s\n", fuzzCard);
+        exit(1);
+    }
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *input, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    fuzzInput = input;
+    fuzzInputLen = size;
+
+    // the target gets its own copy, a read past the end is caught by the sanitizers
+    std::vector<uint8_t> file(input + 1, input + size);
+    const uint8_t *data = file.data();
+    size_t len = file.size();
+    switch (input[0] % FUZZ_TARGETS)
+    {
+    case FUZZ_HEADER:
+        fuzzHeader(data, len);
+        break;
+    case FUZZ_DELTA:
+        fuzzDelta(data, len);
+        break;
+    case FUZZ_TILES:
+        fuzzTiles(data, len);
+        break;
+    case FUZZ_PACK:
+        fuzzPack(data, len);
+        break;
+    case FUZZ_INDEX:
+        fuzzIndex(data, len);
+        break;
+    case FUZZ_LOAD:
+        fuzzLoad(data, len, false);
+        break;
+    case FUZZ_LOAD_STREAMED:
+        fuzzLoad(data, len, true);
+        break;
+    case FUZZ_PACK_LOAD:
+        fuzzPackLoad(data, len);
+        break;
+    }
+    return 0;
+}
+
+#ifndef ANIM_LIBFUZZER
+
+static uint64_t fuzzRandomState = 0x0BA1F022;
+
+// xorshift64*, the runs are the same on every machine
+static uint32_t fuzzRandom(uint32_t range)
+{
+    fuzzRandomState ^= fuzzRandomState >> 12;
+    fuzzRandomState ^= fuzzRandomState << 25;
+    fuzzRandomState ^= fuzzRandomState >> 27;
+    return (uint32_t)((fuzzRandomState * 0x2545F4914F6CDD1DULL) >> 32) % range;
+}
+
+// values that sit on the bounds the parsers check
+static const uint32_t fuzzInteresting[] = {0, 1, 2, 7, 8, 0x7F, 0x80, 0xFF, 0x100, 0x7FFF, 0x8000, 0xFFFF,
+                                           0x10000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFE, 0xFFFFFFFF};
+static const uint8_t fuzzInterestingCount = sizeof(fuzzInteresting) / sizeof(fuzzInteresting[0]);
+
+// one to four edits, most of them in the headers and tables at the front of the file
+static void fuzzMutate(std::vector<uint8_t> &input)
+{
+    uint8_t edits = 1 + fuzzRandom(4);
+    for (uint8_t e = 0; e < edits && input.size() > 1; e++)
+    {
+        size_t front = input.size() < 256 ? input.size() : 256;
+        size_t pos = 1 + fuzzRandom(fuzzRandom(2) ? front - 1 : input.size() - 1);
+        switch (fuzzRandom(5))
+        {
+        case 0:
+            input[pos] ^= 1 << fuzzRandom(8);
+            break;
+        case 1:
+            input[pos] = fuzzRandom(256);
+            break;
+        case 2:
+        {
+            // little endian 16 or 32 bit value
+            uint32_t value = fuzzInteresting[fuzzRandom(fuzzInterestingCount)];
+            uint8_t bytes = fuzzRandom(2) ? 2 : 4;
+            for (uint8_t b = 0; b < bytes && pos + b < input.size(); b++)
+            {
+                input[pos + b] = value >> (8 * b);
+            }
+            break;
+        }
+        case 3:
+            input.resize(pos);
+            break;
+        default:
+        {
+            // a copy of another part of the file, like a table entry pointing elsewhere
+            size_t from = 1 + fuzzRandom(input.size() - 1);
+            size_t n = 1 + fuzzRandom(16);
+            for (size_t k = 0; k < n && pos + k < input.size() && from + k < input.size(); k++)
+            {
+                input[pos + k] = input[from + k];
+            }
+            break;
+        }
+        }
+    }
+}
+
+static bool fuzzReadFile(const std::string &path, std::vector<uint8_t> &bytes)
+{
+    FILE *in = fopen(path.c_str(), "rb");
+    if (!in)
+    {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0)
+    {
+        bytes.insert(bytes.end(), chunk, chunk + n);
+    }
+    fclose(in);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runs = 10000;
+    const char *replay = nullptr;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            replay = argv[++i];
+        }
+        else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+        {
+            runs = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            fuzzRandomState = strtoull(argv[++i], nullptr, 0) | 1;
+        }
+        else if (std::filesystem::is_directory(argv[i]))
+        {
+            for (const auto &entry : std::filesystem::directory_iterator(argv[i]))
+            {
+                paths.push_back(entry.path().string());
+            }
+        }
+        else
+        {
+            paths.push_back(argv[i]);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    LLVMFuzzerInitialize(&argc, &argv);
+    if (replay)
+    {
+        std::vector<uint8_t> input;
+        if (!fuzzReadFile(replay, input))
+        {
+            fprintf(stderr, "cannot read %s\n", replay);
+            return 1;
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+        printf("%s: no property broken\n", replay);
+        return 0;
+    }
+
+    // every file with every target byte in front
+    std::vector<std::vector<uint8_t>> seeds;
+    for (const std::string &path : paths)
+    {
+        std::vector<uint8_t> file;
+        if (!fuzzReadFile(path, file))
+        {
+            fprintf(stderr, "cannot read %s\n", path.c_str());
+            return 1;
+        }
+        for (uint8_t t = 0; t < FUZZ_TARGETS; t++)
+        {
+            seeds.push_back({t});
+            seeds.back().insert(seeds.back().end(), file.begin(), file.end());
+        }
+    }
+    if (seeds.empty())
+    {
+        fprintf(stderr, "usage: fuzz_assets [--runs N] [--seed S] <file or folder>...\n");
+        fprintf(stderr, "       fuzz_assets --replay <input>\n");
+        return 1;
+    }
+
+    // a real index, from a scan of the card
+    assetIndexScan(SD, assetIndex);
+    std::vector<uint8_t> index;
+    if (assetIndexSave(SD, assetIndex) && fuzzReadFile(std::string(fuzzCard) + assetIndexPath, index))
+    {
+        seeds.push_back({FUZZ_INDEX});
+        seeds.back().insert(seeds.back().end(), index.begin(), index.end());
+    }
+    uint32_t perTarget[FUZZ_TARGETS] = {};
+    for (const std::vector<uint8_t> &seed : seeds)
+    {
+        LLVMFuzzerTestOneInput(seed.data(), seed.size());
+    }
+    for (uint32_t r = 0; r < runs; r++)
+    {
+        std::vector<uint8_t> input = seeds[fuzzRandom(seeds.size())];
+        fuzzMutate(input);
+        perTarget[input[0] % FUZZ_TARGETS]++;
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    printf("fuzz_assets: %u seeds, %u mutated inputs, no property broken\n", (unsigned)seeds.size(), runs);
+    for (uint8_t t = 0; t < FUZZ_TARGETS; t++)
+    {
+        printf("  %-14s %u\n", fuzzTargetNames[t], perTarget[t]);
+    }
+    return 0;
+}
+
+#endif // ANIM_LIBFUZZER
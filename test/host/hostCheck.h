@@ -0,0 +1,48 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: hostCheck.h
+//
+// Description:
+//
+// the checks of the host tests: CHECK(cond) reports the file, line
+// and condition of a failed check on stderr and counts it, the test
+// goes on. main() ends with return checkResult("name"), which gives
+// the exit code ctest looks at.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef HOSTCHECK_H
+#define HOSTCHECK_H
+
+#include <stdio.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+// prints the outcome, returns the exit code of the test
+static int checkResult(const char *name)
+{
+    if (failures)
+    {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("%s: all checks passed\n", name);
+    return 0;
+}
+
+#endif // HOSTCHECK_H
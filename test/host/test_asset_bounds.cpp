@@ -0,0 +1,342 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_asset_bounds.cpp
+//
+// Description:
+//
+// bounds properties of loadAnimation() on damaged and lying files:
+// the frame count never goes beyond what the file holds, whatever the
+// header claims and wherever the file is cut, and the inputs the fuzz
+// harness (fuzz_assets.cpp) turned up stay refused: a delta key count
+// that wraps, frames too big to decode, index entries without their
+// terminating zero and headerless files of no geometry. An index whose
+// files were touched or replaced in the same clusters is not reused.
+// A read failing on the card fails the load, or empties the frame.
+// A card of the first releases is renamed to the registry paths. Short
+// of heap, the pack falls back to one cache slot, then to no pack.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "hostCard.h"
+#include "hostHeap.h"
+#include "hostCheck.h"
+
+AssetIndex assetIndex;
+FramePack framePack;
+
+static const AnimDesc testAnim = {AnimCategory::Icons, "bounds", "/bounds.bin", "bounds", 48, 48, 0};
+
+static void writeFile(const char *path, const std::vector<uint8_t> &bytes)
+{
+    File file = SD.open(path, FILE_WRITE);
+    file.write(bytes.data(), bytes.size());
+    file.close();
+}
+
+static std::vector<uint8_t> readFile(const char *path)
+{
+    File file = SD.open(path);
+    std::vector<uint8_t> bytes(file ? file.size() : 0);
+    file.read(bytes.data(), bytes.size());
+    file.close();
+    return bytes;
+}
+
+static std::vector<uint8_t> withHeader(const AssetHeader &header, const std::vector<uint8_t> &body)
+{
+    std::vector<uint8_t> file(assetHeaderSize + body.size());
+    assetWriteHeader(header, file.data());
+    std::copy(body.begin(), body.end(), file.begin() + assetHeaderSize);
+    return file;
+}
+
+// frame count clamped to the bytes read, at every cut and for every lie of the header
+static void testTruncated()
+{
+    std::vector<uint8_t> frames = readFile("/bell.bin");
+    uint32_t frameBytes = 288;
+    uint32_t real = frames.size() / frameBytes;
+    CHECK(real > 2);
+
+    for (uint32_t claimed : {1u, real - 1, real, real + 1, 0x10000u, 0xFFFFFFFFu})
+    {
+        AssetHeader header = {assetVersion, ASSET_RAW, 48, 48, 6, claimed};
+        std::vector<uint8_t> file = withHeader(header, frames);
+        for (uint32_t cut = 0; cut <= file.size(); cut += 97)
+        {
+            for (uint32_t limit : {0u, 32u * 1024})
+            {
+                writeFile(testAnim.path, std::vector<uint8_t>(file.begin(), file.begin() + cut));
+                animLoadLimit = limit;
+                AnimAsset asset;
+                bool loaded = loadAnimation(testAnim.path, testAnim, asset);
+                uint32_t available = cut < assetHeaderSize ? 0 : (cut - assetHeaderSize) / frameBytes;
+                // short files are taken for headerless dumps
+                uint32_t expected = cut < assetHeaderSize ? 0 : (claimed < available ? claimed : available);
+                CHECK(loaded == (expected > 0));
+                if (loaded)
+                {
+                    CHECK(asset.header.frameCount == expected);
+                    CHECK(asset.streaming == (limit == 0));
+                    CHECK(animFrame(asset, expected - 1) != nullptr);
+                    unloadAnimation(asset);
+                }
+            }
+        }
+    }
+    animLoadLimit = 32 * 1024;
+}
+
+// reads failing on the card: the load fails or the frame shows empty, never bytes left in the buffer
+static void testShortReads()
+{
+    std::vector<uint8_t> frames = readFile("/bell.bin");
+    writeFile(testAnim.path, frames);
+    fs::FSTiming timing = SD.timing;
+    fs::FSTiming failing = timing;
+    failing.clock = 2;
+    failing.maxClock = 1;
+
+    for (uint32_t limit : {0u, 32u * 1024})
+    {
+        animLoadLimit = limit;
+        AnimAsset asset;
+        SD.timing = failing;
+        CHECK(!loadAnimation(testAnim.path, testAnim, asset));
+        CHECK(asset.data == nullptr && asset.dict == nullptr);
+        SD.timing = timing;
+    }
+
+    // streaming: a failed frame is empty, the next one is read from its own place
+    animLoadLimit = 0;
+    AnimAsset asset;
+    CHECK(loadAnimation(testAnim.path, testAnim, asset) && asset.streaming);
+    CHECK(!memcmp(animFrame(asset, 1), &frames[288], 288));
+    SD.timing = failing;
+    const uint8_t *frame = animFrame(asset, 2);
+    CHECK(std::all_of(frame, frame + 288, [](uint8_t b) { return b == 0; }));
+    SD.timing = timing;
+    CHECK(!memcmp(animFrame(asset, 3), &frames[3 * 288], 288));
+    CHECK(!memcmp(animFrame(asset, 4), &frames[4 * 288], 288));
+    unloadAnimation(asset);
+    animLoadLimit = 32 * 1024;
+}
+
+// frameCount + K - 1 used to wrap, a key count of 0 then matched any huge frame count
+static void testDeltaKeyCount()
+{
+    AssetHeader header = {assetVersion, ASSET_DELTA, 48, 48, 6, 0xFFFFFFFFu};
+    uint8_t info[deltaInfoSize] = {2, 0, 0, 0, 0, 0, 0, 0};
+    DeltaInfo delta;
+    CHECK(!deltaParseInfo(header, info, sizeof(info), delta));
+
+    // a seek table and length prefixes that cannot be in the file
+    header.frameCount = 1000;
+    info[4] = 500 & 0xFF;
+    info[5] = 500 >> 8;
+    CHECK(deltaParseInfo(header, info, sizeof(info), delta));
+    CHECK(!deltaFits(header, delta, assetHeaderSize + deltaInfoSize + 500 * 4 + 1999));
+    CHECK(deltaFits(header, delta, assetHeaderSize + deltaInfoSize + 500 * 4 + 2000));
+
+    std::vector<uint8_t> file = withHeader(header, std::vector<uint8_t>(info, info + sizeof(info)));
+    file.resize(file.size() + 500 * 4 + 100);
+    writeFile(testAnim.path, file);
+    AnimAsset asset;
+    CHECK(!loadAnimation(testAnim.path, testAnim, asset));
+}
+
+// a delta coded frame does not need its size in the file, the geometry alone must not allocate
+static void testDeltaFrameSize()
+{
+    AssetHeader header = {assetVersion, ASSET_DELTA, 0xFFFF, 0xFFFF, 0x2000, 1};
+    uint8_t info[deltaInfoSize] = {1, 0, 0, 0, 1, 0, 0, 0};
+    std::vector<uint8_t> file = withHeader(header, std::vector<uint8_t>(info, info + sizeof(info)));
+    uint8_t key[6] = {assetHeaderSize + deltaInfoSize + 4, 0, 0, 0, 0, 0}; // seek table, empty keyframe
+    file.insert(file.end(), key, key + sizeof(key));
+    writeFile(testAnim.path, file);
+
+    size_t before = hostHeap().used;
+    hostHeapResetPeak();
+    AnimAsset asset;
+    CHECK(!loadAnimation(testAnim.path, testAnim, asset));
+    CHECK(hostHeap().peak - before < animFrameLimit);
+}
+
+// the cache slots are as big as the biggest frame of the pack
+static void testPackFrameSize()
+{
+    std::vector<uint8_t> pack(packHeaderSize + packEntrySize + 2 + 4);
+    memcpy(pack.data(), packMagic, 4);
+    pack[4] = packVersion;
+    packWrite16(&pack[6], 1);
+    packWrite32(&pack[8], 1);
+    packWrite32(&pack[12], packHeaderSize + packEntrySize + 2);
+    uint8_t *entry = &pack[packHeaderSize];
+    strcpy((char *)entry, "huge");
+    packWrite16(entry + 32, 4096);
+    packWrite16(entry + 34, 4096);
+    packWrite16(entry + 36, 512);
+    entry[38] = ASSET_RAW;
+    packWrite32(entry + 40, 1);
+    packWrite32(entry + 44, packHeaderSize + packEntrySize);
+    packWrite32(&pack[packHeaderSize + packEntrySize + 2], pack.size());
+    writeFile("/anims.pak", pack);
+
+    CHECK(!framePackOpen(SD, "/anims.pak", framePack));
+    CHECK(!framePack.open);
+
+    // the same pack with frames that fit is fine
+    packWrite16(entry + 32, 48);
+    packWrite16(entry + 34, 48);
+    packWrite16(entry + 36, 6);
+    writeFile("/anims.pak", pack);
+    size_t used = hostHeap().used;
+    hostHeapResetPeak();
+    CHECK(framePackOpen(SD, "/anims.pak", framePack));
+    CHECK(framePack.cache.slots == framePackCacheSlots && framePack.cache.slotBytes == 288);
+    size_t cacheBytes = framePackCacheSlots * (288 + 2 * sizeof(uint32_t));
+    size_t others = hostHeap().peak - used - cacheBytes; // directory and file
+    framePackClose(framePack);
+
+    // no heap for the whole cache: a single slot, every frame read when shown
+    hostHeapLimit(used + others + 2 * 288);
+    CHECK(framePackOpen(SD, "/anims.pak", framePack));
+    CHECK(framePack.open && framePack.cache.slots == 1);
+    AnimAsset asset;
+    const AnimDesc huge = {AnimCategory::Icons, "huge", "/huge.bin", "huge", 48, 48, 0};
+    CHECK(loadAnimation(huge.path, huge, asset) && asset.packed);
+    CHECK(animFrame(asset, 0) != nullptr);
+    unloadAnimation(asset);
+    framePackClose(framePack);
+
+    // not even one slot: no pack, the animations come from their own files
+    hostHeapLimit(used + others + 100);
+    CHECK(!framePackOpen(SD, "/anims.pak", framePack));
+    CHECK(!framePack.open && hostHeap().used == used);
+    hostHeapLimit(0);
+    SD.remove("/anims.pak");
+}
+
+// the index is read back as is, its paths are compared with strcmp
+static void testIndexEntries()
+{
+    AssetIndex index;
+    assetIndexScan(SD, index);
+    CHECK(index.count > 0);
+    index.fingerprint = 1234;
+    CHECK(assetIndexSave(SD, index));
+    CHECK(assetIndexLoad(SD, 1234, index));
+
+    std::vector<uint8_t> file = readFile(assetIndexPath);
+    std::vector<uint8_t> damaged = file;
+    memset(&damaged[sizeof(AssetIndexFileHeader)], 'x', assetPathMax);
+    writeFile(assetIndexPath, damaged);
+    CHECK(!assetIndexLoad(SD, 1234, index));
+
+    damaged = file;
+    memset(&damaged[sizeof(AssetIndexFileHeader) + offsetof(AssetIndexEntry, width)], 0, 2);
+    writeFile(assetIndexPath, damaged);
+    CHECK(!assetIndexLoad(SD, 1234, index));
+    SD.remove(assetIndexPath);
+}
+
+// same used bytes on the card, the entries tell a touched or replaced file
+static void testIndexStale()
+{
+    AssetIndex index;
+    assetIndexScan(SD, index);
+    index.fingerprint = 1234;
+    CHECK(assetIndexSave(SD, index));
+    CHECK(assetIndexLoad(SD, 1234, index));
+
+    // touched: same bytes, a later modification time
+    std::filesystem::path bell = std::filesystem::path("test_asset_bounds.card") / "bell.bin";
+    std::filesystem::file_time_type written = std::filesystem::last_write_time(bell);
+    std::filesystem::last_write_time(bell, written + std::chrono::seconds(10));
+    CHECK(!assetIndexLoad(SD, 1234, index));
+    std::filesystem::last_write_time(bell, written);
+    CHECK(assetIndexLoad(SD, 1234, index));
+
+    // replaced by a file one frame shorter, in the same clusters
+    std::vector<uint8_t> frames = readFile("/bell.bin");
+    uint64_t used = SD.usedBytes();
+    writeFile("/bell.bin", std::vector<uint8_t>(frames.begin(), frames.end() - 288));
+    std::filesystem::last_write_time(bell, written);
+    CHECK(SD.usedBytes() == used);
+    CHECK(!assetIndexLoad(SD, 1234, index));
+    writeFile("/bell.bin", frames);
+    SD.remove(assetIndexPath);
+}
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+// a card of the first releases: the registry files under their 8.3 names
+static void testIndexMigrate()
+{
+    SD.remove(assetIndexPath);
+    CHECK(SD.rename("/bell.bin", "/by_bell.bin"));
+    CHECK(SD.rename("/gear.bin", "/by_gear.bin"));
+    writeFile("/by_home.bin", readFile("/by_bell.bin"));
+
+    AssetIndex index;
+    CHECK(!assetIndexBegin(SD, cardFingerprint, index));
+    CHECK(SD.exists("/bell.bin") && !SD.exists("/by_bell.bin"));
+    CHECK(SD.exists("/gear.bin") && !SD.exists("/by_gear.bin"));
+    CHECK(assetIndexFind(index, "/bell.bin") && assetIndexFind(index, "/gear.bin"));
+    // both names on the card: the long one is kept, the 8.3 one left alone
+    CHECK(SD.exists("/by_home.bin") && readFile("/home.bin") != readFile("/by_home.bin"));
+    CHECK(assetIndexMigrate(SD) == 0);
+    SD.remove("/by_home.bin");
+    SD.remove(assetIndexPath);
+}
+
+// geometry of a headerless file comes from its entry, 0x0 used to divide by zero
+static void testNoGeometry()
+{
+    writeFile(testAnim.path, readFile("/bell.bin"));
+    const AnimDesc anim = {AnimCategory::Icons, "bounds", "/bounds.bin", "bounds", 0, 0, 0};
+    AnimAsset asset;
+    CHECK(!loadAnimation(anim.path, anim, asset));
+    CHECK(asset.data == nullptr);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    if (!hostCardImage(ANIM_FILES_DIR, "test_asset_bounds.card") || !SD.begin(5))
+    {
+        fprintf(stderr, "cannot prepare the card\n");
+        return 1;
+    }
+
+    testTruncated();
+    testShortReads();
+    testDeltaKeyCount();
+    testDeltaFrameSize();
+    testPackFrameSize();
+    testIndexEntries();
+    testIndexStale();
+    testIndexMigrate();
+    testNoGeometry();
+    return checkResult("asset bounds");
+}
@@ -0,0 +1,240 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_asset_source.cpp
+//
+// Description:
+//
+// checks the source readers of the asset compiler (tools/assetSource.h):
+// PROGMEM arrays behind comments and in every number notation, PBM
+// sequences, and GIFs built here with literal codes only, composed
+// with transparency, disposal and interlacing.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <stdio.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "assetSource.h"
+#include "hostCheck.h"
+
+static bool lit(const SourceAsset &asset, uint32_t frame, uint16_t x, uint16_t y)
+{
+    const uint8_t *f = &asset.frames[frame * sourceFrameBytes(asset.width, asset.height)];
+    return f[y * ((asset.width + 7) / 8) + x / 8] & (0x80 >> (x & 7));
+}
+
+static void testProgmem()
+{
+    const char *text = "// const byte PROGMEM skipped[][512] = {};\n"
+                       "/* PROGMEM in a block comment */\n"
+                       "    const byte PROGMEM tiny[2][8] = {\n"
+                       "        {0x01, 2, 0b11, 0, 0, 0, 0, 255},\n"
+                       "        {1}};\n"
+                       "static const unsigned char PROGMEM one[] = {1, 2, 3, 4, 5, 6, 7, 8};\n";
+    std::vector<SourceAsset> assets;
+    std::string error;
+    CHECK(sourceParseProgmem(text, "test.h", 0, 0, assets, error));
+    CHECK(assets.size() == 2);
+    if (assets.size() == 2)
+    {
+        CHECK(assets[0].name == "tiny" && assets[0].width == 8 && assets[0].height == 8);
+        CHECK(assets[0].frames.size() == 16);
+        CHECK(assets[0].frames[0] == 1 && assets[0].frames[2] == 3 && assets[0].frames[7] == 255);
+        CHECK(assets[0].frames[8] == 1 && assets[0].frames[9] == 0);
+        CHECK(assets[1].name == "one" && assets[1].frames.size() == 8 && assets[1].frames[7] == 8);
+    }
+
+    // an explicit size instead of the square guess
+    assets.clear();
+    CHECK(sourceParseProgmem(text, "test.h", 16, 4, assets, error));
+    CHECK(assets.size() == 2 && assets[0].width == 16 && assets[0].height == 4);
+
+    assets.clear();
+    CHECK(!sourceParseProgmem("const byte PROGMEM big[1][8] = {{256}};", "test.h", 0, 0, assets, error));
+    CHECK(!sourceParseProgmem("const byte PROGMEM odd[1][10] = {{0}};", "test.h", 0, 0, assets, error));
+    CHECK(!sourceParseProgmem("const byte PROGMEM open[1][8] = {{0};", "test.h", 0, 0, assets, error));
+    CHECK(error.find("test.h:1: open") == 0);
+}
+
+static void testPbm()
+{
+    std::mt19937 rng(40);
+    std::vector<uint8_t> bits(2 * 2 * 3);
+    for (uint8_t &b : bits)
+    {
+        b = rng();
+    }
+    std::string text = "P4\n# first\n12 3\n" + std::string(bits.begin(), bits.begin() + 6) + "P4 12 3 " +
+                       std::string(bits.begin() + 6, bits.end());
+    SourceAsset asset;
+    asset.origin = "test.pbm";
+    std::string error;
+    CHECK(sourceParsePbm(std::vector<uint8_t>(text.begin(), text.end()), asset, error));
+    CHECK(asset.width == 12 && asset.height == 3 && asset.frames == bits);
+
+    text += "P4 8 3 abc";
+    CHECK(!sourceParsePbm(std::vector<uint8_t>(text.begin(), text.end()), asset, error));
+}
+
+// palette: white, black, grey (transparent where asked), red
+static const uint8_t gifPalette[] = {255, 255, 255, 0, 0, 0, 128, 128, 128, 255, 0, 0};
+
+static void gifWord(std::vector<uint8_t> &gif, uint16_t v)
+{
+    gif.push_back(v & 0xFF);
+    gif.push_back(v >> 8);
+}
+
+// image data of literal 3 bit codes only: a clear code every two pixels keeps the table from growing
+static void gifImage(std::vector<uint8_t> &gif, uint16_t left, uint16_t top, uint16_t w, uint16_t h,
+                     const std::vector<uint8_t> &rows, bool interlace, int transparent, uint8_t disposal)
+{
+    gif.insert(gif.end(), {0x21, 0xF9, 4, (uint8_t)((disposal << 2) | (transparent >= 0)), 0, 0,
+                           (uint8_t)(transparent >= 0 ? transparent : 0), 0});
+    gif.push_back(0x2C);
+    gifWord(gif, left);
+    gifWord(gif, top);
+    gifWord(gif, w);
+    gifWord(gif, h);
+    gif.push_back(interlace ? 0x40 : 0);
+    gif.push_back(2);
+
+    std::vector<uint16_t> order;
+    for (uint16_t y = 0; y < h; y++)
+    {
+        order.push_back(y);
+    }
+    if (interlace)
+    {
+        order.clear();
+        for (uint16_t start : {0, 4, 2, 1})
+        {
+            for (uint16_t y = start; y < h; y += start == 0 ? 8 : start == 4 ? 8 : start == 2 ? 4 : 2)
+            {
+                order.push_back(y);
+            }
+        }
+    }
+
+    std::vector<uint8_t> codes;
+    uint32_t bits = 0, bitCount = 0;
+    auto put = [&](uint8_t code)
+    {
+        bits |= code << bitCount;
+        bitCount += 3;
+        while (bitCount >= 8)
+        {
+            codes.push_back(bits & 0xFF);
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    };
+    uint32_t n = 0;
+    for (uint16_t y : order)
+    {
+        for (uint16_t x = 0; x < w; x++, n++)
+        {
+            if (n % 2 == 0)
+            {
+                put(4);
+            }
+            put(rows[y * w + x]);
+        }
+    }
+    put(5);
+    if (bitCount)
+    {
+        codes.push_back(bits);
+    }
+    for (size_t i = 0; i < codes.size(); i += 255)
+    {
+        size_t len = codes.size() - i < 255 ? codes.size() - i : 255;
+        gif.push_back(len);
+        gif.insert(gif.end(), codes.begin() + i, codes.begin() + i + len);
+    }
+    gif.push_back(0);
+}
+
+static void testGif()
+{
+    const uint16_t w = 16, h = 10;
+    std::mt19937 rng(41);
+    std::vector<uint8_t> gif = {'G', 'I', 'F', '8', '9', 'a'};
+    gifWord(gif, w);
+    gifWord(gif, h);
+    gif.insert(gif.end(), {0x81, 0, 0});
+    gif.insert(gif.end(), gifPalette, gifPalette + sizeof(gifPalette));
+
+    // 1: full screen, every colour, 2: a box drawn over it, partly transparent, then cleared to the background
+    // 3: one pixel on what is left, 4: full screen again, interlaced
+    std::vector<uint8_t> first(w * h), box(6 * 4), last(w * h);
+    for (uint8_t &v : first)
+    {
+        v = rng() % 4;
+    }
+    for (uint8_t &v : box)
+    {
+        v = rng() % 3;
+    }
+    for (uint8_t &v : last)
+    {
+        v = rng() % 2;
+    }
+    gifImage(gif, 0, 0, w, h, first, false, -1, 1);
+    gifImage(gif, 5, 3, 6, 4, box, false, 2, 2);
+    gifImage(gif, 0, 0, 1, 1, {1}, false, -1, 1);
+    gifImage(gif, 0, 0, w, h, last, true, -1, 1);
+    gif.push_back(0x3B);
+
+    SourceAsset asset;
+    asset.origin = "test.gif";
+    std::string error;
+    CHECK(sourceParseGif(gif, false, asset, error));
+    CHECK(asset.width == w && asset.height == h);
+    CHECK(asset.frames.size() == 4 * sourceFrameBytes(w, h));
+    if (asset.frames.size() != 4 * sourceFrameBytes(w, h))
+    {
+        return;
+    }
+
+    uint32_t wrong = 0;
+    for (uint16_t y = 0; y < h; y++)
+    {
+        for (uint16_t x = 0; x < w; x++)
+        {
+            bool inBox = x >= 5 && x < 11 && y >= 3 && y < 7;
+            bool base = first[y * w + x] % 2 == 1; // black and red are dark
+            uint8_t boxed = inBox ? box[(y - 3) * 6 + x - 5] : 2;
+            wrong += lit(asset, 0, x, y) != base;
+            wrong += lit(asset, 1, x, y) != (boxed == 2 ? base : boxed == 1);
+            wrong += lit(asset, 2, x, y) != ((x == 0 && y == 0) || (!inBox && base));
+            wrong += lit(asset, 3, x, y) != (last[y * w + x] == 1);
+        }
+    }
+    CHECK(wrong == 0);
+
+    SourceAsset inverted;
+    inverted.origin = "test.gif";
+    CHECK(sourceParseGif(gif, true, inverted, error));
+    CHECK(inverted.frames.size() == asset.frames.size() && lit(inverted, 0, 1, 1) != lit(asset, 0, 1, 1));
+
+    // cut short inside the image data
+    gif.resize(gif.size() / 2);
+    CHECK(!sourceParseGif(gif, false, asset, error));
+}
+
+int main()
+{
+    testProgmem();
+    testPbm();
+    testGif();
+    return checkResult("asset sources");
+}
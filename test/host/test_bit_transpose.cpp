@@ -0,0 +1,188 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_bit_transpose.cpp
+//
+// Description:
+//
+// checks bitTranspose.h against per pixel references. The 8x8 kernel
+// only moves bits, so mapping each of the 64 single bit words to the
+// right place proves it for every word; every value of every row byte
+// and random words are checked on top. The page conversion is checked
+// for every size up to 24x24 with tight and padded rows whose padding
+// bits are set, and bitBlitRows() like drawBitmap() at every position
+// on and around the 128x64 buffer, the pixels already set kept.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+
+#include <random>
+#include <vector>
+
+#include "bitTranspose.h"
+#include "hostCheck.h"
+
+static std::mt19937 rng(50);
+
+static bool rowPixel(const uint8_t *bitmap, uint16_t stride, uint16_t x, uint16_t y)
+{
+    return bitmap[y * stride + x / 8] & (0x80 >> (x & 7));
+}
+
+static uint64_t transposeReference(uint64_t rows)
+{
+    uint64_t columns = 0;
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        for (uint8_t c = 0; c < 8; c++)
+        {
+            if (rows >> (8 * r + 7 - c) & 1)
+            {
+                columns |= 1ull << (8 * c + r);
+            }
+        }
+    }
+    return columns;
+}
+
+static void testKernel()
+{
+    bool single = true;
+    for (uint8_t bit = 0; bit < 64; bit++)
+    {
+        single = single && bitTranspose8(1ull << bit) == transposeReference(1ull << bit);
+    }
+    CHECK(single);
+
+    bool rows = true;
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        for (uint16_t v = 0; v < 256; v++)
+        {
+            uint64_t word = (uint64_t)v << (8 * r);
+            rows = rows && bitTranspose8(word) == transposeReference(word);
+        }
+    }
+    CHECK(rows);
+
+    bool random = true;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        uint64_t word = (uint64_t)rng() << 32 | rng();
+        random = random && bitTranspose8(word) == transposeReference(word);
+    }
+    CHECK(random);
+    CHECK(bitTranspose8(~0ull) == ~0ull && bitTranspose8(0) == 0);
+    // the left column is column byte 0, the top row bit 0
+    CHECK(bitTranspose8(0x80) == 0x01 && bitTranspose8(0x01) == 1ull << 56);
+}
+
+static void testPages()
+{
+    bool same = true;
+    for (uint16_t width = 1; width <= 24 && same; width++)
+    {
+        for (uint16_t height = 1; height <= 24 && same; height++)
+        {
+            for (uint16_t pad = 0; pad < 2; pad++)
+            {
+                uint16_t stride = (width + 7) / 8 + pad;
+                std::vector<uint8_t> bitmap(stride * height);
+                for (uint8_t &b : bitmap)
+                {
+                    b = rng();
+                }
+                uint16_t pages = (height + 7) / 8;
+                std::vector<uint8_t> out(pages * width + 1, 0xA5);
+                bitRowsToPages(bitmap.data(), width, height, stride, out.data());
+                for (uint16_t x = 0; x < width; x++)
+                {
+                    for (uint16_t y = 0; y < pages * 8; y++)
+                    {
+                        bool lit = y < height && rowPixel(bitmap.data(), stride, x, y);
+                        same = same && ((out[(y / 8) * width + x] >> (y & 7) & 1) == lit);
+                    }
+                }
+                same = same && out[pages * width] == 0xA5; // nothing written past the pages
+                if (!same)
+                {
+                    fprintf(stderr, "%ux%u, stride %u: pages differ\n", width, height, stride);
+                    break;
+                }
+            }
+        }
+    }
+    CHECK(same);
+}
+
+// what drawBitmap(x, y, bitmap, width, height, 1) sets in a 128x64 page buffer
+static void blitReference(const uint8_t *bitmap, uint16_t width, uint16_t height, uint16_t stride, uint8_t *buffer,
+                          int16_t x, int16_t y)
+{
+    for (uint16_t row = 0; row < height; row++)
+    {
+        for (uint16_t col = 0; col < width; col++)
+        {
+            int16_t px = x + col;
+            int16_t py = y + row;
+            if (px >= 0 && px < 128 && py >= 0 && py < 64 && rowPixel(bitmap, stride, col, row))
+            {
+                buffer[(py / 8) * 128 + px] |= 1 << (py & 7);
+            }
+        }
+    }
+}
+
+static void testBlit()
+{
+    const struct
+    {
+        uint16_t width;
+        uint16_t height;
+        uint16_t stride;
+    } sizes[] = {{48, 48, 6}, {13, 11, 2}, {13, 11, 3}, {8, 8, 1}, {1, 1, 1}, {128, 64, 16}};
+    std::vector<uint8_t> background(1024);
+    for (uint8_t &b : background)
+    {
+        b = rng() & rng(); // a quarter of the pixels already set
+    }
+    for (const auto &s : sizes)
+    {
+        std::vector<uint8_t> bitmap(s.stride * s.height);
+        for (uint8_t &b : bitmap)
+        {
+            b = rng();
+        }
+        bool same = true;
+        for (int16_t y = -(int16_t)s.height - 1; y <= 65 && same; y++)
+        {
+            for (int16_t x = -(int16_t)s.width - 1; x <= 129 && same; x++)
+            {
+                std::vector<uint8_t> expected = background;
+                std::vector<uint8_t> buffer = background;
+                blitReference(bitmap.data(), s.width, s.height, s.stride, expected.data(), x, y);
+                bitBlitRows(bitmap.data(), s.width, s.height, s.stride, buffer.data(), 128, 64, x, y);
+                if (buffer != expected)
+                {
+                    fprintf(stderr, "%ux%u, stride %u at %d, %d: buffer differs\n", s.width, s.height, s.stride, x, y);
+                    same = false;
+                }
+            }
+        }
+        CHECK(same);
+    }
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testKernel();
+    testPages();
+    testBlit();
+    return checkResult("bit transpose");
+}
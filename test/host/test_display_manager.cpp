@@ -0,0 +1,214 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_display_manager.cpp
+//
+// Description:
+//
+// checks displayManager.h: panels on Wire and Wire1 at 0x3C and 0x3D
+// each play their own category with their own caption, and what each
+// simulated panel shows is its own buffer, nothing sent to a neighbour.
+// A step with a panel on each bus costs the busier bus, not the sum of
+// both; two panels on one bus cost the sum. A panel missing from the
+// bus is reported and left out, the others keep playing. The main
+// display played by byteArray_Anim() is not deferred and still flushes
+// right away.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "displayManager.h"
+#include "hostCard.h"
+#include "ssd1306Panel.h"
+#include "hostCheck.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static Adafruit_SSD1306 displaySystem(128, 64, &Wire, -1);
+static Adafruit_SSD1306 displayBattery(128, 64, &Wire1, -1);
+static Adafruit_SSD1306 displayIcons(128, 64, &Wire1, -1);
+
+static SSD1306Panel panelMeteo;
+static SSD1306Panel panelSystem;
+static SSD1306Panel panelBattery;
+static SSD1306Panel panelIcons;
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+// the caption of anim drawn with u8g2 on an empty buffer, compared with the two top pages of the panel
+static bool showsCaption(const SSD1306Panel &panel, const AnimDesc &anim)
+{
+    u8g2.clearBuffer();
+    u8g2.drawStr(3, oled_LineH * 1 + 2, anim.name);
+    const uint8_t *caption = u8g2.getBufferPtr();
+    const uint8_t *ram = panel.ram();
+    // right of the animation area, where no frame is drawn
+    for (uint16_t col = animAreaSize; col < 128; col++)
+    {
+        if (ram[col] != caption[col])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const AnimDesc &firstOf(AnimCategory category)
+{
+    uint8_t i = 0;
+    while (animRegistry[i].category != category)
+    {
+        i++;
+    }
+    return animRegistry[i];
+}
+
+static void testPanels()
+{
+    DisplayManager displays;
+    CHECK(displayAdd(displays, display, Wire, 0x3C, AnimCategory::Meteo));
+    CHECK(displayAdd(displays, displaySystem, Wire, 0x3D, AnimCategory::System));
+    CHECK(displayAdd(displays, displayBattery, Wire1, 0x3C, AnimCategory::Battery));
+    CHECK(!displayAdd(displays, displayIcons, Wire1, 0x3C, AnimCategory::Icons)); // address taken
+    CHECK(displays.count == 3 && displays.busCount == 2);
+    CHECK(displayBegin(displays));
+    CHECK(!displays.tasks); // no tasks on the host, flushed in turn with the time overlapped
+
+    // one frame per panel per step, every panel shows its own buffer and caption
+    for (uint8_t s = 0; s < 40; s++)
+    {
+        CHECK(displayStep(displays) == 3);
+        if (s == 0)
+        {
+            CHECK(showsCaption(panelMeteo, firstOf(AnimCategory::Meteo)));
+            CHECK(showsCaption(panelSystem, firstOf(AnimCategory::System)));
+            CHECK(showsCaption(panelBattery, firstOf(AnimCategory::Battery)));
+        }
+    }
+    CHECK(!memcmp(panelMeteo.ram(), display.getBuffer(), 1024));
+    CHECK(!memcmp(panelSystem.ram(), displaySystem.getBuffer(), 1024));
+    CHECK(!memcmp(panelBattery.ram(), displayBattery.getBuffer(), 1024));
+    CHECK(memcmp(display.getBuffer(), displaySystem.getBuffer(), 1024) != 0);
+    CHECK(panelIcons.flushes == 0);
+
+    // 30 frames each, then the next animation of the category
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        CHECK(displays.panels[i].frames == 40);
+        CHECK(displays.panels[i].nacks == 0);
+        CHECK(displays.panels[i].playing && displays.panels[i].framesLeft == 2 * displayFramesPerAnim - 40);
+        CHECK(displays.panels[i].screen.anim != &firstOf(displays.panels[i].category));
+        CHECK(displays.panels[i].screen.anim->category == displays.panels[i].category);
+    }
+    displayEnd(displays);
+    CHECK(displays.count == 0 && !displays.panels[0].panel.caption);
+}
+
+// bus time of a step: the busier bus when the panels are on both, the sum on one
+static void testOverlap()
+{
+    for (bool spread : {false, true})
+    {
+        DisplayManager displays;
+        displayAdd(displays, display, Wire, 0x3C, AnimCategory::Meteo);
+        displayAdd(displays, spread ? displayBattery : displaySystem, spread ? Wire1 : Wire, spread ? 0x3C : 0x3D,
+                   AnimCategory::Meteo);
+        CHECK(displayBegin(displays));
+        displayStep(displays); // full screens
+
+        // only the modelled bus time counts, not the host time of displayStep()
+        hostClockSimulated(true);
+        double bus = 0;
+        double step = 0;
+        for (uint8_t s = 0; s < 20; s++)
+        {
+            double busBefore = Wire.stats.busMicros + Wire1.stats.busMicros;
+            double start = hostClockMicros();
+            displayStep(displays);
+            step += hostClockMicros() - start;
+            bus += Wire.stats.busMicros + Wire1.stats.busMicros - busBefore;
+        }
+        hostClockSimulated(false);
+        // the same animation on both, the buses are equally busy
+        if (spread)
+        {
+            CHECK(step < 0.6 * bus);
+        }
+        else
+        {
+            CHECK(step >= bus - 1); // rounding of the two sums
+        }
+        displayEnd(displays);
+    }
+}
+
+static void testMissingPanel()
+{
+    DisplayManager displays;
+    CHECK(displayAdd(displays, displayBattery, Wire1, 0x3C, AnimCategory::Battery));
+    CHECK(displayAdd(displays, displayIcons, Wire1, 0x3D, AnimCategory::Icons)); // nothing answers there
+    CHECK(!displayBegin(displays));
+    CHECK(displays.panels[0].present && !displays.panels[1].present);
+    CHECK(displayStep(displays) == 1);
+    CHECK(displays.panels[1].frames == 0);
+    CHECK(!memcmp(panelBattery.ram(), displayBattery.getBuffer(), 1024));
+    displayEnd(displays);
+}
+
+// byteArray_Anim() on the main panel flushes every frame itself, nothing is left queued
+static void testMainPanel()
+{
+    uint32_t flushes = panelMeteo.flushes;
+    byteArray_Display(ANIM("bell"));
+    CHECK(panelMeteo.flushes > flushes);
+    CHECK(!animMainPanel.deferred && animMainPanel.queued == 0);
+    CHECK(!memcmp(panelMeteo.ram(), display.getBuffer(), 1024));
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    if (!hostCardImage(ANIM_FILES_DIR, "test_display_manager.card"))
+    {
+        return 1;
+    }
+    panelMeteo.attach(Wire, 0x3C);
+    panelSystem.attach(Wire, 0x3D);
+    panelBattery.attach(Wire1, 0x3C);
+    panelIcons.attach(Wire1, 0x3E); // answers nowhere the manager looks
+
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    CHECK(SD.begin(5));
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+
+    testPanels();
+    testOverlap();
+    testMissingPanel();
+    testMainPanel();
+    return checkResult("display manager");
+}
@@ -0,0 +1,167 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_glyph_atlas.cpp
+//
+// Description:
+//
+// checks glyphAtlas.h against u8g2: text drawn from the atlas must set
+// exactly the pixels drawStr() sets, at every row (every shift against
+// the pages, above and below the buffer) and at columns cutting the
+// text on both sides, without touching what is already in the buffer.
+// Also covers characters missing from the atlas and glyphs of
+// different widths.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#include "glyphAtlas.h"
+#include "hostCheck.h"
+
+static U8G2 u8g2(128, 64);
+
+// every printable character, drawn by u8g2 with its top on row 0
+static bool buildAtlas(GlyphAtlas &atlas, const char *chars)
+{
+    glyphAtlasBegin(atlas, u8g2.getFontAscent(), -u8g2.getFontDescent());
+    char glyph[2] = {0, 0};
+    for (const char *c = chars; *c; c++)
+    {
+        glyph[0] = *c;
+        glyphAtlasReserve(atlas, *c, u8g2.getStrWidth(glyph));
+    }
+    if (!glyphAtlasAllocate(atlas))
+    {
+        return false;
+    }
+    for (const char *c = chars; *c; c++)
+    {
+        glyph[0] = *c;
+        u8g2.clearBuffer();
+        u8g2.drawStr(0, atlas.ascent, glyph);
+        glyphAtlasCapture(atlas, *c, u8g2.getBufferPtr(), 128, 0);
+    }
+    return true;
+}
+
+// a background pattern the text is ORed over
+static void background(uint8_t *buffer)
+{
+    for (uint16_t i = 0; i < 1024; i++)
+    {
+        buffer[i] = i % 7 == 0 ? 0x81 : 0;
+    }
+}
+
+static void testSameAsU8g2(const GlyphAtlas &atlas)
+{
+    static const char *texts[] = {"Lightning Bolt Weather", "87%", "-12.5C", "gjpqy|{}", "W",
+                                  "The quick brown fox jumps over the lazy dog, 0123456789!"};
+    uint8_t expected[1024];
+    uint8_t drawn[1024];
+    uint32_t compared = 0;
+    uint32_t differ = 0;
+    for (const char *text : texts)
+    {
+        for (int16_t y = -12; y < 76; y++)
+        {
+            for (int16_t x = -40; x < 136; x += 3)
+            {
+                u8g2.clearBuffer();
+                background(u8g2.getBufferPtr());
+                uint16_t width = u8g2.drawStr(x, y, text);
+                memcpy(expected, u8g2.getBufferPtr(), sizeof(expected));
+
+                background(drawn);
+                CHECK(glyphAtlasDraw(atlas, text, drawn, 128, 64, x, y) == width);
+                differ += memcmp(drawn, expected, sizeof(drawn)) != 0;
+                compared++;
+            }
+        }
+    }
+    CHECK(differ == 0);
+    CHECK(compared > 5000);
+}
+
+static void testMissing()
+{
+    GlyphAtlas atlas;
+    CHECK(buildAtlas(atlas, "0123456789%"));
+    CHECK(glyphAtlasCovers(atlas, "42%"));
+    CHECK(!glyphAtlasCovers(atlas, "42 %"));
+    CHECK(glyphAtlasWidth(atlas, "42 %") == 18);
+
+    // a missing character is skipped, the ones after it close the gap
+    uint8_t skipped[1024] = {};
+    uint8_t direct[1024] = {};
+    CHECK(glyphAtlasDraw(atlas, "4x2", skipped, 128, 64, 10, 20) == 12);
+    glyphAtlasDraw(atlas, "42", direct, 128, 64, 10, 20);
+    CHECK(!memcmp(skipped, direct, sizeof(direct)));
+
+    // nothing allocated, nothing drawn
+    glyphAtlasFree(atlas);
+    CHECK(!glyphAtlasCovers(atlas, "42"));
+    CHECK(glyphAtlasDraw(atlas, "42", direct, 128, 64, 0, 10) == 0);
+}
+
+// glyphs of their own widths, as a proportional font would give
+static void testWidths()
+{
+    GlyphAtlas atlas;
+    CHECK(glyphAtlasBegin(atlas, 7, 2));
+    CHECK(atlas.pages == 2);
+    CHECK(glyphAtlasReserve(atlas, 'i', 2));
+    CHECK(glyphAtlasReserve(atlas, 'm', 9));
+    CHECK(glyphAtlasReserve(atlas, 'i', 5)); // already there, keeps its width
+    CHECK(!glyphAtlasReserve(atlas, '\n', 3));
+    CHECK(atlas.count == 2 && atlas.columns == 11);
+    CHECK(glyphAtlasAllocate(atlas));
+    CHECK(!glyphAtlasReserve(atlas, 'x', 3));
+
+    // solid glyphs: every column of every page set
+    uint8_t solid[2 * 128];
+    memset(solid, 0xFF, sizeof(solid));
+    glyphAtlasCapture(atlas, 'i', solid, 128, 0);
+    glyphAtlasCapture(atlas, 'm', solid, 128, 0);
+
+    uint8_t buffer[1024] = {};
+    CHECK(glyphAtlasDraw(atlas, "mim", buffer, 128, 64, 1, 7 + 16) == 20);
+    for (int16_t col = 0; col < 128; col++)
+    {
+        bool inked = col >= 1 && col < 21;
+        CHECK(buffer[2 * 128 + col] == (inked ? 0xFF : 0));
+        CHECK(buffer[3 * 128 + col] == (inked ? 0xFF : 0));
+        CHECK(buffer[4 * 128 + col] == 0);
+    }
+    glyphAtlasFree(atlas);
+
+    CHECK(!glyphAtlasBegin(atlas, 20, 8)); // more than glyphPagesMax pages
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    u8g2.setFont(u8g2_font_profont10_tf);
+
+    char printable[glyphCount + 1];
+    for (uint8_t c = glyphFirst; c <= glyphLast; c++)
+    {
+        printable[c - glyphFirst] = c;
+    }
+    printable[glyphCount] = 0;
+    GlyphAtlas atlas;
+    CHECK(buildAtlas(atlas, printable));
+    CHECK(atlas.count == glyphCount && atlas.pages == 2);
+    testSameAsU8g2(atlas);
+    glyphAtlasFree(atlas);
+
+    testMissing();
+    testWidths();
+    return checkResult("glyph atlas");
+}
@@ -0,0 +1,313 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_golden.cpp
+//
+// Description:
+//
+// golden image test: every animation of animRegistry.h is drawn the
+// way the original sketch drew it (caption, display.drawBitmap(0, 15)
+// of the raw 48x48 frame, display.display()) and then played by the
+// player through every encoding and loading path the card can hold.
+// What the simulated panel shows after each frame must be bit for bit
+// the same, compared through the per frame hashes of FrameRecorder.
+//
+// The -status paths also give the player a status text that changes
+// every 4 frames; the reference draws it with u8g2 next to the frame,
+// the player from its glyph atlas.
+//
+// The converted files come from the assetpack tool, its path is the
+// first argument. On a mismatch both image sequences are written as
+// PBM streams (golden_<path>_<animation>.pbm) next to the test.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <string>
+#include <vector>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "frameRecorder.h"
+#include "hostCard.h"
+#include "ssd1306Panel.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static SSD1306Panel panel;
+static const char *assetpack = "assetpack";
+static const char *goldenCard = "test_golden.card";
+
+// how the animations get onto the card and into RAM
+struct GoldenPath
+{
+    const char *name;
+    const char *convert; // assetpack command applied to every file, nullptr keeps the original dumps
+    const char *pack;    // assetpack command building /anims.pak from all files
+    bool stream;         // animLoadLimit 0, frames are read from the card as they are shown
+    bool status;         // status text right of the animation, see goldenStatus()
+};
+
+static const GoldenPath goldenPaths[] = {
+    {"legacy", nullptr, nullptr, false},
+    {"legacy-streamed", nullptr, nullptr, true},
+    {"raw", "wrap", nullptr, false},
+    {"delta-k1", "delta --key 1", nullptr, false},
+    {"delta-k8", "delta --key 8", nullptr, false},
+    {"delta-k8-streamed", "delta --key 8", nullptr, true},
+    {"tiles", "tiles", nullptr, false},
+    {"tiles-streamed", "tiles", nullptr, true},
+    {"pack", nullptr, "pack", false},
+    {"pack-sparse", nullptr, "pack --sparse", false},
+    {"legacy-status", nullptr, nullptr, false, true},
+    {"tiles-status", "tiles", nullptr, false, true},
+};
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+// a battery level, the same for 4 frames in a row
+static bool goldenStatus(const AnimDesc &anim, uint32_t frame, char *text, size_t size)
+{
+    snprintf(text, size, "%u%%", frame / 4 * 9 % 101);
+    return true;
+}
+
+static std::string sourceFile(const AnimDesc &anim)
+{
+    return std::string(ANIM_FILES_DIR) + anim.path;
+}
+
+static bool run(const std::string &command)
+{
+    if (system((command + " > /dev/null").c_str()) != 0)
+    {
+        fprintf(stderr, "failed: %s\n", command.c_str());
+        return false;
+    }
+    return true;
+}
+
+// fresh card holding the animations as the path wants them, index and pack opened
+static bool prepareCard(const GoldenPath &path)
+{
+    framePackClose(framePack);
+    if (!hostCardImage(ANIM_FILES_DIR, goldenCard))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < animTotal && path.convert; i++)
+    {
+        const AnimDesc &anim = animRegistry[i];
+        if (!run(std::string("\"") + assetpack + "\" " + path.convert + " \"" + sourceFile(anim) + "\" \"" +
+                 goldenCard + anim.path + "\""))
+        {
+            return false;
+        }
+    }
+    if (path.pack)
+    {
+        std::string command = std::string("\"") + assetpack + "\" " + path.pack + " \"" + goldenCard + "/anims.pak\"";
+        for (uint8_t i = 0; i < animTotal; i++)
+        {
+            command += " \"" + sourceFile(animRegistry[i]) + "\"";
+        }
+        if (!run(command))
+        {
+            return false;
+        }
+    }
+
+    animLoadLimit = path.stream ? 0 : 32 * 1024;
+    animOnStatus(path.status ? goldenStatus : nullptr);
+    if (!SD.begin(5))
+    {
+        return false;
+    }
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+    return !path.pack || framePackOpen(SD, "/anims.pak", framePack);
+}
+
+// text drawn by u8g2 and ORed into the display buffer
+static void drawText(int16_t x, int16_t y, const char *text)
+{
+    u8g2.clearBuffer();
+    u8g2.drawStr(x, y, text);
+    const uint8_t *caption = u8g2.getBufferPtr();
+    uint8_t *buffer = display.getBuffer();
+    for (uint16_t i = 0; i < 1024; i++)
+    {
+        buffer[i] |= caption[i];
+    }
+}
+
+static void drawCaption(const AnimDesc &anim)
+{
+    drawText(3, oled_LineH * 1 + 2, anim.name);
+}
+
+// the frames in the order the player shows them, with a wrap around
+static uint32_t frameAt(uint32_t step, uint32_t frameCount)
+{
+    return step % frameCount;
+}
+
+// the original sketch: whole screen redrawn and sent for every frame
+static bool referenceRun(const AnimDesc &anim, FrameRecorder &recorder, bool status)
+{
+    File file = SD.open(anim.path);
+    std::vector<uint8_t> frames(file ? file.size() : 0);
+    if (!file || file.read(frames.data(), frames.size()) != frames.size())
+    {
+        return false;
+    }
+    file.close();
+
+    uint32_t frameCount = frames.size() / 288;
+    for (uint32_t step = 0; step < frameCount + 2; step++)
+    {
+        display.clearDisplay();
+        drawCaption(anim);
+        display.drawBitmap(0, 15, &frames[frameAt(step, frameCount) * 288], framewidth, frameheight, 1);
+        if (status)
+        {
+            char text[animStatusMax];
+            goldenStatus(anim, frameAt(step, frameCount), text, sizeof(text));
+            drawText(animStatusX, animAreaTop + animAreaSize / 2 + u8g2.getFontAscent() / 2, text);
+        }
+        display.display();
+        recorder.capture(panel.ram());
+    }
+    return true;
+}
+
+static bool playerRun(const AnimDesc &anim, FrameRecorder &recorder)
+{
+    AnimAsset asset;
+    if (!animOpen(anim, asset))
+    {
+        return false;
+    }
+
+    AnimScreen screen;
+    animBeginScreen(anim, asset.header, true, screen);
+    for (uint32_t step = 0; step < asset.header.frameCount + 2; step++)
+    {
+        animDrawFrame(screen, asset, frameAt(step, asset.header.frameCount));
+        recorder.capture(panel.ram());
+    }
+    unloadAnimation(asset);
+    return true;
+}
+
+// writes both sequences for a look with any PBM viewer
+static void dumpMismatch(const GoldenPath &path, const AnimDesc &anim)
+{
+    FrameRecorder recorder;
+    std::string name = std::string("golden_reference_") + anim.id + ".pbm";
+    if (recorder.open(name.c_str(), nullptr))
+    {
+        referenceRun(anim, recorder, path.status);
+    }
+    name = std::string("golden_") + path.name + "_" + anim.id + ".pbm";
+    if (recorder.open(name.c_str(), nullptr))
+    {
+        playerRun(anim, recorder);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        assetpack = argv[1];
+    }
+    hostSerialOutput(nullptr);
+
+    panel.attach(Wire, SCREEN_I2C_ADDR);
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+
+    // reference images, from the original dumps, without and with the status text
+    std::vector<std::vector<uint64_t>> reference[2];
+    if (!prepareCard(goldenPaths[0]))
+    {
+        return 1;
+    }
+    for (bool status : {false, true})
+    {
+        for (uint8_t i = 0; i < animTotal; i++)
+        {
+            FrameRecorder recorder;
+            if (!referenceRun(animRegistry[i], recorder, status))
+            {
+                fprintf(stderr, "cannot read %s\n", animRegistry[i].path);
+                return 1;
+            }
+            reference[status].push_back(recorder.hashes());
+        }
+    }
+
+    int failures = 0;
+    for (const GoldenPath &path : goldenPaths)
+    {
+        if (!prepareCard(path))
+        {
+            fprintf(stderr, "%s: cannot prepare the card\n", path.name);
+            failures++;
+            continue;
+        }
+
+        int mismatches = 0;
+        for (uint8_t i = 0; i < animTotal; i++)
+        {
+            const AnimDesc &anim = animRegistry[i];
+            FrameRecorder recorder;
+            if (!playerRun(anim, recorder))
+            {
+                fprintf(stderr, "%s: %s does not load\n", path.name, anim.id);
+                mismatches++;
+                continue;
+            }
+
+            const std::vector<uint64_t> &got = recorder.hashes();
+            const std::vector<uint64_t> &expected = reference[path.status][i];
+            for (size_t f = 0; f < got.size() || f < expected.size(); f++)
+            {
+                if (f >= got.size() || f >= expected.size() || got[f] != expected[f])
+                {
+                    fprintf(stderr, "%s: %s differs from frame %zu on\n", path.name, anim.id, f);
+                    dumpMismatch(path, anim);
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+        printf("%-18s %s\n", path.name, mismatches ? "FAILED" : "identical");
+        failures += mismatches;
+    }
+    framePackClose(framePack);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,328 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_gray_panel.cpp
+//
+// Description:
+//
+// checks grayPanel.h and displayBackend.h: the table expansion of 1
+// bit rows and the copy of 4 bit rows give the same buffer as setting
+// the pixels one by one, at even and odd x and clipped on every side;
+// a windowed flush leaves the simulated SSD1327 (ssd1327Panel.h)
+// showing the buffer and sends only the window. A 4 bit asset loads,
+// is refused by the monochrome panel and plays on the gray backend,
+// 1 bit animations play there too at the on and off levels. With the
+// path of assetpack as argument, a PGM strip converted by assetpack
+// gray is checked as well.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "displayBackend.h"
+#include "hostCard.h"
+#include "ssd1327Panel.h"
+#include "hostCheck.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static const uint8_t grayAddress = 0x3D;
+static const AnimDesc grayAnim = {AnimCategory::Icons, "fade", "/fade.bin", "fade", 48, 48, 0};
+static const uint32_t grayFrames = 4;
+
+static std::mt19937 rng(48);
+static SSD1327Panel panel;
+static GrayPanel gray;
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+static std::vector<uint8_t> randomBytes(size_t n)
+{
+    std::vector<uint8_t> bytes(n);
+    for (uint8_t &b : bytes)
+    {
+        b = rng();
+    }
+    return bytes;
+}
+
+static size_t grayBytes()
+{
+    return (size_t)grayRowBytes(gray) * gray.height;
+}
+
+// 1 bit rows through the table against graySetPixel, on a buffer of noise
+static void testExpand()
+{
+    for (uint8_t on : {15, 9})
+    {
+        grayLevels(gray, on, 15 - on);
+        for (uint16_t width : {48, 13, 64, 8})
+        {
+            uint16_t stride = assetMinStride(width) + (width == 13);
+            std::vector<uint8_t> bitmap = randomBytes((size_t)stride * 40);
+            for (int16_t x : {-17, -9, -8, -1, 0, 1, 2, 7, 40, 79, 80, 81, 120, 127})
+            {
+                for (int16_t y : {-5, 0, 44, 100})
+                {
+                    std::vector<uint8_t> noise = randomBytes(grayBytes());
+                    memcpy(gray.buffer, noise.data(), noise.size());
+                    grayDrawMono(gray, x, y, bitmap.data(), width, 40, stride);
+                    std::vector<uint8_t> fast(gray.buffer, gray.buffer + grayBytes());
+
+                    memcpy(gray.buffer, noise.data(), noise.size());
+                    for (uint16_t row = 0; row < 40; row++)
+                    {
+                        for (uint16_t col = 0; col < width; col++)
+                        {
+                            bool lit = bitmap[row * stride + col / 8] & (0x80 >> (col & 7));
+                            graySetPixel(gray, x + col, y + row, lit ? gray.on : gray.off);
+                        }
+                    }
+                    CHECK(!memcmp(fast.data(), gray.buffer, grayBytes()));
+                }
+            }
+        }
+    }
+    grayLevels(gray, 15, 0);
+}
+
+// 4 bit rows against graySetPixel
+static void testGrayBlit()
+{
+    for (uint16_t width : {48, 13, 2, 1})
+    {
+        uint16_t stride = assetGrayStride(width);
+        std::vector<uint8_t> pixels = randomBytes((size_t)stride * 20);
+        for (int16_t x : {-13, -2, -1, 0, 1, 2, 3, 79, 80, 115, 126, 127})
+        {
+            for (int16_t y : {-3, 0, 120})
+            {
+                std::vector<uint8_t> noise = randomBytes(grayBytes());
+                memcpy(gray.buffer, noise.data(), noise.size());
+                grayDrawGray(gray, x, y, pixels.data(), width, 20, stride);
+                std::vector<uint8_t> fast(gray.buffer, gray.buffer + grayBytes());
+
+                memcpy(gray.buffer, noise.data(), noise.size());
+                for (uint16_t row = 0; row < 20; row++)
+                {
+                    for (uint16_t col = 0; col < width; col++)
+                    {
+                        uint8_t b = pixels[row * stride + col / 2];
+                        graySetPixel(gray, x + col, y + row, col & 1 ? b & 0x0F : b >> 4);
+                    }
+                }
+                CHECK(!memcmp(fast.data(), gray.buffer, grayBytes()));
+            }
+        }
+    }
+}
+
+// the panel ends up showing the buffer, a window sends only its bytes
+static void testFlush()
+{
+    std::vector<uint8_t> noise = randomBytes(grayBytes());
+    memcpy(gray.buffer, noise.data(), noise.size());
+    uint32_t flushes = panel.flushes;
+    CHECK(grayFlushRegion(gray, {0, 0, gray.width, gray.height}));
+    CHECK(panel.flushes == flushes + 1);
+    CHECK(!memcmp(panel.ram(), gray.buffer, grayBytes()));
+
+    // odd edges widen to whole pixel pairs
+    const FrameRect windows[] = {{40, 40, 88, 88}, {3, 7, 50, 9}, {127, 127, 128, 128}, {-10, 120, 5, 140}};
+    for (const FrameRect &w : windows)
+    {
+        grayFill(gray, w, rng() % 16);
+        uint32_t data = panel.dataBytes;
+        CHECK(grayFlushRegion(gray, w));
+        FrameRect r = frameRectClip(w, gray.width, gray.height);
+        CHECK(panel.dataBytes - data == (uint32_t)((r.x1 - 1) / 2 - r.x0 / 2 + 1) * (r.y1 - r.y0));
+        CHECK(!memcmp(panel.ram(), gray.buffer, grayBytes()));
+    }
+    // the small chunks of a slow bus give the same picture
+    grayFill(gray, {0, 0, 128, 128}, 3);
+    CHECK(grayFlushRegion(gray, {0, 0, 128, 128}, 17));
+    CHECK(panel.pixel(77, 99) == 3);
+    CHECK(!memcmp(panel.ram(), gray.buffer, grayBytes()));
+}
+
+// 48x48, one gradient per frame, written before the card is indexed
+static std::vector<uint8_t> grayAsset()
+{
+    AssetHeader header = {assetVersion, ASSET_GRAY4, 48, 48, assetGrayStride(48), grayFrames};
+    std::vector<uint8_t> file(assetHeaderSize + (size_t)header.stride * header.height * grayFrames);
+    assetWriteHeader(header, file.data());
+    for (uint32_t f = 0; f < grayFrames; f++)
+    {
+        for (uint16_t y = 0; y < 48; y++)
+        {
+            for (uint16_t x = 0; x < 48; x += 2)
+            {
+                uint8_t left = (x + y + f * 4) / 6 % 16;
+                uint8_t right = (x + 1 + y + f * 4) / 6 % 16;
+                file[assetHeaderSize + (f * 48 + y) * header.stride + x / 2] = (left << 4) | right;
+            }
+        }
+    }
+    return file;
+}
+
+static void testHeader()
+{
+    AssetHeader header = {assetVersion, ASSET_GRAY4, 48, 48, assetGrayStride(48), 1};
+    uint8_t buf[assetHeaderSize];
+    AssetHeader parsed;
+    assetWriteHeader(header, buf);
+    CHECK(assetParseHeader(buf, sizeof(buf), parsed) && parsed.encoding == ASSET_GRAY4 && parsed.stride == 24);
+    // the 1 bit stride is too short for 4 bit rows
+    header.stride = assetMinStride(48);
+    assetWriteHeader(header, buf);
+    CHECK(!assetParseHeader(buf, sizeof(buf), parsed));
+    header.encoding = ASSET_RAW;
+    assetWriteHeader(header, buf);
+    CHECK(assetParseHeader(buf, sizeof(buf), parsed));
+}
+
+// the 4 bit asset on both backends, a 1 bit one on the gray backend
+static void testBackends(const std::vector<uint8_t> &file)
+{
+    AnimAsset asset;
+    CHECK(!animOpen(grayAnim, asset)); // monochrome caller
+    CHECK(animOpen(grayAnim, asset, animAcceptGray));
+    CHECK(asset.header.encoding == ASSET_GRAY4 && asset.header.frameCount == grayFrames);
+    unloadAnimation(asset);
+
+    DisplayBackend mono;
+    displayBackendMono(mono, animMainPanel);
+    CHECK(mono.bitsPerPixel == 1 && backendPlay(mono, grayAnim, 2) == 0);
+
+    DisplayBackend backend;
+    displayBackendGray(backend, gray);
+    CHECK(backend.width == 128 && backend.height == 128);
+    CHECK(backendPlay(backend, grayAnim, 6) == 6);
+    // frame 5 % 4 centered at 40, 40 on the panel, the rest cleared
+    const uint8_t *last = &file[assetHeaderSize + 1 * 48 * 24];
+    bool shown = true;
+    for (uint16_t y = 0; y < 128; y++)
+    {
+        for (uint16_t x = 0; x < 128; x++)
+        {
+            bool inside = x >= 40 && x < 88 && y >= 40 && y < 88;
+            uint8_t b = inside ? last[(y - 40) * 24 + (x - 40) / 2] : 0;
+            uint8_t level = inside ? (x & 1 ? b & 0x0F : b >> 4) : 0;
+            shown = shown && panel.pixel(x, y) == level;
+        }
+    }
+    CHECK(shown);
+    CHECK(!memcmp(panel.ram(), gray.buffer, grayBytes()));
+
+    // 1 bit frames at the on and off levels
+    const AnimDesc &bell = animRegistry[ANIM("bell")];
+    grayLevels(gray, 12, 2);
+    CHECK(backendPlay(backend, bell, 3) == 3);
+    CHECK(animOpen(bell, asset));
+    const uint8_t *bits = animFrame(asset, 2);
+    shown = true;
+    for (uint16_t y = 0; y < 48; y++)
+    {
+        for (uint16_t x = 0; x < 48; x++)
+        {
+            bool lit = bits[y * asset.header.stride + x / 8] & (0x80 >> (x & 7));
+            shown = shown && panel.pixel(40 + x, 40 + y) == (lit ? 12 : 2);
+        }
+    }
+    CHECK(shown);
+    unloadAnimation(asset);
+    grayLevels(gray, 15, 0);
+}
+
+// a strip of two 6x4 frames, levels 0 to 255 quantized to 0 to 15
+static void testAssetpack(const std::string &assetpack)
+{
+    const char *pgm = "test_gray_panel.pgm";
+    const char *bin = "test_gray_panel.bin";
+    FILE *f = fopen(pgm, "wb");
+    fprintf(f, "P5\n# two frames\n6 8\n255\n");
+    for (uint8_t i = 0; i < 48; i++)
+    {
+        fputc(i * 255 / 47, f);
+    }
+    fclose(f);
+    CHECK(system((assetpack + " gray --frames 2 " + pgm + " " + bin + " > /dev/null").c_str()) == 0);
+
+    f = fopen(bin, "rb");
+    uint8_t buf[assetHeaderSize + 24];
+    CHECK(f && fread(buf, 1, sizeof(buf), f) == sizeof(buf) && fgetc(f) == EOF);
+    if (f)
+    {
+        fclose(f);
+    }
+    AssetHeader header;
+    CHECK(assetParseHeader(buf, sizeof(buf), header));
+    CHECK(header.encoding == ASSET_GRAY4 && header.width == 6 && header.height == 4 && header.stride == 3 &&
+          header.frameCount == 2);
+    CHECK(buf[assetHeaderSize] >> 4 == 0 && (buf[assetHeaderSize + 23] & 0x0F) == 15);
+    // a strip that is not a whole number of frames is refused
+    CHECK(system((assetpack + " gray --frames 3 " + pgm + " " + bin + " 2> /dev/null").c_str()) != 0);
+}
+
+int main(int argc, char **argv)
+{
+    hostSerialOutput(nullptr);
+    if (!hostCardImage(ANIM_FILES_DIR, "test_gray_panel.card"))
+    {
+        return 1;
+    }
+    panel.attach(Wire, grayAddress);
+
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    CHECK(SD.begin(5));
+    std::vector<uint8_t> file = grayAsset();
+    File out = SD.open(grayAnim.path, FILE_WRITE);
+    out.write(file.data(), file.size());
+    out.close();
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+
+    CHECK(grayBegin(gray, 128, 128, Wire, grayAddress));
+    CHECK(panel.displayOn());
+    CHECK(!memcmp(&gray.expand[0xA5], "\xF0\xF0\x0F\x0F", 4));
+
+    testExpand();
+    testGrayBlit();
+    testFlush();
+    testHeader();
+    testBackends(file);
+    if (argc > 1)
+    {
+        testAssetpack(argv[1]);
+    }
+    grayEnd(gray);
+    return checkResult("gray panel");
+}
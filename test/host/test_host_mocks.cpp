@@ -0,0 +1,234 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_host_mocks.cpp
+//
+// Description:
+//
+// checks the host mocks the benchmarks rely on: the card reads the
+// animation files, drawBitmap sets the same pixels as the library,
+// display() and oledFlushRegion() leave the simulated panel showing
+// the buffer, the bus counts what was sent and the heap counts new.
+// The simulated clock only moves by the waits of the mocks.
+// The card model of the FS mock charges the modelled card time. A
+// periodic esp_timer wakes ulTaskNotifyTake() on the host clock and
+// catches up the ticks a late waiter missed.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+#include <esp_timer.h>
+
+#include "hostCard.h"
+#include "hostHeap.h"
+#include "oledFlush.h"
+#include "ssd1306Panel.h"
+#include "hostCheck.h"
+
+static void testCard()
+{
+    CHECK(hostCardImage(ANIM_FILES_DIR, "test_host_mocks.card"));
+    CHECK(SD.begin(5));
+    CHECK(SD.cardType() == CARD_SDHC);
+
+    File file = SD.open("/bell.bin");
+    CHECK(file);
+    CHECK(file.size() == 8064);
+    uint8_t head[4];
+    CHECK(file.read(head, sizeof(head)) == sizeof(head));
+    CHECK(file.seek(288));
+    CHECK(file.position() == 288);
+    file.close();
+    CHECK(!file);
+
+    File root = SD.open("/");
+    CHECK(root.isDirectory());
+    int count = 0;
+    for (File f = root.openNextFile(); f; f = root.openNextFile())
+    {
+        CHECK(f.name()[0] != '/');
+        count += strstr(f.name(), ".bin") != nullptr;
+    }
+    CHECK(count == 39);
+
+    File out = SD.open("/test.txt", FILE_WRITE);
+    CHECK(out.write((const uint8_t *)"abc", 3) == 3);
+    out.close();
+    CHECK(SD.exists("/test.txt"));
+    CHECK(SD.usedBytes() % 4096 == 0);
+    CHECK(SD.remove("/test.txt"));
+    CHECK(!SD.exists("/test.txt"));
+    CHECK(!SD.open("/missing.bin"));
+}
+
+// the card model: commands, sectors at the SPI clock, cache dropped on a fresh mount
+static void testCardTiming()
+{
+    SD.end();
+    CHECK(SD.begin(5, SPI, 4000000));
+    double sector = 512 * 8e6 / 4000000;
+    const fs::FSTiming &t = SD.timing;
+
+    double before = SD.stats.busMicros;
+    File file = SD.open("/bell.bin");
+    CHECK(SD.stats.busMicros - before == t.openMicros + t.commandMicros + sector);
+    uint8_t buf[1024];
+
+    // 1000 bytes at 100: sectors 0 to 2, one command
+    before = SD.stats.busMicros;
+    CHECK(file.seek(100));
+    CHECK(file.read(buf, 1000) == 1000);
+    CHECK(SD.stats.busMicros - before == t.callMicros + t.commandMicros + 3 * sector);
+
+    // cached now: only the call costs
+    before = SD.stats.busMicros;
+    CHECK(file.seek(0));
+    CHECK(file.read(buf, 1024) == 1024);
+    CHECK(SD.stats.busMicros - before == t.callMicros);
+    file.close();
+
+    // warm open: no directory sector, cold again after a remount
+    before = SD.stats.busMicros;
+    file = SD.open("/bell.bin");
+    CHECK(SD.stats.busMicros - before == t.openMicros);
+    file.close();
+    CHECK(SD.begin(5)); // still mounted, keeps the cache
+    before = SD.stats.busMicros;
+    SD.open("/bell.bin").close();
+    CHECK(SD.stats.busMicros - before == t.openMicros);
+    SD.end();
+    CHECK(SD.begin(5));
+    before = SD.stats.busMicros;
+    SD.open("/bell.bin").close();
+    CHECK(SD.stats.busMicros - before == t.openMicros + t.commandMicros + sector);
+
+    // and the time is spent on the clock
+    uint32_t start = micros();
+    file = SD.open("/gear.bin");
+    file.read(buf, sizeof(buf));
+    CHECK(micros() - start >= (uint32_t)(t.openMicros + 2 * t.commandMicros + 3 * sector));
+    file.close();
+}
+
+static void testDisplay()
+{
+    SSD1306Panel panel;
+    panel.attach(Wire, 0x3C);
+    Adafruit_SSD1306 oled(128, 64, &Wire, -1);
+    CHECK(oled.begin(SSD1306_SWITCHCAPVCC, 0x3C));
+    CHECK(panel.displayOn());
+
+    // 10 wide rows are padded to 2 bytes, MSB is the leftmost pixel
+    static const uint8_t bitmap[] = {0x80, 0x40, 0x00, 0x00, 0xFF, 0xC0};
+    oled.drawBitmap(3, 6, bitmap, 10, 3, 1);
+    CHECK(oled.getPixel(3, 6));
+    CHECK(oled.getPixel(12, 6));
+    CHECK(!oled.getPixel(4, 6));
+    CHECK(!oled.getPixel(3, 7));
+    CHECK(oled.getPixel(12, 8));
+    CHECK(oled.getBuffer()[3] == 0x40 && oled.getBuffer()[128 + 3] == 0x01);
+
+    Wire.stats = {};
+    oled.display();
+    CHECK(memcmp(panel.ram(), oled.getBuffer(), 1024) == 0);
+    // window commands (6 bytes and 2 bytes with their control byte), 1024 data bytes in 127 byte chunks
+    CHECK(Wire.stats.bytes == 6 + 2 + 1024 + 9);
+    CHECK(Wire.getClock() == 100000);
+
+    // partial flush: only the window goes out, the panel matches again
+    oled.fillRect(40, 20, 20, 20, 1);
+    uint64_t before = Wire.stats.bytes;
+    oledFlushRegion(oled, Wire, 0x3C, {40, 20, 60, 40});
+    CHECK(memcmp(panel.ram(), oled.getBuffer(), 1024) == 0);
+    // 3 pages of 20 columns, filled into one transaction
+    CHECK(Wire.stats.bytes - before == 6 * 2 + 3 * 20 + 1);
+    CHECK(Wire.getClock() == 100000);
+    panel.detach();
+}
+
+static void testHeap()
+{
+    size_t before = hostHeap().used;
+    hostHeapResetPeak();
+    uint8_t *block = new uint8_t[1000];
+    CHECK(hostHeap().used == before + 1000);
+    CHECK(ESP.getFreeHeap() == hostHeapSize - hostHeap().used);
+    delete[] block;
+    CHECK(hostHeap().used == before);
+    CHECK(hostHeap().peak >= before + 1000);
+}
+
+static void notifyTick(void *arg)
+{
+    (*(uint32_t *)arg)++;
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+}
+
+static void testSimulatedClock()
+{
+    hostClockAdvance(0.37); // a fraction left by a bus wait before
+    hostClockSimulated(true);
+    double start = hostClockMicros();
+    CHECK(start == floor(start));
+    volatile uint32_t spin = 0;
+    for (uint32_t i = 0; i < 1000000; i++)
+    {
+        spin = spin + i;
+    }
+    CHECK(hostClockMicros() == start); // the host's own time does not count
+    delayMicroseconds(1500);
+    CHECK(hostClockMicros() == start + 1500);
+    hostClockSimulated(false);
+    CHECK(hostClockMicros() >= start + 1500); // back on the host clock without going back
+}
+
+static void testTimer()
+{
+    CHECK(ulTaskNotifyTake(pdTRUE, portMAX_DELAY) == 0); // no timer, nothing to wait for
+    hostClockSimulated(true);
+
+    uint32_t ticks = 0;
+    esp_timer_create_args_t args = {};
+    args.callback = notifyTick;
+    args.arg = &ticks;
+    esp_timer_handle_t timer;
+    CHECK(esp_timer_create(&args, &timer) == ESP_OK);
+    double start = hostClockMicros();
+    CHECK(esp_timer_start_periodic(timer, 2500) == ESP_OK);
+    CHECK(esp_timer_start_periodic(timer, 2500) == ESP_ERR_INVALID_STATE);
+    for (uint8_t i = 1; i <= 4; i++)
+    {
+        CHECK(ulTaskNotifyTake(pdTRUE, portMAX_DELAY) == 1);
+        CHECK(hostClockMicros() - start == i * 2500.0);
+    }
+    // a waiter 3 periods late gets the ticks it missed at once
+    delayMicroseconds(7600);
+    CHECK(ulTaskNotifyTake(pdTRUE, portMAX_DELAY) == 3);
+    CHECK(ulTaskNotifyTake(pdFALSE, portMAX_DELAY) == 1);
+    CHECK(ticks == 8);
+    CHECK(esp_timer_delete(timer) == ESP_ERR_INVALID_STATE);
+    CHECK(esp_timer_stop(timer) == ESP_OK);
+    CHECK(esp_timer_delete(timer) == ESP_OK);
+    CHECK(ulTaskNotifyTake(pdTRUE, portMAX_DELAY) == 0);
+    hostClockSimulated(false);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testCard();
+    testCardTiming();
+    testDisplay();
+    testHeap();
+    testSimulatedClock();
+    testTimer();
+    return checkResult("host mocks");
+}
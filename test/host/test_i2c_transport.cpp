@@ -0,0 +1,176 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_i2c_transport.cpp
+//
+// Description:
+//
+// regression test of the panel transport: the chunking policy of
+// oledFlushRegion() (transactions filled across page ends, data at
+// oledWireClock, bus clock restored), the bus mock against the model
+// of i2cTiming.h, and the sweep of i2cBench.h finding the highest
+// clock the panel follows. The clock only moves by the simulated bus
+// time, so the durations are checked tightly whatever the host load.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include <math.h>
+
+#include "i2cBench.h"
+#include "i2cTiming.h"
+#include "oledFlush.h"
+#include "ssd1306Panel.h"
+#include "hostCheck.h"
+
+static bool near(double a, double b)
+{
+    return fabs(a - b) <= 1e-6 * (fabs(a) + fabs(b)) + 1e-9;
+}
+
+static void testModel()
+{
+    // start + address + control + 127 bytes + stop
+    CHECK(i2cTransactionClocks(128) == 1 + 9 * 129 + 1);
+    CHECK(i2cChunkPayload(128) == 127);
+    CHECK(i2cChunkTransactions(1024, 128) == 9);
+    CHECK(i2cChunkTransactions(1024, 16) == 69);
+    CHECK(i2cChunkTransactions(336, 128) == 3);
+
+    // the flush model is the sum of its transactions
+    double sum = 8 * i2cTransactionMicros(128, 400000, 50) + i2cTransactionMicros(1 + 1024 - 8 * 127, 400000, 50);
+    CHECK(near(i2cFlushMicros(1024, 128, 400000, 50), sum));
+}
+
+// one flush of the region, what reached the bus
+struct FlushTrace
+{
+    uint32_t dataTransactions;
+    uint64_t dataBytes;
+    double dataMicros;
+};
+
+static FlushTrace flushTrace(Adafruit_SSD1306 &oled, const FrameRect &region, uint16_t chunk)
+{
+    // the six window commands are two byte transactions at the library clock
+    WireStats before = Wire.stats;
+    CHECK(oledFlushRegion(oled, Wire, 0x3C, region, chunk));
+    FlushTrace t;
+    t.dataTransactions = Wire.stats.transmissions - before.transmissions - 6;
+    t.dataBytes = Wire.stats.bytes - before.bytes - 6 * 2;
+    t.dataMicros = Wire.stats.busMicros - before.busMicros - 6 * i2cTransactionMicros(2, 400000);
+    return t;
+}
+
+static void testFlushPolicy(Adafruit_SSD1306 &oled, SSD1306Panel &panel)
+{
+    for (int16_t x = 0; x < 128; x++)
+    {
+        oled.drawPixel(x, x / 2, 1);
+        oled.drawPixel(x, (x * 7) % 64, 1);
+    }
+
+    // whole buffer: 9 transactions of up to 127 bytes at oledWireClock, clock restored
+    Wire.setClock(100000);
+    FlushTrace t = flushTrace(oled, {0, 0, 128, 64}, oledWireChunk);
+    CHECK(t.dataTransactions == 9);
+    CHECK(t.dataBytes == 1024 + 9);
+    CHECK(near(t.dataMicros, i2cFlushMicros(1024, oledWireChunk, oledWireClock)));
+    CHECK(Wire.getClock() == 100000);
+    CHECK(memcmp(panel.ram(), oled.getBuffer(), 1024) == 0);
+
+    // the player's 48x48 box under the caption: pages 1 to 7, 336 bytes in 3 transactions instead of 7
+    t = flushTrace(oled, {0, 15, 48, 63}, oledWireChunk);
+    CHECK(t.dataTransactions == 3);
+    CHECK(t.dataBytes == 336 + 3);
+
+    // every chunk size and odd regions leave the panel showing the buffer
+    static const uint16_t chunks[] = {2, 3, 16, 33, 64, 127, 128};
+    static const FrameRect regions[] = {{0, 0, 128, 64}, {5, 3, 6, 4}, {17, 9, 111, 57}, {120, 0, 128, 64}, {0, 56, 128, 64}};
+    for (uint16_t chunk : chunks)
+    {
+        for (const FrameRect &region : regions)
+        {
+            oled.fillRect(region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0, chunk & 1);
+            oled.drawPixel(region.x0, region.y0, !(chunk & 1));
+            oled.drawPixel(region.x1 - 1, region.y1 - 1, !(chunk & 1));
+            FrameRect r = frameRectClip(region, 128, 64);
+            uint32_t bytes = (r.x1 - r.x0) * ((r.y1 - 1) / 8 - r.y0 / 8 + 1);
+            t = flushTrace(oled, region, chunk);
+            CHECK(t.dataTransactions == i2cChunkTransactions(bytes, chunk));
+            CHECK(t.dataBytes == bytes + t.dataTransactions);
+            CHECK(near(t.dataMicros, i2cFlushMicros(bytes, chunk, oledWireClock)));
+            CHECK(memcmp(panel.ram(), oled.getBuffer(), 1024) == 0);
+        }
+    }
+
+    // the bus time is also spent on the clock, like on the ESP32
+    uint32_t start = micros();
+    double bus = Wire.stats.busMicros;
+    flushTrace(oled, {0, 0, 128, 64}, oledWireChunk);
+    CHECK(micros() - start >= (uint32_t)(Wire.stats.busMicros - bus) - 1);
+    CHECK(micros() - start <= (uint32_t)(Wire.stats.busMicros - bus) + 1);
+}
+
+static void testSweep(Adafruit_SSD1306 &oled, SSD1306Panel &panel)
+{
+    I2cBenchResult results[i2cBenchClockCount * i2cBenchChunkCount];
+
+    // the panel follows up to 800 kHz, the driver costs 40 us per transaction
+    Wire.maxClock = 800000;
+    Wire.overheadMicros = 40;
+    uint32_t maxStable = i2cBenchSweep(oled, Wire, 0x3C, 4, results);
+    CHECK(maxStable == 800000);
+    CHECK(memcmp(panel.ram(), oled.getBuffer(), 1024) == 0);
+
+    for (uint8_t c = 0; c < i2cBenchClockCount; c++)
+    {
+        for (uint8_t k = 0; k < i2cBenchChunkCount; k++)
+        {
+            const I2cBenchResult &r = results[c * i2cBenchChunkCount + k];
+            CHECK(r.clock == i2cBenchClocks[c] && r.chunk == i2cBenchChunks[k]);
+            CHECK(r.transactions == 4 * i2cChunkTransactions(1024, r.chunk));
+            CHECK((r.failed != 0) == (r.clock > 800000));
+            // start, address, control byte and stop plus the driver, give or take the whole microseconds of micros()
+            double expected = i2cTransactionMicros(1, r.clock, 40);
+            CHECK(r.transactionMicros > expected - 1 && r.transactionMicros < expected + 1);
+        }
+        // bigger chunks are faster at every clock
+        for (uint8_t k = 1; k < i2cBenchChunkCount; k++)
+        {
+            CHECK(results[c * i2cBenchChunkCount + k].bytesPerSecond >
+                  results[c * i2cBenchChunkCount + k - 1].bytesPerSecond);
+        }
+    }
+
+    // a failure at a low clock makes every clock above it unstable too
+    Wire.maxClock = 50000;
+    CHECK(i2cBenchSweep(oled, Wire, 0x3C, 1, results) == 0);
+    Wire.maxClock = 0;
+    Wire.overheadMicros = 0;
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    // the durations checked are the bus model's, not those of a busy host
+    hostClockSimulated(true);
+
+    SSD1306Panel panel;
+    panel.attach(Wire, 0x3C);
+    Adafruit_SSD1306 oled(128, 64, &Wire, -1);
+    oled.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+
+    testModel();
+    testFlushPolicy(oled, panel);
+    testSweep(oled, panel);
+
+    return checkResult("i2c transport");
+}
@@ -0,0 +1,275 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_log.cpp
+//
+// Description:
+//
+// checks the logger of asyncLog.h and its ring (logRing.h): records
+// come out whole and in order across the end of the ring, a full ring
+// drops and counts instead of blocking, a producer and a consumer
+// thread hammering the ring never see a torn record, and with a drain
+// task the caller no longer waits on a 115200 baud UART. Calls above
+// LOG_LEVEL are compiled out with their arguments. Against a drain
+// task on a thread: report lines are never dropped, and nothing is
+// written inside a binary record sent between logPause() and
+// logResume().
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "asyncLog.h"
+#include "hostCheck.h"
+
+// what the logger wrote to Serial since the last call
+static std::string serialText(FILE *capture)
+{
+    std::string text;
+    fflush(capture);
+    long size = ftell(capture);
+    rewind(capture);
+    text.resize(size);
+    CHECK(fread(&text[0], 1, size, capture) == (size_t)size);
+    rewind(capture);
+    return text;
+}
+
+static void testRing()
+{
+    static LogRing ring;
+    LogRecord record;
+    CHECK(!logRingPop(ring, record));
+
+    // 36 byte records wrap the 2 KB ring many times
+    char text[64];
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        int length = snprintf(text, sizeof(text), "record %05u of the ring test.....", i);
+        CHECK(logRingPush(ring, i % 5, text, length));
+        CHECK(logRingPop(ring, record));
+        CHECK(record.level == i % 5 && record.length == length && !strcmp(record.text, text));
+    }
+    CHECK(!logRingPop(ring, record));
+
+    // full: the line is dropped and counted, what was queued is intact
+    uint32_t queued = 0;
+    while (logRingPush(ring, LOG_LEVEL_INFO, "0123456789", 10))
+    {
+        queued++;
+    }
+    CHECK(queued == logRingBytes / 12);
+    CHECK(ring.dropped == 1);
+    CHECK(!logRingPush(ring, LOG_LEVEL_INFO, "9876543210", 10) && ring.dropped == 2);
+    CHECK(logRingPop(ring, record) && !strcmp(record.text, "0123456789"));
+    CHECK(logRingPush(ring, LOG_LEVEL_WARN, "9876543210", 10));
+    for (uint32_t i = 1; i < queued; i++)
+    {
+        CHECK(logRingPop(ring, record) && !strcmp(record.text, "0123456789"));
+    }
+    CHECK(logRingPop(ring, record) && record.level == LOG_LEVEL_WARN && !strcmp(record.text, "9876543210"));
+    CHECK(!logRingPop(ring, record));
+
+    // too long: cut at logLineMax
+    std::string longLine(400, 'l');
+    CHECK(logRingPush(ring, LOG_LEVEL_INFO, longLine.c_str(), longLine.size()));
+    CHECK(logRingPop(ring, record) && record.length == logLineMax && strlen(record.text) == logLineMax);
+}
+
+// a producer and a consumer thread, every record popped must be one pushed, in order
+static void testRingThreads()
+{
+    static LogRing ring;
+    static const uint32_t lines = 200000;
+    std::atomic<uint32_t> pushed{0};
+    std::thread producer([&] {
+        char text[48];
+        for (uint32_t i = 0; i < lines; i++)
+        {
+            int length = snprintf(text, sizeof(text), "%u:%.*s", i, (int)(i % 29), "abcdefghijklmnopqrstuvwxyz0123");
+            pushed += logRingPush(ring, i & 3, text, length);
+        }
+    });
+
+    uint32_t popped = 0;
+    uint32_t torn = 0;
+    int64_t last = -1;
+    LogRecord record;
+    bool producing = true;
+    while (producing || logRingPop(ring, record))
+    {
+        if (producing && !logRingPop(ring, record))
+        {
+            producing = pushed + ring.dropped < lines;
+            std::this_thread::yield();
+            continue;
+        }
+        char *tail;
+        uint32_t i = strtoul(record.text, &tail, 10);
+        size_t letters = strlen(tail + 1);
+        torn += *tail != ':' || (int64_t)i <= last || record.level != (i & 3) || letters != i % 29 ||
+                strncmp(tail + 1, "abcdefghijklmnopqrstuvwxyz0123", letters);
+        last = i;
+        popped++;
+    }
+    producer.join();
+    CHECK(torn == 0);
+    CHECK(popped == pushed && pushed + ring.dropped == lines);
+    CHECK(popped > 0);
+}
+
+static uint32_t debugArguments = 0;
+
+static uint32_t countedArgument()
+{
+    return ++debugArguments;
+}
+
+static void testLogger()
+{
+    FILE *capture = tmpfile();
+    hostSerialOutput(capture);
+    hostSerialBaud(115200);
+
+    // no drain task on the host: written in the caller, Serial.println() style
+    CHECK(!logBegin());
+    LOG_INFO("Starting %s byte Array loop", "Meteo");
+    LOG_ERROR("Not enough memory for %s", "/bell.bin");
+    CHECK(serialText(capture) == "Starting Meteo byte Array loop\r\nNot enough memory for /bell.bin\r\n");
+
+    // above LOG_LEVEL: compiled out, arguments included
+    LOG_DEBUG("skipped %u", countedArgument());
+    CHECK(debugArguments == 0);
+    CHECK(serialText(capture).empty());
+
+    // 20 lines straight to Serial: the caller waits for the UART
+    static const char *line = "Position Down Arrow Animation starting, frame %02u of 28";
+    static const uint32_t lineLength = 54;
+    std::string expected;
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), line, i);
+        expected += text;
+        expected += "\r\n";
+    }
+    double start = hostClockMicros();
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        Serial.printf(line, i);
+        Serial.println();
+    }
+    double direct = hostClockMicros() - start;
+    CHECK(direct > 50000);
+    CHECK(serialText(capture) == expected);
+
+    // the same 20 lines with a drain task, the UART idle again: the caller only formats them
+    hostSerialBaud(115200);
+    logTask = xTaskGetCurrentTaskHandle(); // this test plays the drain task
+    start = hostClockMicros();
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        LOG_INFO(line, i);
+    }
+    double queued = hostClockMicros() - start;
+    CHECK(queued < 5000);
+    CHECK(serialText(capture).empty());
+
+    // drained later, what the caller was spared is spent here
+    start = hostClockMicros();
+    logDrain();
+    CHECK(hostClockMicros() - start > 50000);
+    CHECK(serialText(capture) == expected);
+
+    // a full ring drops, the next drain says how many lines went missing
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        LOG_WARN(line, i);
+    }
+    uint32_t dropped = logDropped();
+    CHECK(dropped == 100 - logRingBytes / (logRecordHeader + lineLength));
+    logDrain();
+    std::string text = serialText(capture);
+    char report[48];
+    snprintf(report, sizeof(report), "Log: %u lines dropped\n", dropped);
+    CHECK(text.find(report) != std::string::npos);
+    logDrain();
+    CHECK(serialText(capture).empty());
+
+    logTask = nullptr;
+    hostSerialBaud(0);
+    hostSerialOutput(nullptr);
+    fclose(capture);
+}
+
+// a drain task on its own thread: reports wait for room, a pause keeps it off Serial
+static void testReportAndPause()
+{
+    FILE *capture = tmpfile();
+    hostSerialOutput(capture);
+    logTask = xTaskGetCurrentTaskHandle();
+    std::atomic<bool> stop{false};
+    std::thread drain([&] {
+        while (!stop)
+        {
+            logDrainPass();
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    // ten times the ring: nothing dropped, the caller waited instead
+    uint32_t dropped = logDropped();
+    std::string expected;
+    for (uint32_t i = 0; i < 10 * logRingBytes / 64; i++)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "sdbench,seq,/sdbench.bin,4096,cold,16,65536,%u,1000", i);
+        logReport("%s", text);
+        expected += text;
+        expected += "\r\n";
+    }
+
+    // a binary record after each line, the line written out before it and nothing inside it
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        LOG_INFO("record %u", i);
+        logPause();
+        CHECK(logRing.head.load() == logRing.tail.load());
+        static const uint8_t record[] = {'P', 'R', 'O', 'F', 0, 1, 2, 3};
+        Serial.write(record, sizeof(record));
+        logResume();
+        char text[32];
+        snprintf(text, sizeof(text), "record %u\r\n", i);
+        expected += text;
+        expected.append((const char *)record, sizeof(record));
+    }
+    logPause();
+    logResume();
+    stop = true;
+    drain.join();
+    CHECK(logDropped() == dropped);
+    CHECK(serialText(capture) == expected);
+
+    logTask = nullptr;
+    hostSerialOutput(nullptr);
+    fclose(capture);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testRing();
+    testRingThreads();
+    testLogger();
+    testReportAndPause();
+    return checkResult("log");
+}
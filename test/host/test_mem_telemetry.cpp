@@ -0,0 +1,133 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_mem_telemetry.cpp
+//
+// Description:
+//
+// checks memTelemetry.h: allocations charged to the subsystem of the
+// enclosing MEM_SCOPE and given back to it when freed, alarms raised
+// once per threshold crossing, the stack watermark going down with
+// deeper calls, and the per cycle low values.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+
+#include "hostHeap.h"
+#include "memTelemetry.h"
+#include "hostCheck.h"
+
+static const HostHeapStats &tagStats(const char *name)
+{
+    uint8_t count;
+    return hostHeapTags(count)[hostHeapTag(name)].stats;
+}
+
+static void testAttribution()
+{
+    uint8_t *a;
+    uint8_t *b;
+    {
+        MEM_SCOPE("load");
+        a = new uint8_t[1000];
+        {
+            MEM_SCOPE("caption");
+            b = new uint8_t[200];
+        }
+        CHECK(tagStats("load").used == 1000);
+        CHECK(tagStats("caption").used == 200);
+    }
+    size_t other = tagStats("other").used;
+
+    // freed outside the scope, still given back to the subsystem that allocated
+    delete[] a;
+    delete[] b;
+    CHECK(tagStats("load").used == 0);
+    CHECK(tagStats("load").highWater == 1000);
+    CHECK(tagStats("caption").used == 0);
+    CHECK(tagStats("other").used == other);
+}
+
+static uint8_t alarmsSeen;
+static uint32_t alarmCalls;
+
+static void onAlarm(uint8_t alarms, const MemSample &sample)
+{
+    alarmsSeen = alarms;
+    alarmCalls++;
+}
+
+static void testAlarms()
+{
+    memOnAlarm(onAlarm);
+    memThresholds = {0, 0, 0};
+    memSample("quiet");
+    CHECK(alarmCalls == 0);
+
+    // crossing raises the alarm once, it fires again only after recovering
+    memThresholds.freeHeap = hostHeapSize + 1;
+    memSample("low");
+    CHECK(alarmCalls == 1 && alarmsSeen == MEM_LOW_HEAP);
+    memSample("still low");
+    CHECK(alarmCalls == 1);
+    memThresholds.freeHeap = 0;
+    memSample("recovered");
+    CHECK(alarmCalls == 1);
+    memThresholds.freeHeap = hostHeapSize + 1;
+    memSample("low again");
+    CHECK(alarmCalls == 2 && alarmsSeen == MEM_LOW_HEAP);
+
+    // a large allocation moves the free heap below a threshold set just under the current value
+    memThresholds = {ESP.getFreeHeap() - 1000, 0, 0};
+    memSample("before");
+    CHECK(alarmCalls == 2);
+    uint8_t *block = new uint8_t[4000];
+    memSample("after");
+    CHECK(alarmCalls == 3 && alarmsSeen == MEM_LOW_HEAP);
+    delete[] block;
+
+    memThresholds = {0, 0, 8192};
+    memSample("stack");
+    CHECK(alarmCalls == 4 && alarmsSeen == MEM_LOW_STACK);
+    memThresholds = {0, 0, 0};
+    memOnAlarm(nullptr);
+}
+
+static uint32_t sampleDeep(int depth)
+{
+    volatile uint8_t pad[512];
+    pad[0] = depth;
+    if (depth > 0)
+    {
+        return sampleDeep(depth - 1) + pad[0];
+    }
+    memSample("deep");
+    return pad[0];
+}
+
+static void testStackAndCycle()
+{
+    memCycleEnd();
+    memSample("shallow");
+    uint32_t shallow = memCycleLow.stackFree[0];
+    CHECK(shallow > 0 && shallow <= 8192);
+    sampleDeep(4);
+    CHECK(memCycleLow.stackFree[0] + 4 * 512 <= shallow);
+    CHECK(memSamples == 2);
+    memCycleEnd();
+    CHECK(memSamples == 0);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testAttribution();
+    testAlarms();
+    testStackAndCycle();
+    return checkResult("memory telemetry");
+}
@@ -0,0 +1,252 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_plane_player.cpp
+//
+// Description:
+//
+// checks planePlayer.h against the SSD1306 panel model: the slot order
+// gives every plane its weight, a 3 plane and a 2 plane asset cycled on
+// the esp_timer of the host are perceived at the levels they encode
+// (host/panelIntensity.h), the fully lit and dark pixels do not
+// flicker, the slots start one period apart without a missed tick and
+// only plane changes are flushed, all on the simulated clock of the
+// host mocks. Plane assets are refused by the
+// monochrome player and byteArray_Unlisted() leaves them to
+// byteArray_Planes(). With the path of assetpack as argument, a PGM
+// strip converted by `assetpack planes` gives the same asset.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <string>
+#include <vector>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "planePlayer.h"
+#include "hostCard.h"
+#include "panelIntensity.h"
+#include "ssd1306Panel.h"
+#include "hostCheck.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static const AnimDesc shade3 = {AnimCategory::Icons, "shade3", "/shade3.bin", "shade3", 48, 48, 0};
+static const AnimDesc shade2 = {AnimCategory::Icons, "shade2", "/shade2.bin", "shade2", 48, 48, 0};
+
+static SSD1306Panel panel;
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+// level of a pixel: columns from dark to fully lit, 6 pixels wide for 8 levels, 12 for 4
+static uint8_t shadeLevel(uint8_t planes, uint16_t x)
+{
+    return x * (1 << planes) / 48;
+}
+
+static std::vector<uint8_t> shadeAsset(uint8_t planes, uint32_t frames)
+{
+    AssetHeader header = {assetVersion, planes == 2 ? ASSET_PLANES2 : ASSET_PLANES3, 48, 48, 6, frames * planes};
+    std::vector<uint8_t> file(assetHeaderSize + 288 * header.frameCount, 0);
+    assetWriteHeader(header, file.data());
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        for (uint8_t p = 0; p < planes; p++)
+        {
+            uint8_t *plane = &file[assetHeaderSize + (f * planes + p) * 288];
+            for (uint16_t y = 0; y < 48; y++)
+            {
+                for (uint16_t x = 0; x < 48; x++)
+                {
+                    if (shadeLevel(planes, x) >> p & 1)
+                    {
+                        plane[y * 6 + x / 8] |= 0x80 >> (x & 7);
+                    }
+                }
+            }
+        }
+    }
+    return file;
+}
+
+static void writeShade(const AnimDesc &anim, uint8_t planes, uint32_t frames)
+{
+    std::vector<uint8_t> file = shadeAsset(planes, frames);
+    File out = SD.open(anim.path, FILE_WRITE);
+    out.write(file.data(), file.size());
+    out.close();
+}
+
+static void testSlots()
+{
+    const uint8_t two[] = {1, 0, 1};
+    const uint8_t three[] = {2, 1, 2, 0, 2, 1, 2};
+    CHECK(planeSlots(2) == 3 && planeSlots(3) == 7);
+    for (uint8_t s = 0; s < 3; s++)
+    {
+        CHECK(planeOfSlot(s, 2) == two[s]);
+    }
+    for (uint8_t s = 0; s < 7; s++)
+    {
+        CHECK(planeOfSlot(s, 3) == three[s]);
+    }
+}
+
+// the frames are all the same, what the eye sees against the levels of the asset
+static void testPerceived(const AnimDesc &anim, uint8_t planes)
+{
+    PanelIntensity intensity;
+    intensity.attach(panel);
+    PlaneStats stats;
+    const uint32_t frames = 12;
+    CHECK(planePlay(anim, frames, &stats) == frames);
+    intensity.detach(panel);
+
+    // the window is at y 16, row 20 of the frame is clear of the caption
+    uint8_t top = (1 << planes) - 1;
+    bool levels = true;
+    for (uint16_t x = 0; x < 48; x++)
+    {
+        double expected = (double)shadeLevel(planes, x) / top;
+        double seen = intensity.mean(x, 36);
+        if (fabs(seen - expected) > 0.03)
+        {
+            fprintf(stderr, "%s x %u: perceived %.3f, expected %.3f\n", anim.id, x, seen, expected);
+            levels = false;
+        }
+    }
+    CHECK(levels);
+
+    // the timer kept the period, every slot on time: on the simulated clock only the bus takes time
+    uint32_t cycles = planeFrameMicros / (stats.period * planeSlots(planes));
+    cycles = cycles ? cycles : 1;
+    CHECK(stats.period >= planePeriodMicros && stats.period > stats.flushMax);
+    CHECK(stats.slots == frames * cycles * planeSlots(planes));
+    CHECK(stats.missed == 0);
+    CHECK(fabs(planeJitterMean(stats) - stats.period) < 1);
+    CHECK(planeJitterWorst(stats) <= 1);
+    // a flush per plane change: all but the wrap of each cycle, plus the first slot of every new frame
+    CHECK(stats.flushes == frames * cycles * (planeSlots(planes) - 1) + frames - 1);
+}
+
+// a frame held still: the dark and full pixels are steady, the others ripple
+static void testRipple()
+{
+    PanelIntensity intensity;
+    intensity.attach(panel);
+    PlaneStats stats;
+    CHECK(planePlay(shade3, 4, &stats) == 4);
+    intensity.detach(panel);
+    CHECK(intensity.elapsedMicros() > 5 * 20000);
+    CHECK(intensity.ripple(0, 36) < 0.01);  // level 0
+    CHECK(intensity.ripple(47, 36) < 0.01); // level 7, still settling from the dark screen
+    CHECK(intensity.ripple(20, 36) > 0.03); // level 3
+}
+
+static void testRefused()
+{
+    AnimAsset asset;
+    CHECK(!animOpen(shade3, asset));
+    CHECK(animOpen(shade3, asset, animAcceptPlanes));
+    CHECK(assetPlaneCount(asset.header) == 3 && asset.header.frameCount == 6);
+    unloadAnimation(asset);
+    CHECK(planePlay(animRegistry[ANIM("bell")], 1) == 0); // one plane, nothing to cycle
+    CHECK(planePlay({AnimCategory::Icons, "none", "/none.bin", "none", 48, 48, 0}, 1) == 0);
+
+    // byteArray_Unlisted() does not touch the panel for them, byteArray_Planes() plays both
+    uint32_t flushes = panel.flushes;
+    byteArray_Unlisted();
+    CHECK(panel.flushes == flushes);
+    byteArray_Planes();
+    CHECK(panel.flushes > flushes);
+}
+
+// the same strip as a PGM of levels 0 to 7, two frames stacked
+static void testAssetpack(const std::string &assetpack)
+{
+    const char *pgm = "test_plane_player.pgm";
+    const char *bin = "test_plane_player.bin";
+    FILE *f = fopen(pgm, "wb");
+    fprintf(f, "P5\n48 96\n7\n");
+    for (uint16_t i = 0; i < 48 * 96; i++)
+    {
+        fputc(shadeLevel(3, i % 48), f);
+    }
+    fclose(f);
+    CHECK(system((assetpack + " planes --planes 3 --frames 2 " + pgm + " " + bin + " > /dev/null").c_str()) == 0);
+
+    std::vector<uint8_t> expected = shadeAsset(3, 2);
+    std::vector<uint8_t> file(expected.size() + 1);
+    f = fopen(bin, "rb");
+    CHECK(f && fread(file.data(), 1, file.size(), f) == expected.size());
+    if (f)
+    {
+        fclose(f);
+    }
+    file.resize(expected.size());
+    CHECK(file == expected);
+    CHECK(system((assetpack + " planes --planes 4 " + pgm + " " + bin + " 2> /dev/null").c_str()) != 0);
+}
+
+int main(int argc, char **argv)
+{
+    hostSerialOutput(nullptr);
+    if (!hostCardImage(ANIM_FILES_DIR, "test_plane_player.card"))
+    {
+        return 1;
+    }
+    // slots, flushes and what the eye sees follow the bus and timer models, not the load of the host
+    hostClockSimulated(true);
+    panel.attach(Wire, SCREEN_I2C_ADDR);
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+    // a 48x48 window is 2.9 ms at 1 MHz, the slots stay near planePeriodMicros
+    Wire.fixedClock = 1000000;
+    CHECK(SD.begin(5));
+
+    // the registry animations are listed, the two plane assets are all byteArray_Unlisted() could play
+    writeShade(shade3, 3, 2);
+    writeShade(shade2, 2, 2);
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+    uint16_t planeAssets = 0;
+    for (uint16_t i = 0; i < assetIndex.count; i++)
+    {
+        uint8_t encoding = assetIndex.entries[i].encoding;
+        planeAssets += encoding == ASSET_PLANES2 || encoding == ASSET_PLANES3;
+    }
+    CHECK(planeAssets == 2);
+
+    testSlots();
+    testPerceived(shade3, 3);
+    testPerceived(shade2, 2);
+    testRipple();
+    testRefused();
+    if (argc > 1)
+    {
+        testAssetpack(argv[1]);
+    }
+    return checkResult("plane player");
+}
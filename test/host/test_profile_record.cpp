@@ -0,0 +1,126 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_profile_record.cpp
+//
+// Description:
+//
+// checks the stage histograms of profileRecord.h: bucket bounds,
+// quantiles against the exact ones of a sorted sample, and the binary
+// record round trip including the rejection of damaged records.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "profileRecord.h"
+#include "hostCheck.h"
+
+static void testBuckets()
+{
+    // every value lies inside its bucket, buckets are contiguous and ordered
+    for (uint8_t i = 0; i + 1 < profileBucketCount; i++)
+    {
+        CHECK(profileBucketLow(i) < profileBucketLow(i + 1));
+        CHECK(profileBucket(profileBucketLow(i)) == i);
+        CHECK(profileBucket(profileBucketLow(i + 1) - 1) == i);
+    }
+    CHECK(profileBucket(0xFFFFFFFF) == profileBucketCount - 1);
+
+    std::mt19937 rng(36);
+    for (int n = 0; n < 100000; n++)
+    {
+        uint32_t v = rng() >> (rng() % 32);
+        uint8_t b = profileBucket(v);
+        CHECK(b < profileBucketCount);
+        CHECK(profileBucketLow(b) <= v);
+        CHECK(b + 1 == profileBucketCount || v < profileBucketLow(b + 1));
+    }
+}
+
+static void testQuantiles()
+{
+    ProfileHistogram h;
+    profileClear(h);
+    CHECK(profileQuantile(h, 0.5f) == 0);
+
+    std::mt19937 rng(95);
+    std::lognormal_distribution<double> flush(11.0, 0.4); // a few ms at 240 MHz
+    std::vector<uint32_t> samples;
+    for (int n = 0; n < 20000; n++)
+    {
+        uint32_t v = (uint32_t)flush(rng);
+        samples.push_back(v);
+        profileAdd(h, v);
+    }
+    std::sort(samples.begin(), samples.end());
+    CHECK(h.count == samples.size());
+    CHECK(h.min == samples.front());
+    CHECK(h.max == samples.back());
+
+    for (float q : {0.5f, 0.95f, 0.99f})
+    {
+        double exact = samples[(size_t)(q * (samples.size() - 1))];
+        double got = profileQuantile(h, q);
+        CHECK(got > exact * 0.8 && got < exact * 1.2);
+    }
+    CHECK(profileQuantile(h, 1.0f) <= h.max);
+    CHECK(profileQuantile(h, 0.0f) >= h.min);
+}
+
+static void testRecord()
+{
+    ProfileHistogram stages[profileStageCount];
+    std::mt19937 rng(99);
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        profileClear(stages[s]);
+        for (int n = 0; n < 1000 * s; n++)
+        {
+            profileAdd(stages[s], rng() >> (rng() % 32));
+        }
+    }
+
+    std::vector<uint8_t> record(profileRecordMaxBytes);
+    size_t size = profileEncode(stages, 240, record.data());
+    CHECK(size > 0 && size <= profileRecordMaxBytes);
+
+    ProfileHistogram decoded[profileStageCount];
+    uint16_t mhz = 0;
+    CHECK(profileDecode(record.data(), size, decoded, mhz) == size);
+    CHECK(mhz == 240);
+    CHECK(memcmp(decoded, stages, sizeof(stages)) == 0);
+
+    // truncated or damaged records are refused
+    CHECK(profileDecode(record.data(), size - 1, decoded, mhz) == 0);
+    record[size / 2] ^= 0x10;
+    CHECK(profileDecode(record.data(), size, decoded, mhz) == 0);
+
+    // worst case, every bucket of every stage used
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        for (uint8_t i = 0; i < profileBucketCount; i++)
+        {
+            profileAdd(stages[s], profileBucketLow(i));
+        }
+    }
+    size = profileEncode(stages, 240, record.data());
+    CHECK(size == profileRecordMaxBytes);
+    CHECK(profileDecode(record.data(), size, decoded, mhz) == size);
+}
+
+int main()
+{
+    testBuckets();
+    testQuantiles();
+    testRecord();
+    return checkResult("profile record");
+}
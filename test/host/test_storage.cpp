@@ -0,0 +1,163 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_storage.cpp
+//
+// Description:
+//
+// checks the bus probe of sdStorage.h against simulated cards: one
+// that fails above a given clock, one with a single data line wired,
+// one that fails at every clock. The probe must keep the fastest mode
+// that reads back intact, measure it faster than the slower modes,
+// and leave the card mounted for the loader in that mode.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <SD_MMC.h>
+
+#include "animations.h"
+#include "animLoader.h"
+#include "hostCard.h"
+#include "sdStorage.h"
+#include "hostCheck.h"
+
+FramePack framePack;
+
+// what the reader of the board could do with SDMMC wired, fastest first
+static const StorageConfig allModes[] = {
+    {STORAGE_SDMMC_4BIT, 40000000}, {STORAGE_SDMMC_4BIT, 20000000}, {STORAGE_SDMMC_1BIT, 40000000},
+    {STORAGE_SDMMC_1BIT, 20000000}, {STORAGE_SPI, 40000000},        {STORAGE_SPI, 20000000},
+    {STORAGE_SPI, 10000000},        {STORAGE_SPI, 4000000},
+};
+static const uint8_t allModeCount = sizeof(allModes) / sizeof(allModes[0]);
+
+// a fresh card, stable up to maxClock with the given data lines wired
+static bool newCard(uint32_t maxClock, uint8_t wiredLines)
+{
+    if (!hostCardImage(ANIM_FILES_DIR, "test_storage.card"))
+    {
+        return false;
+    }
+    SD.timing.maxClock = SD_MMC.timing.maxClock = maxClock;
+    SD_MMC.wiredLines = wiredLines;
+    return true;
+}
+
+static bool loads(const AnimDesc &anim)
+{
+    AnimAsset asset;
+    if (!loadAnimation(anim.path, anim, asset))
+    {
+        return false;
+    }
+    unloadAnimation(asset);
+    return asset.header.frameCount > 0;
+}
+
+static void testSpiClock()
+{
+    SPIClass bus(HSPI);
+    storageUseSpi(bus, {14, 12, 13, 15});
+
+    // stable at any clock: the fastest SPI mode
+    StorageReport report;
+    CHECK(newCard(0, 4));
+    CHECK(storageProbe(storageCandidates, storageCandidateCount, report));
+    CHECK(report.config.mode == STORAGE_SPI && report.config.clock == 40000000);
+    CHECK(report.tried == 1);
+    uint32_t fast = report.bytesPerSecond;
+
+    // the configured bus is the one the card is mounted on
+    CHECK(SD.mounted && SD.spi == &bus && SD.frequency == 40000000);
+    CHECK(bus.started && bus.pins[0] == 14 && bus.pins[3] == 15);
+    CHECK(&storageFS() == &SD);
+
+    // fails above 25 MHz: 40 MHz is refused, 20 MHz kept and slower
+    CHECK(newCard(25000000, 4));
+    CHECK(storageProbe(storageCandidates, storageCandidateCount, report));
+    CHECK(report.config.mode == STORAGE_SPI && report.config.clock == 20000000);
+    CHECK(report.tried == 2);
+    CHECK(report.bytesPerSecond > 0 && report.bytesPerSecond < fast);
+    CHECK(SD.frequency == 20000000);
+    CHECK(loads(animRegistry[ANIM("bell")]));
+
+    // the probe file is kept, the next boot does not write it again
+    File probe = storageFS().open(storageProbePath);
+    CHECK(probe && probe.size() == storageProbeBytes);
+    probe.close();
+    uint64_t written = SD.stats.bytesWritten;
+    CHECK(storageProbe(storageCandidates, storageCandidateCount, report));
+    CHECK(SD.stats.bytesWritten == written);
+    storageUseSpi(SPI, {-1, -1, -1, 5});
+}
+
+static void testSdmmc()
+{
+    // 4 lines wired: 4-bit at 40 MHz beats every SPI mode
+    StorageReport report;
+    CHECK(newCard(0, 4));
+    CHECK(storageProbe(allModes, allModeCount, report));
+    CHECK(report.config.mode == STORAGE_SDMMC_4BIT && report.config.clock == 40000000);
+    CHECK(SD_MMC.mounted && !SD.mounted && &storageFS() == &SD_MMC);
+    CHECK(SD_MMC.timing.dataLines == 4 && SD_MMC.timing.clock == 40000000);
+    CHECK(loads(animRegistry[ANIM("gear")]));
+    CHECK(storageUsedBytes() == SD_MMC.usedBytes() && storageUsedBytes() > 0);
+    uint32_t wide = report.bytesPerSecond;
+
+    // only D0 wired: the 4-bit mounts fail, 1-bit at 40 MHz is kept and slower
+    CHECK(newCard(0, 1));
+    CHECK(storageProbe(allModes, allModeCount, report));
+    CHECK(report.config.mode == STORAGE_SDMMC_1BIT && report.config.clock == 40000000);
+    CHECK(report.tried == 3);
+    CHECK(report.bytesPerSecond < wide);
+
+    // unstable above 30 MHz and a single line: 1-bit at 20 MHz
+    CHECK(newCard(30000000, 1));
+    CHECK(storageProbe(allModes, allModeCount, report));
+    CHECK(report.config.mode == STORAGE_SDMMC_1BIT && report.config.clock == 20000000);
+    CHECK(loads(animRegistry[ANIM("globe")]));
+
+    // wired to the SDMMC pins only, like the STORAGE_SDMMC build: the SPI modes never mount,
+    // the probe file is written through the slowest SDMMC mode
+    CHECK(newCard(0, 4));
+    SD.spiWired = false;
+    CHECK(storageProbe(allModes, allModeCount, report));
+    CHECK(report.config.mode == STORAGE_SDMMC_4BIT && report.config.clock == 40000000);
+    CHECK(report.tried == 1);
+    File probe = storageFS().open(storageProbePath);
+    CHECK(probe && probe.size() == storageProbeBytes);
+    probe.close();
+    SD.spiWired = true;
+}
+
+static void testNothingWorks()
+{
+    // every read fails: no mode is kept and the card is left unmounted
+    StorageReport report;
+    CHECK(newCard(1000000, 4));
+    CHECK(!storageProbe(allModes, allModeCount, report));
+    CHECK(report.bytesPerSecond == 0 && report.tried == allModeCount);
+    CHECK(!SD.mounted && !SD_MMC.mounted);
+
+    // no card at all: nothing to try
+    SD.setRoot("");
+    SD_MMC.setRoot("");
+    CHECK(!storageProbe(allModes, allModeCount, report));
+    CHECK(report.tried == 0);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testSpiClock();
+    testSdmmc();
+    testNothingWorks();
+    return checkResult("storage");
+}
@@ -0,0 +1,125 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: test_trace.cpp
+//
+// Description:
+//
+// checks the session trace of traceRecorder.h: nothing recorded while
+// closed, scopes measuring the host clock, the I2C and SD spans of the
+// mocks with their modelled times (fixed bus clock, card model), and
+// the written JSON.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <string>
+
+#include "hostCard.h"
+#include "i2cTiming.h"
+#include "traceRecorder.h"
+#include "hostCheck.h"
+
+static std::string readText(const char *path)
+{
+    std::string text;
+    if (FILE *f = fopen(path, "rb"))
+    {
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        {
+            text.append(buf, n);
+        }
+        fclose(f);
+    }
+    return text;
+}
+
+// duration of the event whose name is at pos
+static double durationBefore(const std::string &json, size_t pos)
+{
+    size_t dur = json.rfind("\"dur\":", pos);
+    return dur == std::string::npos ? -1 : atof(json.c_str() + dur + 6);
+}
+
+static void testSession()
+{
+    {
+        TraceScope idle(TRACE_PLAYER, "before");
+    }
+    CHECK(!traceActive() && traceEventCount() == 0);
+
+    CHECK(traceOpen("test_trace.json"));
+    {
+        TraceScope outer(TRACE_PLAYER, "outer");
+        TraceScope inner(TRACE_PLAYER, "inner");
+        hostClockAdvance(250);
+    }
+    CHECK(traceEventCount() == 2);
+
+    // the bus runs at the fixed clock whatever the sketch sets
+    Wire.begin();
+    Wire.setClock(400000);
+    Wire.fixedClock = 100000;
+    uint8_t data[17] = {0x40};
+    Wire.beginTransmission(0x3C);
+    Wire.write(data, sizeof(data));
+    Wire.endTransmission();
+    Wire.fixedClock = 0;
+    CHECK(traceEventCount() == 3);
+
+    // a cold read of one sector: command, 512 bytes at the card clock, the read call
+    CHECK(hostCardImage(ANIM_FILES_DIR, "test_trace.card"));
+    CHECK(SD.begin(5, SPI, 4000000));
+    File file = SD.open("/aircraft.bin");
+    uint8_t buf[288];
+    CHECK(file.read(buf, sizeof(buf)) == sizeof(buf));
+    file.close();
+    CHECK(traceEventCount() == 5);
+
+    CHECK(traceClose());
+    CHECK(!traceActive() && traceEventCount() == 0);
+
+    std::string json = readText("test_trace.json");
+    CHECK(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    CHECK(json.size() > 4 && json.compare(json.size() - 4, 4, "\n]}\n") == 0);
+    int depth = 0, lowest = 0;
+    for (char c : json)
+    {
+        depth += (c == '{' || c == '[') - (c == '}' || c == ']');
+        lowest = depth < lowest ? depth : lowest;
+    }
+    CHECK(depth == 0 && lowest == 0);
+    CHECK(json.find("\"name\":\"thread_name\",\"args\":{\"name\":\"i2c\"}") != std::string::npos);
+
+    // scopes end inner first, both measured the advance
+    size_t inner = json.find("\"name\":\"inner\"");
+    size_t outer = json.find("\"name\":\"outer\"");
+    CHECK(inner != std::string::npos && outer != std::string::npos && inner < outer);
+    CHECK(durationBefore(json, inner) >= 250 && durationBefore(json, outer) >= durationBefore(json, inner));
+
+    char expected[128];
+    snprintf(expected, sizeof(expected), "\"dur\":%.3f,\"name\":\"data\",\"args\":{\"bytes\":17,\"clock\":100000}",
+             i2cTransactionMicros(sizeof(data), 100000));
+    CHECK(json.find(expected) != std::string::npos);
+
+    snprintf(expected, sizeof(expected), "\"dur\":%.3f,\"name\":\"read\",\"args\":{\"path\":\"/aircraft.bin\",\"bytes\":288}",
+             SD.timing.callMicros + SD.timing.commandMicros + 512 * 8e6 / 4000000);
+    CHECK(json.find(expected) != std::string::npos);
+}
+
+int main()
+{
+    hostSerialOutput(nullptr);
+    testSession();
+    return checkResult("session trace");
+}
@@ -0,0 +1,601 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: assetSource.h
+//
+// Description:
+//
+// readers of the animation sources for the asset compiler of
+// assetpack: the PROGMEM byte arrays of the lib/*ver1.h headers made
+// by the wokwi animator, animated GIFs and PBM image sequences (P4,
+// as written by host/frameRecorder). Each yields the frames of an
+// animation as raw rows, MSB first, (width + 7) / 8 bytes per row:
+// the layout of the dumps in the files folder.
+//
+// GIF frames are composed on the logical screen like a viewer does
+// (transparency, disposal to background or to the previous frame)
+// and a pixel is lit when its colour is dark, the icons being drawn
+// black on white; invert flips that.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#ifndef ASSETSOURCE_H
+#define ASSETSOURCE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <string>
+#include <vector>
+
+struct SourceAsset
+{
+    std::string name;
+    std::string origin; // file the frames came from
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint8_t> frames;
+};
+
+inline uint32_t sourceFrameBytes(uint16_t width, uint16_t height)
+{
+    return (uint32_t)((width + 7) / 8) * height;
+}
+
+// square geometry holding frameBytes per frame, 48x48 for the 288 byte frames of the animator
+inline bool sourceGuessSize(uint32_t frameBytes, uint16_t &width, uint16_t &height)
+{
+    for (uint32_t w = 8; w <= 1024; w += 8)
+    {
+        if (sourceFrameBytes(w, w) == frameBytes)
+        {
+            width = height = w;
+            return true;
+        }
+    }
+    return false;
+}
+
+// C source with the comments blanked, line breaks kept for the error messages
+inline std::string sourceStripComments(const std::string &text)
+{
+    std::string out = text;
+    for (size_t i = 0; i + 1 < out.size(); i++)
+    {
+        if (out[i] == '"' || out[i] == '\'')
+        {
+            char quote = out[i];
+            for (i++; i < out.size() && out[i] != quote; i++)
+            {
+                i += out[i] == '\\';
+            }
+        }
+        else if (out[i] == '/' && out[i + 1] == '/')
+        {
+            for (; i < out.size() && out[i] != '\n'; i++)
+            {
+                out[i] = ' ';
+            }
+        }
+        else if (out[i] == '/' && out[i + 1] == '*')
+        {
+            size_t end = out.find("*/", i + 2);
+            end = end == std::string::npos ? out.size() : end + 2;
+            for (; i < end; i++)
+            {
+                out[i] = out[i] == '\n' ? '\n' : ' ';
+            }
+            i--;
+        }
+    }
+    return out;
+}
+
+inline uint32_t sourceLine(const std::string &text, size_t pos)
+{
+    uint32_t line = 1;
+    for (size_t i = 0; i < pos && i < text.size(); i++)
+    {
+        line += text[i] == '\n';
+    }
+    return line;
+}
+
+// every "PROGMEM name[frames][bytes] = {...}" array of a header, one or two dimensions;
+// width and height 0 guess a square frame from the inner dimension
+inline bool sourceParseProgmem(const std::string &text, const std::string &origin, uint16_t width, uint16_t height,
+                               std::vector<SourceAsset> &assets, std::string &error)
+{
+    std::string code = sourceStripComments(text);
+    size_t pos = 0;
+    while ((pos = code.find("PROGMEM", pos)) != std::string::npos)
+    {
+        size_t declStart = pos;
+        pos += 7;
+
+        // type words may follow PROGMEM, the name is the identifier in front of the first '['
+        size_t bracket = code.find('[', pos);
+        size_t assign = code.find('=', pos);
+        if (bracket == std::string::npos || assign == std::string::npos || assign < bracket)
+        {
+            continue;
+        }
+        size_t nameEnd = bracket;
+        while (nameEnd > pos && isspace((unsigned char)code[nameEnd - 1]))
+        {
+            nameEnd--;
+        }
+        size_t nameStart = nameEnd;
+        while (nameStart > pos && (isalnum((unsigned char)code[nameStart - 1]) || code[nameStart - 1] == '_'))
+        {
+            nameStart--;
+        }
+
+        SourceAsset asset;
+        asset.name = code.substr(nameStart, nameEnd - nameStart);
+        asset.origin = origin;
+        std::string where = origin + ":" + std::to_string(sourceLine(code, declStart)) + ": " + asset.name;
+
+        std::vector<uint32_t> dims;
+        for (size_t p = bracket; p < assign; p++)
+        {
+            if (code[p] == '[')
+            {
+                dims.push_back(strtoul(code.c_str() + p + 1, nullptr, 0));
+            }
+        }
+        if (asset.name.empty() || dims.empty() || dims.size() > 2)
+        {
+            error = where + ": not a byte array of frames";
+            return false;
+        }
+
+        size_t open = code.find('{', assign);
+        if (open == std::string::npos)
+        {
+            error = where + ": no initializer";
+            return false;
+        }
+        int depth = 0;
+        size_t p = open;
+        for (; p < code.size(); p++)
+        {
+            char c = code[p];
+            if (c == '{')
+            {
+                depth++;
+            }
+            else if (c == '}')
+            {
+                if (--depth == 0)
+                {
+                    break;
+                }
+            }
+            else if (isdigit((unsigned char)c))
+            {
+                char *end;
+                unsigned long v = strtoul(code.c_str() + p, &end, 0);
+                if (code[p] == '0' && (code[p + 1] == 'b' || code[p + 1] == 'B'))
+                {
+                    v = strtoul(code.c_str() + p + 2, &end, 2);
+                }
+                if (v > 0xFF)
+                {
+                    error = where + ": value " + std::to_string(v) + " is not a byte";
+                    return false;
+                }
+                asset.frames.push_back((uint8_t)v);
+                p = end - code.c_str() - 1;
+            }
+            else if (isalpha((unsigned char)c) || c == '_')
+            {
+                error = where + ": unexpected symbol in the initializer";
+                return false;
+            }
+        }
+        if (depth != 0)
+        {
+            error = where + ": initializer not closed";
+            return false;
+        }
+        pos = p;
+
+        uint32_t frameBytes = dims.size() == 2 ? dims[1] : asset.frames.size();
+        uint32_t frameCount = dims.size() == 2 ? dims[0] : 1;
+        if (frameBytes == 0 && frameCount == 0)
+        {
+            error = where + ": frame size unknown";
+            return false;
+        }
+        if (frameBytes == 0 || frameCount == 0)
+        {
+            frameBytes = frameBytes ? frameBytes : asset.frames.size() / frameCount;
+            frameCount = frameCount ? frameCount : asset.frames.size() / frameBytes;
+        }
+        // C fills missing initializers with zeros
+        asset.frames.resize((size_t)frameCount * frameBytes, 0);
+
+        asset.width = width;
+        asset.height = height;
+        if (!width && !sourceGuessSize(frameBytes, asset.width, asset.height))
+        {
+            error = where + ": " + std::to_string(frameBytes) + " bytes per frame is not a square frame, give the size";
+            return false;
+        }
+        if (sourceFrameBytes(asset.width, asset.height) != frameBytes)
+        {
+            error = where + ": " + std::to_string(frameBytes) + " bytes per frame do not match " +
+                    std::to_string(asset.width) + "x" + std::to_string(asset.height);
+            return false;
+        }
+        assets.push_back(asset);
+    }
+    return true;
+}
+
+// concatenated P4 images of one size
+inline bool sourceParsePbm(const std::vector<uint8_t> &data, SourceAsset &asset, std::string &error)
+{
+    size_t p = 0;
+    asset.frames.clear();
+    auto skipSpace = [&]()
+    {
+        while (p < data.size() && (isspace(data[p]) || data[p] == '#'))
+        {
+            if (data[p] == '#')
+            {
+                while (p < data.size() && data[p] != '\n')
+                {
+                    p++;
+                }
+            }
+            else
+            {
+                p++;
+            }
+        }
+    };
+    auto number = [&]()
+    {
+        skipSpace();
+        uint32_t v = 0;
+        while (p < data.size() && isdigit(data[p]))
+        {
+            v = v * 10 + (data[p++] - '0');
+        }
+        return v;
+    };
+
+    uint32_t frames = 0;
+    skipSpace();
+    while (p < data.size())
+    {
+        if (p + 2 > data.size() || data[p] != 'P' || data[p + 1] != '4')
+        {
+            error = asset.origin + ": image " + std::to_string(frames) + " is not a binary PBM (P4)";
+            return false;
+        }
+        p += 2;
+        uint32_t w = number();
+        uint32_t h = number();
+        p++; // the single white space before the bits
+        if (w == 0 || h == 0 || w > 0xFFFF || h > 0xFFFF || (frames && (w != asset.width || h != asset.height)))
+        {
+            error = asset.origin + ": image " + std::to_string(frames) + " has a bad or different size";
+            return false;
+        }
+        asset.width = w;
+        asset.height = h;
+        uint32_t bytes = sourceFrameBytes(w, h);
+        if (p + bytes > data.size())
+        {
+            error = asset.origin + ": image " + std::to_string(frames) + " truncated";
+            return false;
+        }
+        // PBM rows are byte padded and 1 is black: the same bits as the raw frames
+        asset.frames.insert(asset.frames.end(), data.begin() + p, data.begin() + p + bytes);
+        p += bytes;
+        frames++;
+        skipSpace();
+    }
+    if (frames == 0)
+    {
+        error = asset.origin + ": no image";
+        return false;
+    }
+    return true;
+}
+
+// variable length codes of a GIF image, returns false on a damaged stream
+inline bool sourceGifLzw(const std::vector<uint8_t> &data, uint8_t minCodeSize, uint32_t pixels,
+                         std::vector<uint8_t> &out)
+{
+    if (minCodeSize < 2 || minCodeSize > 8)
+    {
+        return false;
+    }
+    const uint16_t clear = 1 << minCodeSize;
+    const uint16_t end = clear + 1;
+    uint16_t prefix[4096];
+    uint8_t suffix[4096];
+    uint8_t stack[4097];
+    for (uint16_t i = 0; i < clear; i++)
+    {
+        prefix[i] = 0xFFFF;
+        suffix[i] = i;
+    }
+
+    uint8_t codeSize = minCodeSize + 1;
+    uint16_t next = clear + 2;
+    int32_t prev = -1;
+    uint8_t first = 0;
+    uint32_t bits = 0, bitCount = 0;
+    size_t p = 0;
+    out.clear();
+
+    while (out.size() < pixels)
+    {
+        while (bitCount < codeSize)
+        {
+            if (p == data.size())
+            {
+                return false;
+            }
+            bits |= (uint32_t)data[p++] << bitCount;
+            bitCount += 8;
+        }
+        uint16_t code = bits & ((1 << codeSize) - 1);
+        bits >>= codeSize;
+        bitCount -= codeSize;
+
+        if (code == clear)
+        {
+            codeSize = minCodeSize + 1;
+            next = clear + 2;
+            prev = -1;
+            continue;
+        }
+        if (code == end)
+        {
+            break;
+        }
+        if (prev < 0)
+        {
+            if (code >= clear)
+            {
+                return false;
+            }
+            out.push_back(code);
+            first = code;
+            prev = code;
+            continue;
+        }
+        if (code > next || (code == next && next == 4096))
+        {
+            return false;
+        }
+
+        // the string of the code backwards on the stack, a code not yet known is prev + its first byte
+        uint16_t depth = 0;
+        uint16_t c = code == next ? prev : code;
+        if (code == next)
+        {
+            stack[depth++] = first;
+        }
+        while (c >= clear)
+        {
+            stack[depth++] = suffix[c];
+            c = prefix[c];
+        }
+        stack[depth++] = c;
+        first = c;
+        while (depth)
+        {
+            out.push_back(stack[--depth]);
+        }
+
+        if (next < 4096)
+        {
+            prefix[next] = prev;
+            suffix[next] = first;
+            next++;
+            if (next == (1 << codeSize) && codeSize < 12)
+            {
+                codeSize++;
+            }
+        }
+        prev = code;
+    }
+    out.resize(pixels, 0);
+    return true;
+}
+
+// every image of an animated GIF composed on the logical screen, cropped to its size
+inline bool sourceParseGif(const std::vector<uint8_t> &data, bool invert, SourceAsset &asset, std::string &error)
+{
+    auto u16 = [&](size_t at) { return (uint16_t)(data[at] | (data[at + 1] << 8)); };
+    if (data.size() < 13 || (memcmp(data.data(), "GIF87a", 6) != 0 && memcmp(data.data(), "GIF89a", 6) != 0))
+    {
+        error = asset.origin + ": not a GIF";
+        return false;
+    }
+    asset.width = u16(6);
+    asset.height = u16(8);
+    uint8_t flags = data[10];
+    size_t p = 13;
+
+    // lit or not per palette entry
+    auto readPalette = [&](uint8_t sizeBits, std::vector<uint8_t> &lit)
+    {
+        uint16_t entries = 2 << sizeBits;
+        if (p + entries * 3 > data.size())
+        {
+            return false;
+        }
+        lit.resize(256, 0);
+        for (uint16_t i = 0; i < entries; i++, p += 3)
+        {
+            uint32_t luma = data[p] * 299 + data[p + 1] * 587 + data[p + 2] * 114;
+            lit[i] = (luma < 128000) != invert;
+        }
+        return true;
+    };
+    std::vector<uint8_t> globalLit;
+    if ((flags & 0x80) && !readPalette(flags & 7, globalLit))
+    {
+        error = asset.origin + ": truncated palette";
+        return false;
+    }
+
+    std::vector<uint8_t> canvas((size_t)asset.width * asset.height, 0);
+    std::vector<uint8_t> saved;
+    int16_t transparent = -1;
+    uint8_t disposal = 0;
+    uint16_t stride = (asset.width + 7) / 8;
+    asset.frames.clear();
+
+    while (p < data.size())
+    {
+        uint8_t block = data[p++];
+        if (block == 0x3B)
+        {
+            break;
+        }
+        if (block == 0x21)
+        {
+            if (p + 1 > data.size())
+            {
+                break;
+            }
+            uint8_t label = data[p++];
+            if (label == 0xF9 && p + 5 <= data.size() && data[p] >= 4)
+            {
+                disposal = (data[p + 1] >> 2) & 7;
+                transparent = (data[p + 1] & 1) ? data[p + 4] : -1;
+            }
+            // every extension is a chain of sub-blocks
+            while (p < data.size() && data[p])
+            {
+                p += data[p] + 1;
+            }
+            p++;
+            continue;
+        }
+        if (block != 0x2C || p + 9 > data.size())
+        {
+            error = asset.origin + ": damaged block";
+            return false;
+        }
+
+        uint16_t left = u16(p), top = u16(p + 2), w = u16(p + 4), h = u16(p + 6);
+        uint8_t imageFlags = data[p + 8];
+        p += 9;
+        std::vector<uint8_t> localLit;
+        if ((imageFlags & 0x80) && !readPalette(imageFlags & 7, localLit))
+        {
+            error = asset.origin + ": truncated palette";
+            return false;
+        }
+        const std::vector<uint8_t> &lit = (imageFlags & 0x80) ? localLit : globalLit;
+        if (lit.empty() || p >= data.size())
+        {
+            error = asset.origin + ": image without palette";
+            return false;
+        }
+
+        uint8_t minCodeSize = data[p++];
+        std::vector<uint8_t> codes;
+        while (p < data.size() && data[p])
+        {
+            uint8_t len = data[p];
+            if (p + 1 + len > data.size())
+            {
+                break;
+            }
+            codes.insert(codes.end(), data.begin() + p + 1, data.begin() + p + 1 + len);
+            p += len + 1;
+        }
+        p++;
+
+        std::vector<uint8_t> indices;
+        if (!sourceGifLzw(codes, minCodeSize, (uint32_t)w * h, indices))
+        {
+            error = asset.origin + ": damaged image data in frame " +
+                    std::to_string(asset.frames.size() / sourceFrameBytes(asset.width, asset.height));
+            return false;
+        }
+
+        if (disposal == 3)
+        {
+            saved = canvas;
+        }
+        for (uint16_t row = 0; row < h; row++)
+        {
+            // interlaced rows come in four passes: every 8th from 0, every 8th from 4, every 4th from 2, odd ones
+            uint16_t y = row;
+            if (imageFlags & 0x40)
+            {
+                uint16_t pass1 = (h + 7) / 8, pass2 = (h + 3) / 8, pass3 = (h + 1) / 4;
+                y = row < pass1 ? row * 8
+                    : row < pass1 + pass2 ? (row - pass1) * 8 + 4
+                    : row < pass1 + pass2 + pass3 ? (row - pass1 - pass2) * 4 + 2
+                    : (row - pass1 - pass2 - pass3) * 2 + 1;
+            }
+            for (uint16_t col = 0; col < w; col++)
+            {
+                uint8_t index = indices[(size_t)row * w + col];
+                uint32_t x = left + col, cy = top + y;
+                if (index != transparent && x < asset.width && cy < asset.height)
+                {
+                    canvas[cy * asset.width + x] = lit[index];
+                }
+            }
+        }
+
+        size_t base = asset.frames.size();
+        asset.frames.resize(base + sourceFrameBytes(asset.width, asset.height), 0);
+        for (uint16_t y = 0; y < asset.height; y++)
+        {
+            for (uint16_t x = 0; x < asset.width; x++)
+            {
+                if (canvas[(size_t)y * asset.width + x])
+                {
+                    asset.frames[base + (size_t)y * stride + x / 8] |= 0x80 >> (x & 7);
+                }
+            }
+        }
+
+        if (disposal == 2)
+        {
+            for (uint32_t y = top; y < (uint32_t)top + h && y < asset.height; y++)
+            {
+                for (uint32_t x = left; x < (uint32_t)left + w && x < asset.width; x++)
+                {
+                    canvas[y * asset.width + x] = 0;
+                }
+            }
+        }
+        else if (disposal == 3)
+        {
+            canvas = saved;
+        }
+        disposal = 0;
+        transparent = -1;
+    }
+
+    if (asset.frames.empty())
+    {
+        error = asset.origin + ": no image";
+        return false;
+    }
+    return true;
+}
+
+#endif // ASSETSOURCE_H
@@ -0,0 +1,1490 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: assetpack.cpp
+//
+// Description:
+//
+// host side asset packer for the byte array animations. Converts the
+// headerless dumps of the files folder into self-describing assets
+// (see src/assetFormat.h) or into one deduplicated animation pack
+// (see src/framePack.h) that can be copied to the SD card.
+//
+// Build:   g++ -std=c++17 -O2 -pthread -I../src assetpack.cpp -o assetpack
+//
+// Usage:   assetpack wrap <in.bin> <out.bin> [width height]
+//          assetpack info <file.bin>...
+//          assetpack pack [--sparse] <out.pak> <file.bin>...
+//          assetpack boxes <file.bin>...
+//          assetpack delta [--key K] <in.bin> <out.bin>
+//          assetpack bench-delta <file.bin>...
+//          assetpack tiles <in.bin> <out.bin>
+//          assetpack bench-tiles <file.bin>...
+//          assetpack gray [--frames N] <in.pgm> <out.bin>
+//          assetpack planes [--planes 2|3] [--frames N] <in.pgm> <out.bin>
+//          assetpack compile [--jobs N] [--emit raw,page,delta,tiles,pack] [--check DIR]
+//                            [--size WxH] [--invert] [--force] <out-dir> <source>...
+//
+// compile is the asset compiler: it reads the PROGMEM arrays of the
+// lib/*ver1.h headers, GIF and PBM sequences (see assetSource.h) and
+// writes, in one pass and one thread per core, the raw dump, the page
+// major frames, the delta and tile encodings of every animation and
+// the pack of all of them. --check compares every raw dump with the
+// one of the same name in DIR (the files folder). <out-dir> keeps a
+// stamp of what was built: a second run only encodes the animations
+// whose frames, size or outputs changed; the sources are parsed again.
+//
+// gray converts a binary PGM, its frames stacked top to bottom, into a
+// 4 bit grayscale asset (ASSET_GRAY4) for the panels of grayPanel.h,
+// planes into 2 or 3 bit-planes per frame (ASSET_PLANES2 and 3) for
+// the temporal dithering of planePlayer.h.
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assetFormat.h"
+#include "frameCodec.h"
+#include "framePack.h"
+#include "frameRegion.h"
+#include "tileCodec.h"
+
+#include "assetSource.h"
+
+static bool readFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data.resize(size);
+    bool ok = fread(data.data(), 1, size, f) == (size_t)size;
+    fclose(f);
+    return ok;
+}
+
+static bool writeFile(const char *path, const std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "cannot create %s\n", path);
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+struct Asset
+{
+    std::string name; // file name without folder and extension
+    AssetHeader header;
+    std::vector<uint8_t> frames;
+};
+
+// reads an asset, headerless dumps are taken as 48x48 frames
+static bool loadAsset(const char *path, Asset &asset)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data))
+    {
+        return false;
+    }
+
+    std::string name = path;
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos)
+    {
+        name = name.substr(slash + 1);
+    }
+    size_t dot = name.rfind('.');
+    asset.name = dot == std::string::npos ? name : name.substr(0, dot);
+    if (asset.name.size() >= packNameMax)
+    {
+        fprintf(stderr, "%s: name longer than %u characters\n", path, packNameMax - 1);
+        return false;
+    }
+
+    size_t offset = 0;
+    if (assetParseHeader(data.data(), data.size(), asset.header))
+    {
+        offset = assetHeaderSize;
+    }
+    else if (assetHasMagic(data.data(), data.size()))
+    {
+        fprintf(stderr, "%s: unsupported asset header\n", path);
+        return false;
+    }
+    else
+    {
+        asset.header = assetLegacyHeader(48, 48, data.size());
+    }
+
+    uint64_t bytes = (uint64_t)asset.header.frameCount * assetFrameBytes(asset.header);
+    if (asset.header.frameCount == 0 || offset + bytes > data.size())
+    {
+        fprintf(stderr, "%s: truncated or empty\n", path);
+        return false;
+    }
+    asset.frames.assign(data.begin() + offset, data.begin() + offset + bytes);
+    return true;
+}
+
+// prepends the asset header to a raw dump
+static int cmdWrap(int argc, char **argv)
+{
+    if (argc != 2 && argc != 4)
+    {
+        fprintf(stderr, "usage: assetpack wrap <in.bin> <out.bin> [width height]\n");
+        return 2;
+    }
+    uint16_t width = argc == 4 ? (uint16_t)atoi(argv[2]) : 48;
+    uint16_t height = argc == 4 ? (uint16_t)atoi(argv[3]) : 48;
+
+    std::vector<uint8_t> raw;
+    if (!readFile(argv[0], raw))
+    {
+        return 1;
+    }
+    if (assetHasMagic(raw.data(), raw.size()))
+    {
+        fprintf(stderr, "%s already has an asset header\n", argv[0]);
+        return 1;
+    }
+
+    AssetHeader header = assetLegacyHeader(width, height, raw.size());
+    if (header.frameCount * assetFrameBytes(header) != raw.size())
+    {
+        fprintf(stderr, "%s: %zu bytes is not a whole number of %ux%u frames\n", argv[0], raw.size(), width, height);
+        return 1;
+    }
+
+    std::vector<uint8_t> out(assetHeaderSize);
+    assetWriteHeader(header, out.data());
+    out.insert(out.end(), raw.begin(), raw.end());
+    return writeFile(argv[1], out) ? 0 : 1;
+}
+
+static int cmdInfo(int argc, char **argv)
+{
+    int status = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        std::vector<uint8_t> data;
+        AssetHeader header;
+        if (!readFile(argv[i], data))
+        {
+            status = 1;
+            continue;
+        }
+        if (!assetParseHeader(data.data(), data.size(), header))
+        {
+            printf("%s: headerless, %zu bytes (%zu 48x48 frames)\n", argv[i], data.size(), data.size() / 288);
+            continue;
+        }
+        printf("%s: %ux%u stride %u, %u frames, encoding %u\n", argv[i], header.width, header.height, header.stride,
+               header.frameCount, header.encoding);
+    }
+    return status;
+}
+
+// replays every animation of the pack twice, 30 frames each like the playlist, through the shared cache
+static void simulateCache(const FramePackDir &pack, uint8_t slots, uint32_t slotBytes)
+{
+    FrameCache cache;
+    if (!frameCacheBegin(cache, slots, slotBytes))
+    {
+        fprintf(stderr, "cache simulation: not enough memory for %u slots\n", slots);
+        return;
+    }
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (uint16_t a = 0; a < pack.animCount; a++)
+        {
+            PackEntry entry;
+            packEntry(pack, a, entry);
+            for (uint32_t f = 0; f < 30; f++)
+            {
+                bool hit;
+                frameCacheGet(cache, packFrameId(pack, entry, f % entry.header.frameCount), hit);
+            }
+        }
+    }
+    printf("  cache %2u slots: %5.1f%% hits (%u reads from the card)\n", slots,
+           100.0 * cache.hits / (cache.hits + cache.misses), cache.misses);
+    frameCacheEnd(cache);
+}
+
+struct PackSummary
+{
+    uint64_t totalFrames;
+    uint64_t rawBytes;
+    size_t uniqueFrames;
+    uint64_t directory; // header, entries, id tables and offset table
+    uint32_t slotBytes; // biggest stored frame
+};
+
+// stores every distinct frame once and gives each animation a table of frame ids
+static bool buildPack(std::vector<Asset> &assets, bool sparse, std::vector<uint8_t> &out, PackSummary &summary)
+{
+    if (assets.size() > 0xFFFF)
+    {
+        fprintf(stderr, "too many animations\n");
+        return false;
+    }
+
+    // content address: geometry and bytes of the frame
+    std::map<std::string, uint16_t> uniqueIds;
+    std::vector<std::vector<uint8_t>> uniqueFrames;
+    std::vector<std::vector<uint16_t>> idTables(assets.size());
+    summary = {0, 0, 0, 0, 1};
+
+    for (size_t a = 0; a < assets.size(); a++)
+    {
+        AssetHeader &header = assets[a].header;
+        uint32_t frameBytes = assetFrameBytes(header);
+        header.encoding = sparse ? ASSET_SPARSE : ASSET_RAW;
+        summary.slotBytes = assetMaxFrameBytes(header) > summary.slotBytes ? assetMaxFrameBytes(header) : summary.slotBytes;
+        for (uint32_t f = 0; f < header.frameCount; f++)
+        {
+            const uint8_t *frame = &assets[a].frames[(size_t)f * frameBytes];
+            std::string key((const char *)&header.width, 2);
+            key.append((const char *)&header.height, 2);
+            key.append((const char *)&header.stride, 2);
+            key.append((const char *)frame, frameBytes);
+
+            auto found = uniqueIds.find(key);
+            if (found == uniqueIds.end())
+            {
+                if (uniqueFrames.size() == 0x10000)
+                {
+                    fprintf(stderr, "more than 65536 distinct frames\n");
+                    return false;
+                }
+                found = uniqueIds.emplace(key, (uint16_t)uniqueFrames.size()).first;
+                std::vector<uint8_t> stored(frame, frame + frameBytes);
+                if (sparse)
+                {
+                    stored.resize(assetMaxFrameBytes(header));
+                    stored.resize(assetSparseEncode(header, frame, stored.data()));
+                }
+                uniqueFrames.push_back(stored);
+            }
+            idTables[a].push_back(found->second);
+        }
+        summary.totalFrames += header.frameCount;
+        summary.rawBytes += assets[a].frames.size();
+    }
+
+    // directory first, then the frames
+    uint32_t pos = packHeaderSize + assets.size() * packEntrySize;
+    std::vector<uint32_t> tableOffsets;
+    for (const auto &table : idTables)
+    {
+        tableOffsets.push_back(pos);
+        pos += table.size() * 2;
+    }
+    uint32_t offsetTable = pos;
+    pos += uniqueFrames.size() * 4;
+
+    out.assign(pos, 0);
+    memcpy(out.data(), packMagic, 4);
+    out[4] = packVersion;
+    packWrite16(&out[6], assets.size());
+    packWrite32(&out[8], uniqueFrames.size());
+    packWrite32(&out[12], offsetTable);
+
+    for (size_t a = 0; a < assets.size(); a++)
+    {
+        uint8_t *p = &out[packHeaderSize + a * packEntrySize];
+        const AssetHeader &header = assets[a].header;
+        memcpy(p, assets[a].name.c_str(), assets[a].name.size());
+        packWrite16(p + 32, header.width);
+        packWrite16(p + 34, header.height);
+        packWrite16(p + 36, header.stride);
+        p[38] = header.encoding;
+        packWrite32(p + 40, header.frameCount);
+        packWrite32(p + 44, tableOffsets[a]);
+        for (size_t f = 0; f < idTables[a].size(); f++)
+        {
+            packWrite16(&out[tableOffsets[a] + f * 2], idTables[a][f]);
+        }
+    }
+    for (size_t u = 0; u < uniqueFrames.size(); u++)
+    {
+        packWrite32(&out[offsetTable + u * 4], out.size());
+        out.insert(out.end(), uniqueFrames[u].begin(), uniqueFrames[u].end());
+    }
+    summary.uniqueFrames = uniqueFrames.size();
+    summary.directory = offsetTable + uniqueFrames.size() * 4;
+    return true;
+}
+
+static int cmdPack(int argc, char **argv)
+{
+    bool sparse = argc > 0 && strcmp(argv[0], "--sparse") == 0;
+    if (sparse)
+    {
+        argc--;
+        argv++;
+    }
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: assetpack pack [--sparse] <out.pak> <file.bin>...\n");
+        return 2;
+    }
+
+    std::vector<Asset> assets(argc - 1);
+    for (int i = 1; i < argc; i++)
+    {
+        if (!loadAsset(argv[i], assets[i - 1]))
+        {
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> out;
+    PackSummary summary;
+    if (!buildPack(assets, sparse, out, summary) || !writeFile(argv[0], out))
+    {
+        return 1;
+    }
+
+    printf("%zu animations, %llu frames, %zu unique (%.1f%%)\n", assets.size(), (unsigned long long)summary.totalFrames,
+           summary.uniqueFrames, 100.0 * summary.uniqueFrames / summary.totalFrames);
+    printf("raw %llu bytes, pack %zu bytes (%llu directory), saved %lld bytes (%.1f%%)\n",
+           (unsigned long long)summary.rawBytes, out.size(), (unsigned long long)summary.directory,
+           (long long)summary.rawBytes - (long long)out.size(),
+           100.0 * ((double)summary.rawBytes - out.size()) / summary.rawBytes);
+
+    FramePackDir pack;
+    if (!packParseDir(out.data(), out.size(), pack))
+    {
+        fprintf(stderr, "internal error: written pack does not parse\n");
+        return 1;
+    }
+    simulateCache(pack, 8, summary.slotBytes);
+    simulateCache(pack, 32, summary.slotBytes);
+    return 0;
+}
+
+// average lit box per frame and what the box-limited blit and flush save, as played under the caption
+static int cmdBoxes(int argc, char **argv)
+{
+    static const int16_t originX = 0;
+    static const int16_t originY = 15;
+    double sumArea = 0, sumFrameArea = 0, sumFlush = 0, sumRawFlush = 0;
+    uint64_t frames = 0;
+
+    printf("%-28s %10s %10s %12s %12s\n", "asset", "frame px", "avg box px", "flush bytes", "raw flush");
+    for (int i = 0; i < argc; i++)
+    {
+        Asset asset;
+        if (!loadAsset(argv[i], asset))
+        {
+            return 1;
+        }
+        const AssetHeader &header = asset.header;
+        uint32_t frameBytes = assetFrameBytes(header);
+        std::vector<uint8_t> encoded(assetMaxFrameBytes(header) + assetBoxSize);
+        FrameRect full = {originX, originY, (int16_t)(originX + header.width), (int16_t)(originY + header.height)};
+        FrameRect previous = frameRectEmpty;
+        double area = 0, flush = 0;
+
+        // twice round the loop so the first frame is measured after the last one, like the playlist
+        for (uint32_t n = 0; n < header.frameCount * 2; n++)
+        {
+            uint32_t f = n % header.frameCount;
+            AssetHeader sparseHeader = header;
+            sparseHeader.encoding = ASSET_SPARSE;
+            assetSparseEncode(sparseHeader, &asset.frames[(size_t)f * frameBytes], encoded.data());
+            AssetBox box;
+            assetReadBox(encoded.data(), box);
+            FrameRect rect = {(int16_t)(originX + box.x), (int16_t)(originY + box.y),
+                              (int16_t)(originX + box.x + box.width), (int16_t)(originY + box.y + box.height)};
+            if (n >= header.frameCount)
+            {
+                area += (double)box.width * box.height;
+                flush += frameRectFlushBytes(frameRectUnion(previous, rect));
+            }
+            previous = rect;
+        }
+
+        double frameArea = (double)header.width * header.height;
+        area /= header.frameCount;
+        flush /= header.frameCount;
+        printf("%-28s %10.0f %10.0f %12.0f %12u\n", asset.name.c_str(), frameArea, area, flush, frameRectFlushBytes(full));
+
+        sumArea += area * header.frameCount;
+        sumFrameArea += frameArea * header.frameCount;
+        sumFlush += flush * header.frameCount;
+        sumRawFlush += (double)frameRectFlushBytes(full) * header.frameCount;
+        frames += header.frameCount;
+    }
+    if (frames == 0)
+    {
+        return 0;
+    }
+
+    printf("average box %.0f of %.0f px (%.1f%% of the blit work)\n", sumArea / frames, sumFrameArea / frames,
+           100.0 * sumArea / sumFrameArea);
+    printf("average flush %.0f bytes, %.0f for the whole frame box, 1024 for display.display() (%.1f%% saved)\n",
+           sumFlush / frames, sumRawFlush / frames, 100.0 * (1.0 - sumFlush / frames / 1024.0));
+    return 0;
+}
+
+// builds a complete delta encoded file: header, codec info, seek table, coded frames
+static bool encodeDelta(const Asset &asset, uint16_t key, std::vector<uint8_t> &out)
+{
+    AssetHeader header = asset.header;
+    header.encoding = ASSET_DELTA;
+    uint32_t frameBytes = assetFrameBytes(header);
+    uint32_t keyCount = (header.frameCount + key - 1) / key;
+
+    out.assign(assetHeaderSize + deltaInfoSize + keyCount * 4, 0);
+    assetWriteHeader(header, out.data());
+    packWrite16(&out[assetHeaderSize], key);
+    packWrite32(&out[assetHeaderSize + 4], keyCount);
+
+    std::vector<uint8_t> coded(deltaMaxCodedBytes(frameBytes));
+    for (uint32_t f = 0; f < header.frameCount; f++)
+    {
+        const uint8_t *cur = &asset.frames[(size_t)f * frameBytes];
+        const uint8_t *prev = f % key == 0 ? nullptr : cur - frameBytes;
+        if (f % key == 0)
+        {
+            packWrite32(&out[assetHeaderSize + deltaInfoSize + (f / key) * 4], out.size());
+        }
+        uint32_t len = deltaEncode(prev, cur, frameBytes, coded.data());
+        if (len - 2 > 0xFFFF)
+        {
+            fprintf(stderr, "%s: frame %u too large for the delta codec\n", asset.name.c_str(), f);
+            return false;
+        }
+        out.insert(out.end(), coded.begin(), coded.begin() + len);
+    }
+    return true;
+}
+
+struct MemoryFile
+{
+    const std::vector<uint8_t> *data;
+};
+
+static const uint8_t *memoryFetch(void *ctx, uint32_t offset, uint32_t len)
+{
+    const std::vector<uint8_t> &data = *((MemoryFile *)ctx)->data;
+    return (uint64_t)offset + len <= data.size() ? data.data() + offset : nullptr;
+}
+
+static int cmdDelta(int argc, char **argv)
+{
+    uint16_t key = 8;
+    if (argc >= 2 && strcmp(argv[0], "--key") == 0)
+    {
+        key = (uint16_t)atoi(argv[1]);
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc != 2 || key == 0)
+    {
+        fprintf(stderr, "usage: assetpack delta [--key K] <in.bin> <out.bin>\n");
+        return 2;
+    }
+
+    Asset asset;
+    std::vector<uint8_t> out;
+    if (!loadAsset(argv[0], asset) || !encodeDelta(asset, key, out))
+    {
+        return 1;
+    }
+    printf("%s: %zu -> %zu bytes, keyframe every %u frames\n", asset.name.c_str(), asset.frames.size(), out.size(), key);
+    return writeFile(argv[1], out) ? 0 : 1;
+}
+
+// size, sequential decode throughput and random access latency for several keyframe intervals
+static int cmdBenchDelta(int argc, char **argv)
+{
+    std::vector<Asset> assets(argc);
+    uint64_t rawBytes = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        if (!loadAsset(argv[i], assets[i]))
+        {
+            return 1;
+        }
+        rawBytes += assets[i].frames.size();
+    }
+    if (assets.empty())
+    {
+        fprintf(stderr, "usage: assetpack bench-delta <file.bin>...\n");
+        return 2;
+    }
+
+    static const uint16_t keys[] = {1, 2, 4, 8, 16, 32};
+    printf("raw %llu bytes\n", (unsigned long long)rawBytes);
+    printf("%4s %10s %7s %14s %14s %12s\n", "K", "bytes", "ratio", "seq frames/s", "seq MB/s", "random ns");
+
+    for (uint16_t key : keys)
+    {
+        std::vector<std::vector<uint8_t>> files(assets.size());
+        uint64_t codedBytes = 0;
+        for (size_t a = 0; a < assets.size(); a++)
+        {
+            if (!encodeDelta(assets[a], key, files[a]))
+            {
+                return 1;
+            }
+            codedBytes += files[a].size();
+        }
+
+        using clock = std::chrono::steady_clock;
+        uint64_t seqFrames = 0, seqBytes = 0, randomFrames = 0;
+        double seqSeconds = 0, randomSeconds = 0;
+        std::mt19937 rng(1234);
+        uint32_t sink = 0;
+
+        for (size_t a = 0; a < assets.size(); a++)
+        {
+            const AssetHeader &header = assets[a].header;
+            uint32_t frameBytes = assetFrameBytes(header);
+            DeltaInfo info;
+            deltaParseInfo(header, &files[a][assetHeaderSize], deltaInfoSize, info);
+            std::vector<uint8_t> frame(frameBytes);
+            DeltaCursor cursor = {frame.data(), frameBytes, deltaNoFrame, 0};
+            MemoryFile file = {&files[a]};
+
+            auto start = clock::now();
+            for (int round = 0; round < 50; round++)
+            {
+                for (uint32_t f = 0; f < header.frameCount; f++)
+                {
+                    deltaSeek(header, info, cursor, f, memoryFetch, &file);
+                    sink += frame[f % frameBytes];
+                }
+            }
+            seqSeconds += std::chrono::duration<double>(clock::now() - start).count();
+            seqFrames += 50 * header.frameCount;
+            seqBytes += 50ull * header.frameCount * frameBytes;
+
+            std::vector<uint32_t> targets(2000);
+            for (auto &t : targets)
+            {
+                t = rng() % header.frameCount;
+            }
+            start = clock::now();
+            for (uint32_t t : targets)
+            {
+                deltaSeek(header, info, cursor, t, memoryFetch, &file);
+                sink += frame[t % frameBytes];
+            }
+            randomSeconds += std::chrono::duration<double>(clock::now() - start).count();
+            randomFrames += targets.size();
+
+            // the decoded frames must match the source
+            for (uint32_t f = 0; f < header.frameCount; f++)
+            {
+                deltaSeek(header, info, cursor, (f * 7) % header.frameCount, memoryFetch, &file);
+                if (memcmp(frame.data(), &assets[a].frames[(size_t)((f * 7) % header.frameCount) * frameBytes], frameBytes) != 0)
+                {
+                    fprintf(stderr, "%s: frame %u decodes wrong with K=%u\n", assets[a].name.c_str(), (f * 7) % header.frameCount, key);
+                    return 1;
+                }
+            }
+        }
+
+        printf("%4u %10llu %6.1f%% %14.0f %14.1f %12.0f\n", key, (unsigned long long)codedBytes,
+               100.0 * codedBytes / rawBytes, seqFrames / seqSeconds, seqBytes / seqSeconds / 1e6,
+               randomSeconds / randomFrames * 1e9);
+        if (sink == 0xFFFFFFFF)
+        {
+            printf("\n");
+        }
+    }
+    return 0;
+}
+
+// cuts every frame into 8x8 tiles, each distinct tile is stored once in the dictionary
+static bool encodeTiles(const Asset &asset, std::vector<uint8_t> &out)
+{
+    AssetHeader header = asset.header;
+    header.encoding = ASSET_TILES;
+    uint32_t frameBytes = assetFrameBytes(asset.header);
+    uint8_t cols = (header.width + 7) / 8;
+    uint8_t rows = (header.height + 7) / 8;
+    if (header.width > 255 * 8 || header.height > 255 * 8)
+    {
+        fprintf(stderr, "%s: too large for a tile grid\n", asset.name.c_str());
+        return false;
+    }
+
+    std::map<uint64_t, uint16_t> ids;
+    std::vector<uint8_t> dict;
+    std::vector<uint16_t> grid;
+    for (uint32_t f = 0; f < header.frameCount; f++)
+    {
+        for (uint8_t row = 0; row < rows; row++)
+        {
+            for (uint8_t col = 0; col < cols; col++)
+            {
+                uint8_t tile[tileBytes];
+                uint64_t key;
+                tileFromRows(header, &asset.frames[(size_t)f * frameBytes], col, row, tile);
+                memcpy(&key, tile, sizeof(key));
+                auto found = ids.find(key);
+                if (found == ids.end())
+                {
+                    if (ids.size() == 0x10000)
+                    {
+                        fprintf(stderr, "%s: more than 65536 distinct tiles\n", asset.name.c_str());
+                        return false;
+                    }
+                    found = ids.emplace(key, (uint16_t)ids.size()).first;
+                    dict.insert(dict.end(), tile, tile + tileBytes);
+                }
+                grid.push_back(found->second);
+            }
+        }
+    }
+
+    TileInfo info;
+    info.tileCount = ids.size();
+    info.indexBytes = ids.size() <= 256 ? 1 : 2;
+    info.cols = cols;
+    info.rows = rows;
+
+    out.assign(assetHeaderSize + tileInfoSize, 0);
+    assetWriteHeader(header, out.data());
+    tileWriteInfo(info, &out[assetHeaderSize]);
+    out.insert(out.end(), dict.begin(), dict.end());
+    for (uint16_t id : grid)
+    {
+        out.push_back(id & 0xFF);
+        if (info.indexBytes == 2)
+        {
+            out.push_back(id >> 8);
+        }
+    }
+    return true;
+}
+
+// what display.drawBitmap(x, y, frame, w, h, 1) does to the 128x64 page buffer, pixel by pixel
+static void referenceBlit(const AssetHeader &header, const uint8_t *frame, uint8_t *buffer, int16_t x, int16_t y)
+{
+    for (uint16_t row = 0; row < header.height; row++)
+    {
+        for (uint16_t col = 0; col < header.width; col++)
+        {
+            int16_t px = x + col, py = y + row;
+            if (px >= 0 && px < 128 && py >= 0 && py < 64 && (frame[row * header.stride + col / 8] & (0x80 >> (col & 7))))
+            {
+                buffer[(py / 8) * 128 + px] |= 1 << (py & 7);
+            }
+        }
+    }
+}
+
+static int cmdTiles(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: assetpack tiles <in.bin> <out.bin>\n");
+        return 2;
+    }
+
+    Asset asset;
+    std::vector<uint8_t> out;
+    if (!loadAsset(argv[0], asset) || !encodeTiles(asset, out))
+    {
+        return 1;
+    }
+    TileInfo info;
+    tileParseInfo(asset.header, &out[assetHeaderSize], tileInfoSize, info);
+    printf("%s: %zu -> %zu bytes, %u tiles\n", asset.name.c_str(), asset.frames.size(), out.size(), info.tileCount);
+    return writeFile(argv[1], out) ? 0 : 1;
+}
+
+// dictionary sizes, compression and decode speed into the page buffer against the per pixel blit
+static int cmdBenchTiles(int argc, char **argv)
+{
+    std::vector<Asset> assets(argc);
+    std::vector<std::vector<uint8_t>> files(argc);
+    std::map<uint64_t, uint32_t> shared;
+    uint64_t rawBytes = 0, tiledBytes = 0, dictBytes = 0, gridBytes = 0;
+
+    for (int i = 0; i < argc; i++)
+    {
+        if (!loadAsset(argv[i], assets[i]) || !encodeTiles(assets[i], files[i]))
+        {
+            return 1;
+        }
+        TileInfo info;
+        tileParseInfo(assets[i].header, &files[i][assetHeaderSize], tileInfoSize, info);
+        for (uint32_t t = 0; t < info.tileCount; t++)
+        {
+            uint64_t key;
+            memcpy(&key, &files[i][info.dictOffset + t * tileBytes], sizeof(key));
+            shared[key]++;
+        }
+        rawBytes += assets[i].frames.size();
+        tiledBytes += files[i].size();
+        dictBytes += (uint64_t)info.tileCount * tileBytes;
+        gridBytes += (uint64_t)info.frameBytes * assets[i].header.frameCount;
+    }
+    if (assets.empty())
+    {
+        fprintf(stderr, "usage: assetpack bench-tiles <file.bin>...\n");
+        return 2;
+    }
+
+    printf("raw %llu bytes, tiled %llu bytes (%.1f%%): dictionaries %llu, index grids %llu\n",
+           (unsigned long long)rawBytes, (unsigned long long)tiledBytes, 100.0 * tiledBytes / rawBytes,
+           (unsigned long long)dictBytes, (unsigned long long)gridBytes);
+    printf("%zu distinct tiles over all files, %llu bytes as one shared dictionary\n", shared.size(),
+           (unsigned long long)shared.size() * tileBytes);
+
+    using clock = std::chrono::steady_clock;
+    struct Path
+    {
+        const char *name;
+        int16_t y;
+        bool tiled;
+    };
+    static const Path paths[] = {{"per pixel blit, y=15", 15, false},
+                                 {"tiles, y=15 (shifted)", 15, true},
+                                 {"tiles, y=16 (page aligned)", 16, true}};
+    uint8_t buffer[1024], expected[1024];
+    uint32_t sink = 0;
+
+    for (const Path &path : paths)
+    {
+        uint64_t frames = 0;
+        double seconds = 0;
+        for (size_t a = 0; a < assets.size(); a++)
+        {
+            const AssetHeader &header = assets[a].header;
+            uint32_t frameBytes = assetFrameBytes(header);
+            TileInfo info;
+            tileParseInfo(header, &files[a][assetHeaderSize], tileInfoSize, info);
+            const uint8_t *dict = &files[a][info.dictOffset];
+            const uint8_t *grids = &files[a][info.framesOffset];
+
+            auto start = clock::now();
+            for (int round = 0; round < 20; round++)
+            {
+                for (uint32_t f = 0; f < header.frameCount; f++)
+                {
+                    memset(buffer, 0, sizeof(buffer));
+                    if (path.tiled)
+                    {
+                        tileBlit(info, dict, grids + f * info.frameBytes, buffer, 128, 64, 0, path.y);
+                    }
+                    else
+                    {
+                        referenceBlit(header, &assets[a].frames[(size_t)f * frameBytes], buffer, 0, path.y);
+                    }
+                    sink += buffer[(f * 37) & 1023];
+                }
+            }
+            seconds += std::chrono::duration<double>(clock::now() - start).count();
+            frames += 20 * header.frameCount;
+
+            // every tiled frame must match the per pixel blit bit for bit
+            for (uint32_t f = 0; f < header.frameCount && path.tiled; f++)
+            {
+                memset(buffer, 0, sizeof(buffer));
+                memset(expected, 0, sizeof(expected));
+                tileBlit(info, dict, grids + f * info.frameBytes, buffer, 128, 64, 0, path.y);
+                referenceBlit(header, &assets[a].frames[(size_t)f * frameBytes], expected, 0, path.y);
+                if (memcmp(buffer, expected, sizeof(buffer)) != 0)
+                {
+                    fprintf(stderr, "%s: frame %u decodes wrong at y=%d\n", assets[a].name.c_str(), f, path.y);
+                    return 1;
+                }
+            }
+        }
+        printf("%-28s %12.0f frames/s %8.0f ns/frame\n", path.name, frames / seconds, seconds / frames * 1e9);
+    }
+    if (sink == 0xFFFFFFFF)
+    {
+        printf("\n");
+    }
+    return 0;
+}
+
+// binary PGM (P5), the frames stacked top to bottom: levels scaled to 0 .. levels - 1, row after row
+static bool readPgm(const char *path, uint32_t frames, uint16_t levels, uint16_t &width, uint16_t &height,
+                    std::vector<uint8_t> &pixels)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data))
+    {
+        return false;
+    }
+    size_t p = 0;
+    auto number = [&]()
+    {
+        while (p < data.size() && (isspace(data[p]) || data[p] == '#'))
+        {
+            if (data[p] == '#')
+            {
+                while (p < data.size() && data[p] != '\n')
+                {
+                    p++;
+                }
+            }
+            else
+            {
+                p++;
+            }
+        }
+        uint32_t v = 0;
+        while (p < data.size() && isdigit(data[p]))
+        {
+            v = v * 10 + (data[p++] - '0');
+        }
+        return v;
+    };
+    if (data.size() < 2 || data[0] != 'P' || data[1] != '5')
+    {
+        fprintf(stderr, "%s is not a binary PGM (P5)\n", path);
+        return false;
+    }
+    p = 2;
+    uint32_t w = number();
+    uint32_t h = number();
+    uint32_t maxval = number();
+    p++; // the single white space before the pixels
+    if (w == 0 || w > 0xFFFF || h == 0 || h % frames || h / frames > 0xFFFF || maxval == 0 || maxval > 255 ||
+        p + (size_t)w * h > data.size())
+    {
+        fprintf(stderr, "%s: bad size, %u frames of %ux%u, or truncated\n", path, frames, w, h / frames);
+        return false;
+    }
+    width = w;
+    height = h / frames;
+    pixels.resize((size_t)w * h);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        pixels[i] = (data[p + i] * (levels - 1) + maxval / 2) / maxval;
+    }
+    return true;
+}
+
+// --frames N, the number of frames stacked in the PGM
+static bool pgmFrames(int &argc, char **&argv, uint32_t &frames)
+{
+    frames = 1;
+    if (argc >= 2 && strcmp(argv[0], "--frames") == 0)
+    {
+        frames = atoi(argv[1]);
+        argc -= 2;
+        argv += 2;
+    }
+    return frames > 0;
+}
+
+// PGM strip quantized to the 16 levels of ASSET_GRAY4
+static int cmdGray(int argc, char **argv)
+{
+    uint32_t frames;
+    if (!pgmFrames(argc, argv, frames) || argc != 2)
+    {
+        fprintf(stderr, "usage: assetpack gray [--frames N] <in.pgm> <out.bin>\n");
+        return 2;
+    }
+    uint16_t width, height;
+    std::vector<uint8_t> levels;
+    if (!readPgm(argv[0], frames, 16, width, height, levels))
+    {
+        return 1;
+    }
+
+    AssetHeader header = {assetVersion, ASSET_GRAY4, width, height, assetGrayStride(width), frames};
+    std::vector<uint8_t> out(assetHeaderSize + (size_t)header.stride * height * frames, 0);
+    assetWriteHeader(header, out.data());
+    for (uint32_t y = 0; y < (uint32_t)height * frames; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint8_t level = levels[y * width + x];
+            out[assetHeaderSize + y * header.stride + x / 2] |= x & 1 ? level : level << 4;
+        }
+    }
+    printf("%s: %u frames of %ux%u, %zu bytes\n", argv[0], frames, width, height, out.size() - assetHeaderSize);
+    return writeFile(argv[1], out) ? 0 : 1;
+}
+
+// PGM strip quantized to 4 or 8 levels, split into the raw bit-planes of ASSET_PLANES2 or 3
+static int cmdPlanes(int argc, char **argv)
+{
+    uint8_t planes = 2;
+    if (argc >= 2 && strcmp(argv[0], "--planes") == 0)
+    {
+        planes = atoi(argv[1]);
+        argc -= 2;
+        argv += 2;
+    }
+    uint32_t frames;
+    if (!pgmFrames(argc, argv, frames) || argc != 2 || planes < 2 || planes > 3)
+    {
+        fprintf(stderr, "usage: assetpack planes [--planes 2|3] [--frames N] <in.pgm> <out.bin>\n");
+        return 2;
+    }
+    uint16_t width, height;
+    std::vector<uint8_t> levels;
+    if (!readPgm(argv[0], frames, 1 << planes, width, height, levels))
+    {
+        return 1;
+    }
+
+    AssetHeader header = {assetVersion, planes == 2 ? ASSET_PLANES2 : ASSET_PLANES3, width, height,
+                          assetMinStride(width), frames * planes};
+    uint32_t planeBytes = assetFrameBytes(header);
+    std::vector<uint8_t> out(assetHeaderSize + (size_t)planeBytes * header.frameCount, 0);
+    assetWriteHeader(header, out.data());
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        for (uint8_t p = 0; p < planes; p++)
+        {
+            uint8_t *plane = &out[assetHeaderSize + (size_t)(f * planes + p) * planeBytes];
+            for (uint32_t y = 0; y < height; y++)
+            {
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    if (levels[((size_t)f * height + y) * width + x] >> p & 1)
+                    {
+                        plane[y * header.stride + x / 8] |= 0x80 >> (x & 7);
+                    }
+                }
+            }
+        }
+    }
+    printf("%s: %u frames of %ux%u, %u planes, %zu bytes\n", argv[0], frames, width, height, planes,
+           out.size() - assetHeaderSize);
+    return writeFile(argv[1], out) ? 0 : 1;
+}
+
+// SSD1306 page layout: 8 rows per byte with the top row in bit 0, pages of width bytes, the panel RAM order
+static void pageMajor(const Asset &asset, std::vector<uint8_t> &out)
+{
+    const AssetHeader &header = asset.header;
+    uint32_t frameBytes = assetFrameBytes(header);
+    uint16_t pages = (header.height + 7) / 8;
+    out.assign((size_t)header.frameCount * pages * header.width, 0);
+    for (uint32_t f = 0; f < header.frameCount; f++)
+    {
+        const uint8_t *frame = &asset.frames[(size_t)f * frameBytes];
+        uint8_t *dst = &out[(size_t)f * pages * header.width];
+        for (uint16_t y = 0; y < header.height; y++)
+        {
+            for (uint16_t x = 0; x < header.width; x++)
+            {
+                if (frame[y * header.stride + x / 8] & (0x80 >> (x & 7)))
+                {
+                    dst[(y / 8) * header.width + x] |= 1 << (y & 7);
+                }
+            }
+        }
+    }
+}
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < len; i++)
+    {
+        h = (h ^ p[i]) * 0x100000001B3ull;
+    }
+    return h;
+}
+
+enum CompileOutput : uint8_t
+{
+    COMPILE_RAW = 1,   // <name>.bin, headerless dump like the files folder
+    COMPILE_PAGE = 2,  // <name>.page, headerless, page major
+    COMPILE_DELTA = 4, // <name>.delta, delta encoded asset
+    COMPILE_TILES = 8, // <name>.tiles, tile encoded asset
+    COMPILE_PACK = 16, // anims.pak, every animation in one pack
+};
+
+static const struct
+{
+    const char *name;
+    uint8_t bit;
+    const char *suffix;
+} compileOutputs[] = {
+    {"raw", COMPILE_RAW, ".bin"},
+    {"page", COMPILE_PAGE, ".page"},
+    {"delta", COMPILE_DELTA, ".delta"},
+    {"tiles", COMPILE_TILES, ".tiles"},
+    {"pack", COMPILE_PACK, nullptr},
+};
+
+// bump when an output format changes, every asset is rebuilt then
+static const uint32_t compileVersion = 1;
+static const char *compileStampName = "assetpack.stamp";
+static const char *compilePackName = "anims.pak";
+
+struct CompileJob
+{
+    Asset asset;
+    std::string origin;
+    uint64_t hash;     // of the frames, the geometry and the outputs asked for
+    bool upToDate;
+    bool failed;
+    std::string log;   // printed in order once every job is done
+};
+
+// frames of every source: .h PROGMEM arrays, .gif and .pbm sequences (named after the file)
+static bool compileRead(const char *path, uint16_t width, uint16_t height, bool invert, std::vector<SourceAsset> &out)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data))
+    {
+        return false;
+    }
+    std::string file = path;
+    size_t slash = file.find_last_of("/\\");
+    std::string base = slash == std::string::npos ? file : file.substr(slash + 1);
+    size_t dot = base.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : base.substr(dot);
+    for (char &c : ext)
+    {
+        c = tolower(c);
+    }
+
+    std::string error;
+    bool ok;
+    if (ext == ".h")
+    {
+        ok = sourceParseProgmem(std::string(data.begin(), data.end()), file, width, height, out, error);
+    }
+    else if (ext == ".gif" || ext == ".pbm")
+    {
+        SourceAsset asset;
+        asset.name = base.substr(0, dot);
+        asset.origin = file;
+        ok = ext == ".gif" ? sourceParseGif(data, invert, asset, error) : sourceParsePbm(data, asset, error);
+        if (ok)
+        {
+            out.push_back(asset);
+        }
+    }
+    else
+    {
+        error = file + ": unknown source type, expected .h, .gif or .pbm";
+        ok = false;
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "%s\n", error.c_str());
+    }
+    return ok;
+}
+
+// encodes the outputs of one asset, compares it with the reference dump
+static void compileAsset(CompileJob &job, const std::string &outDir, uint8_t outputs, const char *checkDir)
+{
+    char line[256];
+    if (checkDir)
+    {
+        std::string refPath = std::string(checkDir) + "/" + job.asset.name + ".bin";
+        Asset ref;
+        if (FILE *f = fopen(refPath.c_str(), "rb"))
+        {
+            fclose(f);
+            if (!loadAsset(refPath.c_str(), ref))
+            {
+                job.failed = true;
+            }
+            else if (ref.header.width != job.asset.header.width || ref.header.height != job.asset.header.height ||
+                     ref.frames != job.asset.frames)
+            {
+                size_t at = 0;
+                while (at < ref.frames.size() && at < job.asset.frames.size() && ref.frames[at] == job.asset.frames[at])
+                {
+                    at++;
+                }
+                snprintf(line, sizeof(line), "%s: differs from %s at byte %zu (frame %zu)\n", job.asset.name.c_str(),
+                         refPath.c_str(), at, at / assetFrameBytes(job.asset.header));
+                job.log += line;
+                job.failed = true;
+            }
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%s: no %s to check against\n", job.asset.name.c_str(), refPath.c_str());
+            job.log += line;
+        }
+    }
+    if (job.upToDate || job.failed)
+    {
+        return;
+    }
+
+    for (const auto &output : compileOutputs)
+    {
+        if (!(outputs & output.bit) || !output.suffix)
+        {
+            continue;
+        }
+        std::vector<uint8_t> out;
+        bool ok = true;
+        switch (output.bit)
+        {
+        case COMPILE_RAW:
+            out = job.asset.frames;
+            break;
+        case COMPILE_PAGE:
+            pageMajor(job.asset, out);
+            break;
+        case COMPILE_DELTA:
+            ok = encodeDelta(job.asset, 8, out);
+            break;
+        case COMPILE_TILES:
+            ok = encodeTiles(job.asset, out);
+            break;
+        }
+        std::string path = outDir + "/" + job.asset.name + output.suffix;
+        if (!ok || !writeFile(path.c_str(), out))
+        {
+            job.failed = true;
+            return;
+        }
+    }
+    snprintf(line, sizeof(line), "%s: %ux%u, %u frames from %s\n", job.asset.name.c_str(), job.asset.header.width,
+             job.asset.header.height, job.asset.header.frameCount, job.origin.c_str());
+    job.log += line;
+}
+
+static bool compileOutputsExist(const std::string &outDir, const std::string &name, uint8_t outputs)
+{
+    for (const auto &output : compileOutputs)
+    {
+        if ((outputs & output.bit) && output.suffix &&
+            !std::filesystem::exists(outDir + "/" + name + output.suffix))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// one pass from the sources to every output, in parallel and only for the assets whose inputs changed
+static int cmdCompile(int argc, char **argv)
+{
+    unsigned jobs = std::thread::hardware_concurrency();
+    const char *checkDir = nullptr;
+    uint8_t outputs = 0xFF;
+    uint16_t width = 0, height = 0;
+    bool invert = false, force = false;
+    while (argc > 0 && argv[0][0] == '-')
+    {
+        if (strcmp(argv[0], "--jobs") == 0 && argc > 1)
+        {
+            jobs = atoi(argv[1]);
+        }
+        else if (strcmp(argv[0], "--check") == 0 && argc > 1)
+        {
+            checkDir = argv[1];
+        }
+        else if (strcmp(argv[0], "--size") == 0 && argc > 1)
+        {
+            unsigned w, h;
+            if (sscanf(argv[1], "%ux%u", &w, &h) != 2 || w == 0 || h == 0 || w > 0xFFFF || h > 0xFFFF)
+            {
+                argc = 0;
+                break;
+            }
+            width = w;
+            height = h;
+        }
+        else if (strcmp(argv[0], "--emit") == 0 && argc > 1)
+        {
+            outputs = 0;
+            std::string list = std::string(argv[1]) + ",";
+            for (size_t start = 0, comma; (comma = list.find(',', start)) != std::string::npos; start = comma + 1)
+            {
+                std::string name = list.substr(start, comma - start);
+                uint8_t bit = 0;
+                for (const auto &output : compileOutputs)
+                {
+                    bit |= name == output.name ? output.bit : 0;
+                }
+                if (!bit)
+                {
+                    fprintf(stderr, "unknown output %s\n", name.c_str());
+                    return 2;
+                }
+                outputs |= bit;
+            }
+        }
+        else if (strcmp(argv[0], "--invert") == 0)
+        {
+            invert = true;
+            argc--;
+            argv++;
+            continue;
+        }
+        else if (strcmp(argv[0], "--force") == 0)
+        {
+            force = true;
+            argc--;
+            argv++;
+            continue;
+        }
+        else
+        {
+            argc = 0;
+            break;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: assetpack compile [--jobs N] [--emit raw,page,delta,tiles,pack] [--check DIR]\n"
+                        "                         [--size WxH] [--invert] [--force] <out-dir> <source>...\n");
+        return 2;
+    }
+    std::string outDir = argv[0];
+    std::error_code fsError;
+    std::filesystem::create_directories(outDir, fsError);
+    if (fsError)
+    {
+        fprintf(stderr, "cannot create %s\n", outDir.c_str());
+        return 1;
+    }
+
+    std::vector<SourceAsset> sources;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!compileRead(argv[i], width, height, invert, sources))
+        {
+            return 1;
+        }
+    }
+
+    // the same name twice is fine when the frames agree, the split headers repeat the main one
+    std::vector<CompileJob> work;
+    std::map<std::string, size_t> byName;
+    for (SourceAsset &source : sources)
+    {
+        auto found = byName.find(source.name);
+        if (found != byName.end())
+        {
+            const Asset &first = work[found->second].asset;
+            if (first.frames != source.frames || first.header.width != source.width)
+            {
+                fprintf(stderr, "%s: %s differs from the one of %s\n", source.origin.c_str(), source.name.c_str(),
+                        work[found->second].origin.c_str());
+                return 1;
+            }
+            continue;
+        }
+        if (source.name.size() >= packNameMax)
+        {
+            fprintf(stderr, "%s: name %s longer than %u characters\n", source.origin.c_str(), source.name.c_str(),
+                    packNameMax - 1);
+            return 1;
+        }
+        CompileJob job;
+        job.asset.name = source.name;
+        job.asset.header = assetLegacyHeader(source.width, source.height, source.frames.size());
+        job.asset.frames.swap(source.frames);
+        job.origin = source.origin;
+        job.hash = fnv1a(0xCBF29CE484222325ull, &compileVersion, sizeof(compileVersion));
+        job.hash = fnv1a(job.hash, &outputs, 1);
+        job.hash = fnv1a(job.hash, &job.asset.header, sizeof(job.asset.header));
+        job.hash = fnv1a(job.hash, job.asset.frames.data(), job.asset.frames.size());
+        job.upToDate = false;
+        job.failed = false;
+        byName[job.asset.name] = work.size();
+        work.push_back(std::move(job));
+    }
+
+    // stamp: one "<name> <hash>" line per asset built by the last run
+    std::string stampPath = outDir + "/" + compileStampName;
+    std::map<std::string, uint64_t> stamp;
+    if (FILE *f = fopen(stampPath.c_str(), "r"))
+    {
+        char name[packNameMax + 1];
+        unsigned long long hash;
+        while (fscanf(f, "%32s %llx", name, &hash) == 2)
+        {
+            stamp[name] = hash;
+        }
+        fclose(f);
+    }
+    uint64_t packHash = fnv1a(0xCBF29CE484222325ull, &compileVersion, sizeof(compileVersion));
+    for (CompileJob &job : work)
+    {
+        auto found = stamp.find(job.asset.name);
+        job.upToDate = !force && found != stamp.end() && found->second == job.hash &&
+                       compileOutputsExist(outDir, job.asset.name, outputs);
+        packHash = fnv1a(packHash, job.asset.name.c_str(), job.asset.name.size() + 1);
+        packHash = fnv1a(packHash, &job.hash, sizeof(job.hash));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextJob(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < (jobs ? jobs : 1); t++)
+    {
+        workers.emplace_back([&]()
+        {
+            for (size_t i; (i = nextJob++) < work.size();)
+            {
+                compileAsset(work[i], outDir, outputs, checkDir);
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    size_t built = 0, failed = 0;
+    for (const CompileJob &job : work)
+    {
+        fputs(job.log.c_str(), job.failed ? stderr : stdout);
+        built += !job.upToDate && !job.failed;
+        failed += job.failed;
+    }
+
+    std::string packPath = outDir + "/" + compilePackName;
+    bool packBuilt = false;
+    if ((outputs & COMPILE_PACK) && failed == 0)
+    {
+        auto found = stamp.find(compilePackName);
+        if (force || found == stamp.end() || found->second != packHash || !std::filesystem::exists(packPath))
+        {
+            std::vector<Asset> assets;
+            for (const CompileJob &job : work)
+            {
+                assets.push_back(job.asset);
+            }
+            std::vector<uint8_t> out;
+            PackSummary summary;
+            if (!buildPack(assets, false, out, summary) || !writeFile(packPath.c_str(), out))
+            {
+                failed++;
+            }
+            else
+            {
+                printf("%s: %zu animations, %zu unique frames, %zu bytes\n", compilePackName, assets.size(),
+                       summary.uniqueFrames, out.size());
+                packBuilt = true;
+            }
+        }
+    }
+
+    // a failed asset keeps its old stamp line out, so it is built again next time
+    if (FILE *f = fopen(stampPath.c_str(), "w"))
+    {
+        for (const CompileJob &job : work)
+        {
+            if (!job.failed)
+            {
+                fprintf(f, "%s %016llx\n", job.asset.name.c_str(), (unsigned long long)job.hash);
+            }
+        }
+        if ((outputs & COMPILE_PACK) && failed == 0)
+        {
+            fprintf(f, "%s %016llx\n", compilePackName, (unsigned long long)packHash);
+        }
+        fclose(f);
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%zu assets: %zu built, %zu up to date, %zu failed%s, %u jobs, %.1f ms\n", work.size(), built,
+           work.size() - built - failed, failed, packBuilt ? ", pack built" : "", jobs ? jobs : 1, ms);
+    if (checkDir)
+    {
+        printf("checked against %s: %s\n", checkDir, failed ? "MISMATCH" : "identical");
+    }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "wrap") == 0)
+    {
+        return cmdWrap(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "info") == 0)
+    {
+        return cmdInfo(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "pack") == 0)
+    {
+        return cmdPack(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "boxes") == 0)
+    {
+        return cmdBoxes(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "delta") == 0)
+    {
+        return cmdDelta(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "bench-delta") == 0)
+    {
+        return cmdBenchDelta(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "tiles") == 0)
+    {
+        return cmdTiles(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "bench-tiles") == 0)
+    {
+        return cmdBenchTiles(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "gray") == 0)
+    {
+        return cmdGray(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "planes") == 0)
+    {
+        return cmdPlanes(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "compile") == 0)
+    {
+        return cmdCompile(argc - 2, argv + 2);
+    }
+
+    fprintf(stderr, "usage: assetpack wrap <in.bin> <out.bin> [width height]\n"
+                    "       assetpack info <file.bin>...\n"
+                    "       assetpack pack [--sparse] <out.pak> <file.bin>...\n"
+                    "       assetpack boxes <file.bin>...\n"
+                    "       assetpack delta [--key K] <in.bin> <out.bin>\n"
+                    "       assetpack bench-delta <file.bin>...\n"
+                    "       assetpack tiles <in.bin> <out.bin>\n"
+                    "       assetpack bench-tiles <file.bin>...\n"
+                    "       assetpack gray [--frames N] <in.pgm> <out.bin>\n"
+                    "       assetpack planes [--planes 2|3] [--frames N] <in.pgm> <out.bin>\n"
+                    "       assetpack compile [options] <out-dir> <source.h|.gif|.pbm>...\n");
+    return 2;
+}
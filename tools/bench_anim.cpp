@@ -0,0 +1,191 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_anim.cpp
+//
+// Description:
+//
+// plays every animation of animRegistry.h through the real loader and
+// player code, compiled against the host mocks (see host/), and
+// reports per animation: load time, frames per second of the draw and
+// flush path, bytes put on the I2C bus and the heap it needed.
+//
+// The card is a scratch copy of the files folder; pass a pack built
+// by "assetpack pack" with --pack to play from /anims.pak instead.
+// At the end the simulated panel must show exactly the sketch's
+// buffer, a partial flush that misses a byte fails the run.
+//
+// Usage:   bench_anim [--files DIR] [--pack FILE] [--rounds N] [--verbose]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <chrono>
+#include <filesystem>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "hostCard.h"
+#include "hostHeap.h"
+#include "ssd1306Panel.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static SSD1306Panel panel;
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+int main(int argc, char **argv)
+{
+    const char *files = ANIM_FILES_DIR;
+    const char *pack = nullptr;
+    uint32_t rounds = 3;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--files") == 0 && i + 1 < argc)
+        {
+            files = argv[++i];
+        }
+        else if (strcmp(argv[i], "--pack") == 0 && i + 1 < argc)
+        {
+            pack = argv[++i];
+        }
+        else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc)
+        {
+            rounds = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--verbose") == 0)
+        {
+            verbose = true;
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_anim [--files DIR] [--pack FILE] [--rounds N] [--verbose]\n");
+            return 2;
+        }
+    }
+
+    if (!hostCardImage(files, "bench_anim.card"))
+    {
+        return 1;
+    }
+    if (pack)
+    {
+        std::error_code ec;
+        std::filesystem::copy_file(pack, "bench_anim.card/anims.pak", ec);
+        if (ec)
+        {
+            fprintf(stderr, "cannot copy %s\n", pack);
+            return 1;
+        }
+    }
+    hostSerialOutput(verbose ? stdout : nullptr);
+
+    panel.attach(Wire, SCREEN_I2C_ADDR);
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+    display.clearDisplay();
+
+    if (!SD.begin(5))
+    {
+        fprintf(stderr, "card mount failed\n");
+        return 1;
+    }
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+    if (pack && !framePackOpen(SD, "/anims.pak", framePack))
+    {
+        fprintf(stderr, "%s is not a usable pack\n", pack);
+        return 1;
+    }
+
+    using clock = std::chrono::steady_clock;
+    printf("%-24s %6s %9s %12s %11s %11s %10s %8s\n", "animation", "frames", "load us", "frames/s", "bus B/frame",
+           "bus us/frm", "heap peak", "leaked");
+
+    uint64_t totalFrames = 0, totalBusBytes = 0;
+    double totalSeconds = 0, totalBusMicros = 0;
+    size_t worstHeap = 0;
+    bool leaked = false;
+
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        const AnimDesc &anim = animRegistry[i];
+        size_t heapBefore = hostHeap().used;
+        hostHeapResetPeak();
+
+        auto start = clock::now();
+        AnimAsset asset;
+        if (!animOpen(anim, asset))
+        {
+            printf("%-24s not on the card\n", anim.id);
+            continue;
+        }
+        double loadMicros = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+        AnimScreen screen;
+        animBeginScreen(anim, asset.header, true, screen);
+
+        // frames only, the full screen sent once by animBeginScreen is not counted
+        WireStats bus = Wire.stats;
+        uint32_t frames = rounds * asset.header.frameCount;
+        start = clock::now();
+        for (uint32_t f = 0; f < frames; f++)
+        {
+            animDrawFrame(screen, asset, f % asset.header.frameCount);
+        }
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        uint64_t busBytes = Wire.stats.bytes - bus.bytes;
+        double busMicros = Wire.stats.busMicros - bus.busMicros;
+
+        unloadAnimation(asset);
+        size_t peak = hostHeap().peak - heapBefore;
+        long held = (long)hostHeap().used - (long)heapBefore;
+
+        printf("%-24s %6u %9.0f %12.0f %11.0f %11.0f %10zu %8ld\n", anim.id, frames, loadMicros, frames / seconds,
+               (double)busBytes / frames, busMicros / frames, peak, held);
+
+        totalFrames += frames;
+        totalSeconds += seconds;
+        totalBusBytes += busBytes;
+        totalBusMicros += busMicros;
+        worstHeap = peak > worstHeap ? peak : worstHeap;
+        leaked = leaked || held != 0;
+    }
+
+    printf("%-24s %6llu %9s %12.0f %11.0f %11.0f %10zu %8s\n", "total", (unsigned long long)totalFrames, "",
+           totalFrames / totalSeconds, (double)totalBusBytes / totalFrames, totalBusMicros / totalFrames, worstHeap,
+           leaked ? "yes" : "no");
+    printf("SD: %u opens, %u reads, %llu bytes read\n", SD.stats.opens, SD.stats.reads,
+           (unsigned long long)SD.stats.bytesRead);
+
+    if (memcmp(panel.ram(), display.getBuffer(), 1024) != 0)
+    {
+        fprintf(stderr, "panel content differs from the display buffer\n");
+        return 1;
+    }
+    return leaked ? 1 : 0;
+}
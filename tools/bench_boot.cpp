@@ -0,0 +1,95 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_boot.cpp
+//
+// Description:
+//
+// what the animation tables cost before setup(): the Frame tables of
+// the first releases (file name, frame count and a String caption per
+// animation, constructed at static initialisation) against the
+// constant registry of animRegistry.h. The old tables are rebuilt from
+// ANIM_REGISTRY with their 8.3 names and captions, and constructed and
+// destroyed again and again to time them; String follows the heap
+// behaviour of the ESP32 core (host/Arduino.h). Prints the heap in use
+// on reaching main(), which only the registry is linked for, then per
+// table the heap blocks and bytes taken and the ns to construct it.
+//
+// Usage:   bench_boot [--rounds N]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+
+#include <chrono>
+
+#include "animRegistry.h"
+#include "hostHeap.h"
+
+// src/animations.h of the first releases
+struct Frame
+{
+    const char *fileName;
+    uint8_t frameCounts;
+    const String name;
+};
+
+#define BOOT_FRAME(category, id, name, width, height, frameCounts, legacyPath) {legacyPath, frameCounts, name},
+
+static volatile size_t benchSink; // keeps the tables from being optimized out
+
+int main(int argc, char **argv)
+{
+    // before anything of main() allocates: what the static initialisation left on the heap
+    HostHeapStats atMain = hostHeap();
+
+    uint32_t rounds = 10000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--rounds"))
+        {
+            rounds = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_boot [--rounds N]\n");
+            return 1;
+        }
+    }
+    rounds = rounds ? rounds : 1;
+    hostSerialOutput(nullptr);
+
+    size_t tableBytes = 0;
+    uint32_t tableBlocks = 0;
+    uint8_t longCaptions = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        size_t used = hostHeap().used;
+        uint32_t allocs = hostHeap().allocs;
+        Frame tables[] = {ANIM_REGISTRY(BOOT_FRAME)};
+        benchSink = tables[r % animTotal].name.length();
+        if (r == 0)
+        {
+            tableBytes = hostHeap().used - used;
+            tableBlocks = hostHeap().allocs - allocs;
+            for (const Frame &frame : tables)
+            {
+                longCaptions += frame.name.length() >= String::ssoBytes;
+            }
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    printf("heap in use on reaching main(): %zu bytes in %u blocks\n", atMain.used, atMain.allocs - atMain.frees);
+    printf("%-28s %8s %8s %8s %10s\n", "39 animations", "static", "blocks", "heap", "init ns");
+    printf("%-28s %8zu %8u %8zu %10.0f\n", "Frame tables, String", sizeof(Frame) * animTotal, tableBlocks,
+           tableBytes, ns);
+    printf("%-28s %8zu %8u %8u %10u\n", "animRegistry, .rodata", sizeof(animRegistry), 0u, 0u, 0u);
+    printf("%u captions longer than %zu characters\n", longCaptions, String::ssoBytes - 1);
+    return 0;
+}
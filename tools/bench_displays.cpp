@@ -0,0 +1,175 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_displays.cpp
+//
+// Description:
+//
+// aggregate frames/s of the display manager (displayManager.h) for 1
+// to 4 panels, on one I2C bus or spread over both: every panel plays
+// its own category, each step draws a frame on all of them and flushes
+// the buses side by side. The time is the host clock, the modelled
+// bus time plus what the host spent drawing, so the figures follow the
+// buses like on the ESP32 where the flush dominates a frame.
+//
+// On one bus the panels share it and frames/s stays where a single
+// panel is; with a second bus it should scale close to linearly. Fails
+// when a panel does not end up showing its buffer.
+//
+// Usage:   bench_displays [--steps N] [--i2c-clock HZ]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "displayManager.h"
+#include "hostCard.h"
+#include "ssd1306Panel.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static Adafruit_SSD1306 display2(128, 64, &Wire, -1);
+static Adafruit_SSD1306 display3(128, 64, &Wire1, -1);
+static Adafruit_SSD1306 display4(128, 64, &Wire1, -1);
+
+struct BenchPanel
+{
+    Adafruit_SSD1306 *oled;
+    TwoWire *wire;
+    uint8_t address;
+    AnimCategory category;
+    SSD1306Panel panel;
+};
+
+static BenchPanel benchPanels[] = {
+    {&display, &Wire, 0x3C, AnimCategory::Meteo},
+    {&display2, &Wire, 0x3D, AnimCategory::System},
+    {&display3, &Wire1, 0x3C, AnimCategory::Battery},
+    {&display4, &Wire1, 0x3D, AnimCategory::Icons},
+};
+
+// which of benchPanels each layout drives
+struct BenchLayout
+{
+    const char *name;
+    uint8_t panels[displayPanelMax];
+    uint8_t count;
+};
+
+static const BenchLayout benchLayouts[] = {
+    {"1 panel", {0}, 1},
+    {"2 panels, 1 bus", {0, 1}, 2},
+    {"2 panels, 2 buses", {0, 2}, 2},
+    {"4 panels, 2 buses", {0, 1, 2, 3}, 4},
+};
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t steps = 300;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--steps"))
+        {
+            steps = atoi(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--i2c-clock"))
+        {
+            Wire.fixedClock = Wire1.fixedClock = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_displays [--steps N] [--i2c-clock HZ]\n");
+            return 1;
+        }
+    }
+    steps = steps ? steps : 1;
+
+    if (!hostCardImage(ANIM_FILES_DIR, "bench_displays.card"))
+    {
+        return 1;
+    }
+    hostSerialOutput(nullptr);
+    for (BenchPanel &b : benchPanels)
+    {
+        b.panel.attach(*b.wire, b.address);
+    }
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    if (!SD.begin(5))
+    {
+        fprintf(stderr, "card mount failed\n");
+        return 1;
+    }
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+
+    printf("%-18s %6s %10s %10s %11s %11s %8s\n", "layout", "frames", "session ms", "frames/s", "I2C ms", "I2C1 ms",
+           "scaling");
+    double single = 0;
+    bool shown = true;
+    for (const BenchLayout &layout : benchLayouts)
+    {
+        DisplayManager displays;
+        for (uint8_t i = 0; i < layout.count; i++)
+        {
+            BenchPanel &b = benchPanels[layout.panels[i]];
+            displayAdd(displays, *b.oled, *b.wire, b.address, b.category);
+        }
+        if (!displayBegin(displays))
+        {
+            fprintf(stderr, "%s: a panel did not answer\n", layout.name);
+            return 1;
+        }
+
+        WireStats bus0 = Wire.stats;
+        WireStats bus1 = Wire1.stats;
+        uint32_t frames = 0;
+        double start = hostClockMicros();
+        for (uint32_t s = 0; s < steps; s++)
+        {
+            frames += displayStep(displays);
+        }
+        double session = hostClockMicros() - start;
+        double rate = frames * 1e6 / session;
+        single = single ? single : rate;
+        printf("%-18s %6u %10.0f %10.1f %11.0f %11.0f %7.2fx\n", layout.name, frames, session / 1000, rate,
+               (Wire.stats.busMicros - bus0.busMicros) / 1000, (Wire1.stats.busMicros - bus1.busMicros) / 1000,
+               rate / single);
+
+        for (uint8_t i = 0; i < layout.count; i++)
+        {
+            BenchPanel &b = benchPanels[layout.panels[i]];
+            if (memcmp(b.panel.ram(), b.oled->getBuffer(), 1024) != 0)
+            {
+                fprintf(stderr, "%s: panel 0x%02X on bus %u differs from its buffer\n", layout.name, b.address,
+                        b.wire == &Wire1);
+                shown = false;
+            }
+        }
+        displayEnd(displays);
+    }
+    return shown ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_gray.cpp
+//
+// Description:
+//
+// cost of the 4 bit grayscale panel of grayPanel.h next to the SSD1306:
+// nanoseconds to expand a 48x48 1 bit frame into the 4 bit buffer
+// through the 256 entry table and pixel by pixel, then the bus time of
+// a full 128x128 frame (8 KB), of the 48x48 window of an animation and
+// of a full SSD1306 frame (1 KB) at 400 kHz and 1 MHz, against the bus
+// mock. Fails when the two expansions do not give the same buffer.
+//
+// Usage:   bench_gray [--rounds N]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "grayPanel.h"
+#include "oledFlush.h"
+#include "ssd1306Panel.h"
+#include "ssd1327Panel.h"
+
+static Adafruit_SSD1306 display(128, 64, &Wire, -1);
+static GrayPanel gray;
+
+static SSD1306Panel monoPanel;
+static SSD1327Panel grayPanel;
+
+static const uint8_t monoAddress = 0x3C;
+static const uint8_t grayAddress = 0x3D;
+
+// the reference: one graySetPixel per pixel
+static void expandPerPixel(const uint8_t *bitmap, int16_t x, int16_t y)
+{
+    for (uint16_t row = 0; row < 48; row++)
+    {
+        for (uint16_t col = 0; col < 48; col++)
+        {
+            bool lit = bitmap[row * 6 + col / 8] & (0x80 >> (col & 7));
+            graySetPixel(gray, x + col, y + row, lit ? gray.on : gray.off);
+        }
+    }
+}
+
+// bus milliseconds of one flush of region
+static double grayFlushMs(const FrameRect &region)
+{
+    double before = Wire.stats.busMicros;
+    grayFlushRegion(gray, region);
+    return (Wire.stats.busMicros - before) / 1000;
+}
+
+static double monoFlushMs(const FrameRect &region)
+{
+    double before = Wire.stats.busMicros;
+    oledFlushRegion(display, Wire, monoAddress, region);
+    return (Wire.stats.busMicros - before) / 1000;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 2000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--rounds"))
+        {
+            rounds = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_gray [--rounds N]\n");
+            return 1;
+        }
+    }
+    rounds = rounds ? rounds : 1;
+
+    hostSerialOutput(nullptr);
+    monoPanel.attach(Wire, monoAddress);
+    grayPanel.attach(Wire, grayAddress);
+    display.begin(SSD1306_SWITCHCAPVCC, monoAddress);
+    if (!grayBegin(gray, 128, 128, Wire, grayAddress))
+    {
+        fprintf(stderr, "no grayscale panel\n");
+        return 1;
+    }
+
+    // random frames, drawn at 40, 40 like the player centers a 48x48 animation
+    std::mt19937 rng(48);
+    std::vector<uint8_t> frames(16 * 288);
+    for (uint8_t &b : frames)
+    {
+        b = rng();
+    }
+    std::vector<uint8_t> table;
+    bool same = true;
+    double ns[2];
+    for (uint8_t path = 0; path < 2; path++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            const uint8_t *bitmap = &frames[(r % 16) * 288];
+            if (path == 0)
+            {
+                grayDrawMono(gray, 40, 40, bitmap, 48, 48, 6);
+            }
+            else
+            {
+                expandPerPixel(bitmap, 40, 40);
+            }
+        }
+        ns[path] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+        std::vector<uint8_t> buffer(gray.buffer, gray.buffer + grayRowBytes(gray) * gray.height);
+        if (path == 0)
+        {
+            table = buffer;
+        }
+        same = same && (path == 0 || buffer == table);
+    }
+    printf("%-24s %10s\n", "48x48 1 bit to 4 bit", "ns/frame");
+    printf("%-24s %10.0f\n", "table", ns[0]);
+    printf("%-24s %10.0f\n", "per pixel", ns[1]);
+    printf("%-24s %9.1fx\n\n", "speedup", ns[1] / ns[0]);
+
+    printf("%-24s %10s %10s\n", "flush, bus ms", "400 kHz", "1 MHz");
+    const struct
+    {
+        const char *name;
+        bool gray;
+        FrameRect region;
+    } flushes[] = {
+        {"SSD1327 128x128 (8 KB)", true, {0, 0, 128, 128}},
+        {"SSD1327 48x48 window", true, {40, 40, 88, 88}},
+        {"SSD1306 128x64 (1 KB)", false, {0, 0, 128, 64}},
+        {"SSD1306 48x48 window", false, {40, 8, 88, 56}},
+    };
+    for (const auto &f : flushes)
+    {
+        double ms[2];
+        uint32_t clocks[] = {400000, 1000000};
+        for (uint8_t c = 0; c < 2; c++)
+        {
+            Wire.fixedClock = clocks[c];
+            ms[c] = f.gray ? grayFlushMs(f.region) : monoFlushMs(f.region);
+        }
+        printf("%-24s %10.2f %10.2f\n", f.name, ms[0], ms[1]);
+    }
+    Wire.fixedClock = 0;
+
+    same = same && !memcmp(grayPanel.ram(), gray.buffer, grayRowBytes(gray) * gray.height);
+    grayEnd(gray);
+    if (!same)
+    {
+        fprintf(stderr, "the table and per pixel expansions differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_i2c.cpp
+//
+// Description:
+//
+// host mode of the I2C transport benchmark (src/i2cBench.h): runs the
+// same SCL clock and chunk size sweep against the bus mock and the
+// simulated panel, so the numbers follow the protocol model of
+// i2cTiming.h. The driver cost per transaction and the highest clock
+// the panel follows can be set to play what-if with a real board.
+//
+// Usage:   bench_i2c [--flushes N] [--overhead US] [--max-clock HZ]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include "i2cBench.h"
+#include "ssd1306Panel.h"
+
+int main(int argc, char **argv)
+{
+    uint32_t flushes = 20;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--flushes"))
+        {
+            flushes = atoi(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--overhead"))
+        {
+            Wire.overheadMicros = atof(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--max-clock"))
+        {
+            Wire.maxClock = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_i2c [--flushes N] [--overhead US] [--max-clock HZ]\n");
+            return 1;
+        }
+    }
+
+    SSD1306Panel panel;
+    panel.attach(Wire, 0x3C);
+    Adafruit_SSD1306 oled(128, 64, &Wire, -1);
+    oled.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    for (int16_t x = 0; x < 128; x++)
+    {
+        oled.drawPixel(x, x / 2, 1);
+        oled.drawPixel(x, 63 - x / 2, 1);
+    }
+
+    I2cBenchResult results[i2cBenchClockCount * i2cBenchChunkCount];
+    uint32_t maxStable = i2cBenchSweep(oled, Wire, 0x3C, flushes, results);
+
+    uint32_t payload = 128 * 8;
+    printf("model at %u Hz, %u byte chunks: %.0f us per flush\n", oledWireClock, oledWireChunk,
+           i2cFlushMicros(payload, oledWireChunk, oledWireClock, Wire.overheadMicros));
+    if (memcmp(panel.ram(), oled.getBuffer(), 1024) != 0)
+    {
+        fprintf(stderr, "panel content differs from the display buffer\n");
+        return 1;
+    }
+    return maxStable ? 0 : 1;
+}
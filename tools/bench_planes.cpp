@@ -0,0 +1,165 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_planes.cpp
+//
+// Description:
+//
+// bit-plane cycling of planePlayer.h on the SSD1306 model: a 48x48
+// shaded strip (every level of 2 or 3 planes side by side) played at
+// 400 kHz and 1 MHz on the esp_timer of the host. Prints the slot
+// period the player settled on and the cycle rate it gives, the slot
+// interval (mean, spread, worst distance from the period), the ticks
+// missed and the longest flush, then the perceived levels of
+// host/panelIntensity.h: the largest error against the level encoded
+// and the flicker (ripple after a 20 ms low pass) of the middle level.
+// The host clock runs on while the host draws, so a busy host shows as
+// jitter and level error: the figures are reported, not checked, see
+// test_plane_player.cpp for the checks on the simulated clock.
+//
+// Usage:   bench_planes [--frames N]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+#include <FS.h>
+#include <SD.h>
+
+#include <vector>
+
+#include "animations.h"
+#include "assetIndex.h"
+#include "animLoader.h"
+#include "animPlayer.h"
+#include "planePlayer.h"
+#include "hostCard.h"
+#include "panelIntensity.h"
+#include "ssd1306Panel.h"
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
+Adafruit_SSD1306 display(128, 64, &Wire, -1);
+AssetIndex assetIndex;
+FramePack framePack;
+
+static SSD1306Panel panel;
+
+static const AnimDesc strips[] = {
+    {AnimCategory::Icons, "strip2", "/strip2.bin", "strip2", 48, 48, 0},
+    {AnimCategory::Icons, "strip3", "/strip3.bin", "strip3", 48, 48, 0},
+};
+
+static uint64_t cardFingerprint()
+{
+    return SD.usedBytes();
+}
+
+static uint8_t stripLevel(uint8_t planes, uint16_t x)
+{
+    return x * (1 << planes) / 48;
+}
+
+static bool writeStrip(const AnimDesc &anim, uint8_t planes)
+{
+    AssetHeader header = {assetVersion, planes == 2 ? ASSET_PLANES2 : ASSET_PLANES3, 48, 48, 6, planes};
+    std::vector<uint8_t> file(assetHeaderSize + 288 * planes, 0);
+    assetWriteHeader(header, file.data());
+    for (uint8_t p = 0; p < planes; p++)
+    {
+        for (uint16_t y = 0; y < 48; y++)
+        {
+            for (uint16_t x = 0; x < 48; x++)
+            {
+                if (stripLevel(planes, x) >> p & 1)
+                {
+                    file[assetHeaderSize + p * 288 + y * 6 + x / 8] |= 0x80 >> (x & 7);
+                }
+            }
+        }
+    }
+    File out = SD.open(anim.path, FILE_WRITE);
+    bool written = out && out.write(file.data(), file.size()) == file.size();
+    out.close();
+    return written;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = 20;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--frames"))
+        {
+            frames = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_planes [--frames N]\n");
+            return 1;
+        }
+    }
+    frames = frames ? frames : 1;
+
+    if (!hostCardImage(ANIM_FILES_DIR, "bench_planes.card"))
+    {
+        return 1;
+    }
+    hostSerialOutput(nullptr);
+    panel.attach(Wire, SCREEN_I2C_ADDR);
+    u8g2.begin();
+    u8g2.setFont(u8g2_font_profont10_tf);
+    oled_LineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+    animAtlasBegin();
+    display.begin(SSD1306_SWITCHCAPVCC, SCREEN_I2C_ADDR);
+    if (!SD.begin(5) || !writeStrip(strips[0], 2) || !writeStrip(strips[1], 3))
+    {
+        fprintf(stderr, "card mount failed\n");
+        return 1;
+    }
+    assetIndexBegin(SD, cardFingerprint, assetIndex);
+
+    printf("%-16s %7s %6s %6s %9s %7s %6s %6s %9s %9s %7s\n", "planes, clock", "slot us", "Hz", "missed",
+           "interval", "spread", "worst", "flush", "slots", "level err", "ripple");
+    const uint32_t clocks[] = {400000, 1000000};
+    for (uint8_t planes = 2; planes <= planeMax; planes++)
+    {
+        for (uint32_t clock : clocks)
+        {
+            Wire.fixedClock = clock;
+            PanelIntensity intensity;
+            intensity.attach(panel);
+            PlaneStats stats;
+            uint32_t shown = planePlay(strips[planes - 2], frames, &stats);
+            intensity.detach(panel);
+            if (shown != frames)
+            {
+                fprintf(stderr, "%u planes: %u of %u frames played\n", planes, shown, frames);
+                return 1;
+            }
+
+            // row 20 of the strip, the window starts at y 16
+            uint8_t top = (1 << planes) - 1;
+            double error = 0;
+            for (uint16_t x = 0; x < 48; x++)
+            {
+                double off = fabs(intensity.mean(x, 36) - (double)stripLevel(planes, x) / top);
+                error = off > error ? off : error;
+            }
+            char name[24];
+            snprintf(name, sizeof(name), "%u, %u kHz", planes, clock / 1000);
+            printf("%-16s %7u %6u %6u %9.1f %7.1f %6u %6u %9u %9.3f %7.3f\n", name, stats.period,
+                   1000000 / (stats.period * planeSlots(planes)), stats.missed, planeJitterMean(stats),
+                   planeJitterSpread(stats), planeJitterWorst(stats), stats.flushMax, stats.slots, error,
+                   intensity.ripple(24, 36));
+        }
+    }
+    Wire.fixedClock = 0;
+    return 0;
+}
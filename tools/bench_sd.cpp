@@ -0,0 +1,78 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_sd.cpp
+//
+// Description:
+//
+// host mode of the storage benchmark (src/sdBench.h): the same open,
+// sequential, random, per animation load and boot tests, run against a
+// scratch copy of the files folder through the card model of the FS
+// mock. Prints the same sdbench lines as the board.
+//
+// Usage:   bench_sd [--mode spi|sdmmc1|sdmmc4] [--clock HZ] [--command US] [--cache SECTORS]
+//          bus of sdStorage.h, card bus clock (4 MHz like SD.begin),
+//          access time of a read command and the sectors kept cached,
+//          see host/FS.h
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD.h>
+#include <SD_MMC.h>
+
+#include "animations.h"
+#include "animLoader.h"
+#include "hostCard.h"
+#include "sdBench.h"
+
+FramePack framePack;
+
+int main(int argc, char **argv)
+{
+    StorageConfig config = {STORAGE_SPI, 4000000};
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--mode") && !strcmp(argv[i + 1], "spi"))
+        {
+            config.mode = STORAGE_SPI;
+        }
+        else if (!strcmp(argv[i], "--mode") && !strcmp(argv[i + 1], "sdmmc1"))
+        {
+            config.mode = STORAGE_SDMMC_1BIT;
+        }
+        else if (!strcmp(argv[i], "--mode") && !strcmp(argv[i + 1], "sdmmc4"))
+        {
+            config.mode = STORAGE_SDMMC_4BIT;
+        }
+        else if (!strcmp(argv[i], "--clock"))
+        {
+            config.clock = atoi(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--command"))
+        {
+            SD.timing.commandMicros = SD_MMC.timing.commandMicros = atof(argv[i + 1]);
+        }
+        else if (!strcmp(argv[i], "--cache"))
+        {
+            SD.timing.cacheSectors = SD_MMC.timing.cacheSectors = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_sd [--mode spi|sdmmc1|sdmmc4] [--clock HZ] [--command US] [--cache SECTORS]\n");
+            return 1;
+        }
+    }
+
+    // remounted in the same mode before every cold test
+    if (!hostCardImage(ANIM_FILES_DIR, "bench_sd.card") || !storageBegin(config))
+    {
+        return 1;
+    }
+    return sdBenchRun() ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_text.cpp
+//
+// Description:
+//
+// nanoseconds per glyph of the two text paths of the player: u8g2
+// drawStr() and the glyph atlas of glyphAtlas.h, for the captions of
+// animRegistry.h and for short status texts like the ones redrawn on
+// every frame. The host u8g2 draws a built-in 5x7 font pixel by pixel
+// instead of decoding the compressed font, so its figure is a lower
+// bound of what the ESP32 spends; the atlas path is the same code.
+// Fails when the two paths do not set the same pixels.
+//
+// Usage:   bench_text [--rounds N]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#include <chrono>
+
+#include "animRegistry.h"
+#include "glyphAtlas.h"
+
+static U8G2 u8g2(128, 64);
+
+static const char *statusTexts[] = {"87%", "100%", "-12.5C", "21.0C", "3.71V", "12:45"};
+static const uint8_t statusCount = sizeof(statusTexts) / sizeof(statusTexts[0]);
+
+static bool buildAtlas(GlyphAtlas &atlas)
+{
+    glyphAtlasBegin(atlas, u8g2.getFontAscent(), -u8g2.getFontDescent());
+    char glyph[2] = {0, 0};
+    for (uint8_t c = glyphFirst; c <= glyphLast; c++)
+    {
+        glyph[0] = c;
+        glyphAtlasReserve(atlas, c, u8g2.getStrWidth(glyph));
+    }
+    if (!glyphAtlasAllocate(atlas))
+    {
+        return false;
+    }
+    for (uint8_t c = glyphFirst; c <= glyphLast; c++)
+    {
+        glyph[0] = c;
+        u8g2.clearBuffer();
+        u8g2.drawStr(0, atlas.ascent, glyph);
+        glyphAtlasCapture(atlas, c, u8g2.getBufferPtr(), 128, 0);
+    }
+    return true;
+}
+
+// times rounds passes over the texts, both paths, returns false when they differ
+static bool bench(const char *name, const char *const *texts, uint8_t count, uint32_t rounds, const GlyphAtlas &atlas,
+                  int16_t x, int16_t y)
+{
+    uint32_t glyphs = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        glyphs += strlen(texts[i]);
+    }
+    glyphs *= rounds;
+
+    uint8_t buffer[1024];
+    uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            sink += u8g2.drawStr(x, y, texts[i]);
+        }
+    }
+    double u8g2Nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            sink += glyphAtlasDraw(atlas, texts[i], buffer, 128, 64, x, y);
+        }
+    }
+    double atlasNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-9s %8u  %14.1f  %15.1f  %5.1fx\n", name, glyphs, u8g2Nanos / glyphs, atlasNanos / glyphs,
+           atlasNanos > 0 ? u8g2Nanos / atlasNanos : 0.0);
+
+    // same pixels, text by text
+    bool same = sink > 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        u8g2.clearBuffer();
+        u8g2.drawStr(x, y, texts[i]);
+        memset(buffer, 0, sizeof(buffer));
+        glyphAtlasDraw(atlas, texts[i], buffer, 128, 64, x, y);
+        same = same && memcmp(buffer, u8g2.getBufferPtr(), sizeof(buffer)) == 0;
+    }
+    if (!same)
+    {
+        fprintf(stderr, "%s: the atlas and u8g2 draw different pixels\n", name);
+    }
+    return same;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 2000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--rounds"))
+        {
+            rounds = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_text [--rounds N]\n");
+            return 1;
+        }
+    }
+    rounds = rounds ? rounds : 1;
+
+    u8g2.setFont(u8g2_font_profont10_tf);
+    GlyphAtlas atlas;
+    if (!buildAtlas(atlas))
+    {
+        fprintf(stderr, "no memory for the atlas\n");
+        return 1;
+    }
+
+    const char *captions[animTotal];
+    for (uint8_t i = 0; i < animTotal; i++)
+    {
+        captions[i] = animRegistry[i].name;
+    }
+    int16_t lineH = u8g2.getFontAscent() + u8g2.getFontAscent();
+
+    printf("text        glyphs  u8g2 ns/glyph  atlas ns/glyph  speedup\n");
+    bool same = bench("captions", captions, animTotal, rounds, atlas, 3, lineH + 2);
+    same = bench("status", statusTexts, statusCount, rounds * 10, atlas, 52, 42) && same;
+    glyphAtlasFree(atlas);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: bench_transpose.cpp
+//
+// Description:
+//
+// nanoseconds to put a 48x48 row major frame into the SSD1306 buffer:
+// drawBitmap() pixel by pixel against the 8x8 bit transpose of
+// bitTranspose.h, at y 15 (the animation area, blocks straddling two
+// pages) and y 16 (page aligned), and the plain conversion of the frame
+// to the page layout. Random frames with a quarter of the pixels lit
+// and the frames of the bell animation. Fails when the two paths do
+// not give the same buffer.
+//
+// Usage:   bench_transpose [--rounds N]
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include <Wire.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "bitTranspose.h"
+#include "ssd1306Panel.h"
+
+static Adafruit_SSD1306 display(128, 64, &Wire, -1);
+static SSD1306Panel panel;
+
+static const uint16_t frameCount = 16;
+static volatile uint8_t benchSink; // keeps the page conversion from being optimized out
+
+enum BenchPath
+{
+    PATH_DRAWBITMAP,
+    PATH_TRANSPOSE,
+    PATH_PAGES,
+};
+
+// ns per frame of one path, the buffer it left in buffer
+static double benchPath(BenchPath path, const std::vector<uint8_t> &frames, int16_t y, uint32_t rounds,
+                        std::vector<uint8_t> &buffer)
+{
+    uint8_t pages[6 * 48];
+    display.clearDisplay();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        const uint8_t *frame = &frames[(r % frameCount) * 288];
+        if (path == PATH_DRAWBITMAP)
+        {
+            display.drawBitmap(40, y, frame, 48, 48, 1);
+        }
+        else if (path == PATH_TRANSPOSE)
+        {
+            bitBlitRows(frame, 48, 48, 6, display.getBuffer(), 128, 64, 40, y);
+        }
+        else
+        {
+            bitRowsToPages(frame, 48, 48, 6, pages);
+            benchSink = pages[r % sizeof(pages)];
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    buffer.assign(display.getBuffer(), display.getBuffer() + 1024);
+    return ns;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 20000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--rounds"))
+        {
+            rounds = atoi(argv[i + 1]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: bench_transpose [--rounds N]\n");
+            return 1;
+        }
+    }
+    rounds = rounds ? rounds : 1;
+
+    hostSerialOutput(nullptr);
+    panel.attach(Wire, 0x3C);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+
+    std::mt19937 rng(50);
+    std::vector<uint8_t> sparse(frameCount * 288);
+    for (uint8_t &b : sparse)
+    {
+        b = rng() & rng();
+    }
+    std::vector<uint8_t> bell;
+    FILE *f = fopen(ANIM_FILES_DIR "/bell.bin", "rb");
+    if (f)
+    {
+        bell.resize(frameCount * 288);
+        bell.resize(fread(bell.data(), 1, bell.size(), f) / 288 * 288);
+        fclose(f);
+    }
+    // fewer frames than frameCount in the file: repeat them
+    for (size_t i = bell.size(); bell.size() && i < frameCount * 288; i++)
+    {
+        bell.push_back(bell[i % bell.size()]);
+    }
+
+    const struct
+    {
+        const char *name;
+        const std::vector<uint8_t> *frames;
+    } sets[] = {{"random", &sparse}, {"bell", &bell}};
+    printf("%-26s %10s %10s %10s\n", "48x48 frame, ns", "random", "bell", "speedup");
+    bool same = true;
+    const struct
+    {
+        const char *name;
+        BenchPath path;
+        int16_t y;
+    } rows[] = {
+        {"drawBitmap at y 15", PATH_DRAWBITMAP, 15}, {"transpose at y 15", PATH_TRANSPOSE, 15},
+        {"drawBitmap at y 16", PATH_DRAWBITMAP, 16}, {"transpose at y 16", PATH_TRANSPOSE, 16},
+        {"to page layout", PATH_PAGES, 0},
+    };
+    double reference = 0;
+    std::vector<uint8_t> expected[2];
+    for (const auto &row : rows)
+    {
+        double ns[2] = {0, 0};
+        for (uint8_t s = 0; s < 2; s++)
+        {
+            if (sets[s].frames->empty())
+            {
+                continue;
+            }
+            std::vector<uint8_t> buffer;
+            ns[s] = benchPath(row.path, *sets[s].frames, row.y, rounds, buffer);
+            if (row.path == PATH_DRAWBITMAP)
+            {
+                expected[s] = buffer;
+            }
+            else if (row.path == PATH_TRANSPOSE && buffer != expected[s])
+            {
+                fprintf(stderr, "%s, %s frames: the buffer differs from drawBitmap\n", row.name, sets[s].name);
+                same = false;
+            }
+        }
+        reference = row.path == PATH_DRAWBITMAP ? ns[0] : reference;
+        printf("%-26s %10.0f %10.0f %9.1fx\n", row.name, ns[0], ns[1], reference / ns[0]);
+    }
+    return same ? 0 : 1;
+}
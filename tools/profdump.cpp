@@ -0,0 +1,122 @@
+// +-------------------------------------------------------------
+//
+// Equipment:
+// host PC
+//
+// File: profdump.cpp
+//
+// Description:
+//
+// decoder of the stage timing records the firmware sends over Serial
+// when built with ANIM_PROFILE (see src/animProfile.h). Reads a raw
+// capture of the serial port, skips the text around the records and
+// prints count, mean, p50/p95/p99 and max per stage in microseconds.
+//
+// Capture for instance with
+//   pio device monitor --raw > capture.bin      (then type p)
+//
+// Build:   g++ -std=c++17 -O2 -I../src profdump.cpp -o profdump
+//
+// Usage:   profdump [--all] <capture>
+//          --all prints every record, the last one only otherwise
+//
+// History:     19-Oct-2026     Created
+//
+// +-------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "profileRecord.h"
+
+static bool readFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return true;
+}
+
+static void printRecord(const ProfileHistogram *stages, uint16_t cpuMHz)
+{
+    double us = cpuMHz ? 1.0 / cpuMHz : 1.0;
+    printf("%-8s %8s %10s %10s %10s %10s %10s\n", "stage", "count", "mean us", "p50 us", "p95 us", "p99 us", "max us");
+    for (uint8_t s = 0; s < profileStageCount; s++)
+    {
+        const ProfileHistogram &h = stages[s];
+        double mean = h.count ? (double)h.sum / h.count : 0;
+        printf("%-8s %8u %10.1f %10.1f %10.1f %10.1f %10.1f\n", profileStageNames[s], h.count, mean * us,
+               profileQuantile(h, 0.50f) * us, profileQuantile(h, 0.95f) * us, profileQuantile(h, 0.99f) * us,
+               h.max * us);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool all = argc > 2 && !strcmp(argv[1], "--all");
+    if (argc != (all ? 3 : 2))
+    {
+        fprintf(stderr, "usage: profdump [--all] <capture>\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    if (!readFile(argv[argc - 1], data))
+    {
+        return 1;
+    }
+
+    ProfileHistogram stages[profileStageCount];
+    ProfileHistogram last[profileStageCount];
+    uint16_t cpuMHz = 0, lastMHz = 0;
+    unsigned records = 0, damaged = 0;
+    for (size_t i = 0; i + 4 <= data.size(); i++)
+    {
+        if (memcmp(&data[i], profileMagic, 4) != 0)
+        {
+            continue;
+        }
+        size_t size = profileDecode(&data[i], data.size() - i, stages, cpuMHz);
+        if (!size)
+        {
+            damaged++;
+            continue;
+        }
+        records++;
+        if (all)
+        {
+            printf("record %u\n", records);
+            printRecord(stages, cpuMHz);
+        }
+        memcpy(last, stages, sizeof(last));
+        lastMHz = cpuMHz;
+        i += size - 1;
+    }
+
+    if (damaged)
+    {
+        fprintf(stderr, "%u damaged records skipped\n", damaged);
+    }
+    if (!records)
+    {
+        fprintf(stderr, "no profile record in %s\n", argv[argc - 1]);
+        return 1;
+    }
+    if (!all)
+    {
+        printRecord(last, lastMHz);
+    }
+    return 0;
+}